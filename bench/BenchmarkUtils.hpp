@@ -0,0 +1,19 @@
+#ifndef BENCHMARK_UTILS_HPP
+#define BENCHMARK_UTILS_HPP
+
+#include <chrono>
+
+// Seconds taken by one call of function
+template <typename Function>
+double measure(Function&& function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+inline double megabytes(double bytes) {
+    return bytes / (1024.0 * 1024.0);
+}
+
+#endif
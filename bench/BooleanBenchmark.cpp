@@ -0,0 +1,34 @@
+#include "../src/core/objects/ObjectsFactory.hpp"
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+
+// Usage: boolean_benchmark [segments]
+// Combines two overlapping spheres with every boolean operation and reports the timings.
+int main(int argc, char* argv[]) {
+    int segments = argc > 1 ? std::stoi(argv[1]) : 256;
+
+    auto first = std::make_shared<CustomShape>(ObjectsFactory::createSphere(1.0f, segments));
+    auto second = std::make_shared<CustomShape>(ObjectsFactory::createSphere(1.0f, segments));
+    second->translate(Vector3(0.6f, 0.3f, 0.1f));
+
+    std::cout << "faces per sphere: " << first->faces.size() << std::endl;
+
+    const std::pair<const char*, BooleanOperation> operations[] = {
+        {"union", BooleanOperation::Union},
+        {"difference", BooleanOperation::Difference},
+        {"intersection", BooleanOperation::Intersection},
+    };
+
+    for (const auto& [name, operation] : operations) {
+        auto start = std::chrono::steady_clock::now();
+        auto result = ObjectsFactory::combineObjects({first, second}, operation);
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+        std::cout << name << ": " << result->faces.size() << " faces, "
+                  << result->vertices.size() << " vertices, "
+                  << elapsed.count() << " ms" << std::endl;
+    }
+    return 0;
+}
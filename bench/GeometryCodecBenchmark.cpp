@@ -0,0 +1,136 @@
+#include "../src/core/objects/Sphere.hpp"
+#include "../src/utils/files/BinaryPrjFile.hpp"
+#include "../src/utils/files/GeometryCodec.hpp"
+#include "BenchmarkUtils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Positions may move by up to half a quantization step per axis; topology and colours are exact
+static bool matches(const ProjectObject& loaded, const Object3d& original, int positionBits) {
+    const auto& vertices = original.getVertices();
+    const auto& faces = original.getFaces();
+    if (loaded.vertices.size() != vertices.size() || loaded.faces.size() != faces.size()) {
+        return false;
+    }
+
+    Vector3 min = vertices[0];
+    Vector3 max = vertices[0];
+    for (const auto& vertex : vertices) {
+        min = Vector3(std::min(min.x, vertex.x), std::min(min.y, vertex.y), std::min(min.z, vertex.z));
+        max = Vector3(std::max(max.x, vertex.x), std::max(max.y, vertex.y), std::max(max.z, vertex.z));
+    }
+    float levels = static_cast<float>((1u << positionBits) - 1);
+    Vector3 tolerance = (max - min) * (0.5f / levels) + Vector3(1e-5f, 1e-5f, 1e-5f);
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        Vector3 error = loaded.vertices[i] - vertices[i];
+        if (std::abs(error.x) > tolerance.x || std::abs(error.y) > tolerance.y || std::abs(error.z) > tolerance.z) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < faces.size(); ++i) {
+        for (int k = 0; k < 7; ++k) {
+            int expected = k < 3 ? faces[i][k] : (faces[i][k] & 0xFF);
+            if (loaded.faces[i][k] != expected) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Usage: geometry_codec_benchmark [sphere count] [position bits]
+// Saves the same scene raw and compressed, then compares file size and load time.
+int main(int argc, char* argv[]) {
+    int sphereCount = argc > 1 ? std::stoi(argv[1]) : 8;
+    int positionBits = argc > 2 ? std::stoi(argv[2]) : 16;
+
+    ProjectData project;
+    std::vector<std::shared_ptr<Object3d>> objects;
+    for (int i = 0; i < sphereCount; ++i) {
+        auto sphere = std::make_shared<Sphere>(1.0f, 256, 512);
+        sphere->translate(Vector3(static_cast<float>(i) * 3.0f, 0.0f, 0.0f));
+        objects.push_back(sphere);
+
+        ProjectObject& object = project.objects.emplace_back();
+        object.position = sphere->getPosition();
+        object.scale = sphere->getScale();
+        object.vertices = sphere->getVertices();
+        object.faces = sphere->getFaces();
+    }
+
+    std::string rawPath = (fs::temp_directory_path() / "geometry_codec_benchmark_raw.prj").string();
+    std::string compressedPath = (fs::temp_directory_path() / "geometry_codec_benchmark_compressed.prj").string();
+    GeometryEncoding encoding{true, positionBits};
+
+    std::vector<BinaryPrjSection> sections;
+    double rawWrite = measure([&]() { BinaryPrjFile::write(rawPath, project); });
+    double compressedWrite = measure([&]() { sections = BinaryPrjFile::write(compressedPath, project, {}, encoding); });
+
+    // Single-threaded codec throughput on one object's geometry
+    const auto& vertices = objects[0]->getVertices();
+    const auto& faces = objects[0]->getFaces();
+    double geometryBytes = static_cast<double>(vertices.size() * 12 + faces.size() * 16);
+    std::vector<char> stream;
+    double encodeTime = measure([&]() {
+        stream = GeometryCodec::encode(vertices, faces, sections[0].boundsMin, sections[0].boundsMax, positionBits);
+    });
+    std::vector<Vector3> decodedVertices;
+    std::vector<std::array<int, 7>> decodedFaces;
+    double decodeTime = measure([&]() {
+        GeometryCodec::decode(stream.data(), stream.size(), static_cast<uint32_t>(vertices.size()),
+                              static_cast<uint32_t>(faces.size()), sections[0].boundsMin, sections[0].boundsMax,
+                              decodedVertices, decodedFaces);
+    });
+
+    ProjectData rawProject;
+    ProjectData compressedProject;
+    double rawRead = measure([&]() { rawProject = BinaryPrjFile::read(rawPath); });
+    double compressedRead = measure([&]() { compressedProject = BinaryPrjFile::read(compressedPath); });
+
+    double rawSize = static_cast<double>(fs::file_size(rawPath));
+    double compressedSize = static_cast<double>(fs::file_size(compressedPath));
+    bool ok = compressedProject.objects.size() == objects.size();
+    for (size_t i = 0; ok && i < objects.size(); ++i) {
+        ok = matches(compressedProject.objects[i], *objects[i], positionBits);
+    }
+
+    // An incremental save keeps compressed sections and appends a recompressed one
+    project.objects[0].position = Vector3(0.0f, 1.0f, 0.0f);
+    BinaryPrjFile::SectionReuse reuse(sections.begin(), sections.end());
+    reuse[1] = std::nullopt;
+    BinaryPrjFile::update(compressedPath, project, reuse, {}, encoding);
+    ProjectData updated = BinaryPrjFile::read(compressedPath);
+    ok = ok && updated.objects[0].position.y == 1.0f;
+    for (size_t i = 0; ok && i < objects.size(); ++i) {
+        ok = matches(updated.objects[i], *objects[i], positionBits);
+    }
+
+    std::cout << objects.size() << " objects, " << positionBits << "-bit positions" << std::endl;
+    std::cout << "raw:        " << megabytes(rawSize) << " MB, write " << rawWrite << " s, read " << rawRead << " s"
+              << std::endl;
+    std::cout << "compressed: " << megabytes(compressedSize) << " MB, write " << compressedWrite << " s, read "
+              << compressedRead << " s, ratio " << rawSize / compressedSize << "x" << std::endl;
+    std::cout << "codec: encode " << megabytes(geometryBytes) / encodeTime << " MB/s, decode "
+              << megabytes(geometryBytes) / decodeTime << " MB/s of geometry on one thread" << std::endl;
+    // Loading from storage at S MB/s costs size / S plus the read above, so compression wins while
+    // (rawSize - compressedSize) / S exceeds the extra time the compressed read takes
+    double extraRead = compressedRead - rawRead;
+    if (extraRead > 0.0) {
+        std::cout << "compressed loads faster from storage slower than "
+                  << megabytes(rawSize - compressedSize) / extraRead << " MB/s";
+    } else {
+        std::cout << "compressed loads faster from storage of any speed";
+    }
+    std::cout << ", round trip " << (ok ? "ok" : "MISMATCH") << std::endl;
+
+    fs::remove(rawPath);
+    fs::remove(compressedPath);
+    return ok ? 0 : 1;
+}
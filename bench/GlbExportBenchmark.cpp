@@ -0,0 +1,78 @@
+#include "../src/core/objects/Sphere.hpp"
+#include "../src/utils/files/GlbExporter.hpp"
+#include "../src/utils/files/MappedFile.hpp"
+#include "../src/utils/files/ObjExporter.hpp"
+#include "BenchmarkUtils.hpp"
+#include <nlohmann/json.hpp>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Checks the container and that the buffer, views and accessors agree with the scene
+static bool validate(const std::string& path, size_t objectCount, size_t uniqueMeshes) {
+    MappedFile file(path);
+    if (file.size() < 20) return false;
+    uint32_t header[5];
+    std::memcpy(header, file.data(), sizeof(header));
+    if (header[0] != 0x46546C67 || header[1] != 2 || header[2] != file.size() || header[4] != 0x4E4F534A) {
+        return false;
+    }
+    nlohmann::json json = nlohmann::json::parse(file.data() + 20, file.data() + 20 + header[3]);
+    uint32_t binLength;
+    std::memcpy(&binLength, file.data() + 20 + header[3], sizeof(binLength));
+    if (json["buffers"][0]["byteLength"] != binLength || json["nodes"].size() != objectCount ||
+        json["meshes"].size() != uniqueMeshes) {
+        return false;
+    }
+    for (const auto& view : json["bufferViews"]) {
+        if (view["byteOffset"].get<uint64_t>() + view["byteLength"].get<uint64_t>() > binLength) return false;
+    }
+    return true;
+}
+
+// Usage: glb_export_benchmark [sphere count]
+// Exports the same scene of spheres as OBJ and as GLB and compares size and time.
+int main(int argc, char* argv[]) {
+    int sphereCount = argc > 1 ? std::stoi(argv[1]) : 8;
+
+    std::vector<std::shared_ptr<Object3d>> objects;
+    auto original = std::make_shared<Sphere>(1.0f, 256, 512);
+    for (int face = 0; face < static_cast<int>(original->getFaces().size()) / 2; ++face) {
+        original->setFaceColor(face, "#c85028");
+    }
+    for (int i = 0; i < sphereCount; ++i) {
+        // Even spheres are copies of the first, as the editor's copy command makes; odd ones are
+        // single-coloured and identical to each other
+        std::shared_ptr<Object3d> sphere = original;
+        if (i > 0) {
+            sphere = i % 2 == 0 ? original->clone() : std::make_shared<Sphere>(1.0f, 256, 512);
+        }
+        sphere->translate(Vector3(static_cast<float>(i) * 3.0f, 0.0f, 0.0f));
+        objects.push_back(sphere);
+    }
+    size_t uniqueMeshes = sphereCount > 1 ? 2 : 1;
+
+    std::string objPath = (fs::temp_directory_path() / "glb_export_benchmark.obj").string();
+    std::string glbPath = (fs::temp_directory_path() / "glb_export_benchmark.glb").string();
+    double objTime = measure([&]() { ObjExporter::write(objPath, objects); });
+    double glbTime = measure([&]() { GlbExporter::write(glbPath, objects); });
+
+    double objSize = static_cast<double>(fs::file_size(objPath) + fs::file_size(fs::path(objPath).replace_extension(".mtl")));
+    double glbSize = static_cast<double>(fs::file_size(glbPath));
+    bool ok = validate(glbPath, objects.size(), uniqueMeshes);
+
+    std::cout << objects.size() << " objects, " << uniqueMeshes << " distinct meshes" << std::endl;
+    std::cout << "obj: " << megabytes(objSize) << " MB in " << objTime << " s" << std::endl;
+    std::cout << "glb: " << megabytes(glbSize) << " MB in " << glbTime << " s (" << objSize / glbSize
+              << "x smaller, " << objTime / glbTime << "x faster), " << (ok ? "valid" : "INVALID") << std::endl;
+
+    fs::remove(objPath);
+    fs::remove(fs::path(objPath).replace_extension(".mtl"));
+    fs::remove(glbPath);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,66 @@
+#include "../src/core/feature/Scene.hpp"
+#include "../src/core/objects/Sphere.hpp"
+#include "../src/core/ui/Button.hpp"
+#include "../src/utils/WindowManager.hpp"
+#include "../src/views/editor-menu/FacesMenu.hpp"
+#include "../src/views/editor-menu/VerticesMenu.hpp"
+#include "BenchmarkUtils.hpp"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Opens the menu and delivers one event, which is what builds its rows
+static double measureMenu(Menu& menu) {
+    sf::RenderWindow& window = WindowManager::getInstance().getWindow();
+    sf::Event event;
+    event.type = sf::Event::MouseMoved;
+    event.mouseMove.x = -1;
+    event.mouseMove.y = -1;
+    double elapsed = measure([&]() {
+        menu.onActivate();
+        menu.handleEvent(event, window);
+    });
+    menu.onDeactivate();
+    return elapsed;
+}
+
+// Usage: icon_benchmark [sphere segments]
+// Run from the build folder in a desktop session; the menus draw into the editor window.
+// Times opening FacesMenu and VerticesMenu on a large selected sphere. For the numbers from
+// before the shared icon atlas, copy this file and BenchmarkUtils.hpp into the bench folder of
+// the tree before it and add the icon_benchmark target there; both build unchanged.
+int main(int argc, char* argv[]) {
+    int segments = argc > 1 ? std::stoi(argv[1]) : 32;
+
+    sf::RenderWindow& window = WindowManager::getInstance().getWindow();
+    Scene& scene = Scene::getInstance(window);
+    auto sphere = std::make_shared<Sphere>(1.0f, segments, segments * 2);
+    scene.addObject(sphere);
+    scene.toggleObjectSelected(static_cast<unsigned int>(scene.getObjects().size() - 1));
+
+    FacesMenu facesMenu;
+    VerticesMenu verticesMenu;
+    double faces = measureMenu(facesMenu);
+    double vertices = measureMenu(verticesMenu);
+    // Icons are cached after the first menu, so open each once more
+    double facesAgain = measureMenu(facesMenu);
+    double verticesAgain = measureMenu(verticesMenu);
+
+    std::cout << sphere->getFaces().size() << " faces, " << sphere->getVertices().size() << " vertices" << std::endl;
+    std::cout << "faces menu:    " << faces * 1000.0 << " ms, reopened " << facesAgain * 1000.0 << " ms" << std::endl;
+    std::cout << "vertices menu: " << vertices * 1000.0 << " ms, reopened " << verticesAgain * 1000.0 << " ms" << std::endl;
+
+    // The icons alone: one delete button per face, as the menus used to build
+    size_t count = sphere->getFaces().size();
+    std::vector<std::shared_ptr<Button>> buttons;
+    double shared = measure([&]() {
+        for (size_t i = 0; i < count; ++i) {
+            auto button = std::make_shared<Button>(sf::Vector2f(280, 60 + 30 * i), sf::Vector2f(30, 30), "");
+            button->setIcon("delete");
+            buttons.push_back(button);
+        }
+    });
+    std::cout << count << " icon buttons: " << shared * 1000.0 << " ms" << std::endl;
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include "../src/core/feature/EditJournal.hpp"
+#include "../src/core/objects/Sphere.hpp"
+#include "../src/utils/files/BinaryPrjFile.hpp"
+#include "../src/utils/files/JournalFile.hpp"
+#include "BenchmarkUtils.hpp"
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static ProjectData snapshot(const std::vector<std::shared_ptr<Object3d>>& objects, uint64_t saveId) {
+    ProjectData project;
+    project.saveId = saveId;
+    for (size_t i = 1; i < objects.size(); ++i) {
+        ProjectObject& object = project.objects.emplace_back();
+        object.position = objects[i]->getPosition();
+        object.rotation = objects[i]->getRotation();
+        object.scale = objects[i]->getScale();
+        object.vertices = objects[i]->getVertices();
+        object.faces = objects[i]->getFaces();
+    }
+    return project;
+}
+
+// Loads the project the way a restart after a crash would and compares it with the live scene
+static bool recoversScene(const std::string& path, const std::vector<std::shared_ptr<Object3d>>& objects) {
+    ProjectData project = BinaryPrjFile::read(path);
+    std::vector<uint32_t> ids;
+    JournalFile::replay(EditJournal::getJournalPath(path), project, ids);
+    if (project.objects.size() != objects.size() - 1) {
+        return false;
+    }
+    for (size_t i = 0; i < project.objects.size(); ++i) {
+        const Object3d& expected = *objects[i + 1];
+        const ProjectObject& loaded = project.objects[i];
+        if (loaded.vertices != expected.getVertices() || loaded.faces.size() != expected.getFaces().size() ||
+            !(loaded.position == expected.getPosition()) || !(loaded.scale == expected.getScale())) {
+            return false;
+        }
+        for (size_t face = 0; face < loaded.faces.size(); ++face) {
+            for (int channel = 3; channel < 7; ++channel) {
+                if ((loaded.faces[face][channel] & 0xFF) != (expected.getFaces()[face][channel] & 0xFF)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// Usage: journal_benchmark [edit count]
+// Journals single-vertex and transform edits on a scene of spheres, then replays the journal
+// as a restart after a crash would, before and after a save in between.
+int main(int argc, char* argv[]) {
+    int edits = argc > 1 ? std::stoi(argv[1]) : 2000;
+
+    // Index 0 stands in for the grid plane, which is never journaled
+    std::vector<std::shared_ptr<Object3d>> objects;
+    for (int i = 0; i < 201; ++i) {
+        auto sphere = std::make_shared<Sphere>(1.0f, 32, 64);
+        sphere->translate(Vector3(static_cast<float>(i % 20) * 3.0f, 0.0f, static_cast<float>(i / 20) * 3.0f));
+        objects.push_back(sphere);
+    }
+
+    std::string path = (fs::temp_directory_path() / "journal_benchmark.prj").string();
+    BinaryPrjFile::write(path, snapshot(objects, 0));
+    EditJournal& journal = EditJournal::getInstance();
+    std::vector<uint32_t> ids;
+    for (uint32_t id = 0; id + 1 < objects.size(); ++id) {
+        ids.push_back(id);
+    }
+    journal.open(path, 0, ids, false);
+    for (uint32_t id : ids) {
+        journal.track(objects[id + 1], id);
+    }
+
+    double vertexEdits = measure([&]() {
+        for (int edit = 0; edit < edits; ++edit) {
+            auto& object = objects[1 + edit % (objects.size() - 1)];
+            int vertex = (edit * 7) % static_cast<int>(object->getVertices().size());
+            object->updateVertex(vertex, object->getVertices()[vertex] + Vector3(0.0f, 0.01f, 0.0f));
+            journal.record(objects);
+        }
+    });
+    double transformEdits = measure([&]() {
+        for (int edit = 0; edit < edits; ++edit) {
+            objects[1 + edit % (objects.size() - 1)]->translate(Vector3(0.0f, 0.0f, 0.01f));
+            journal.record(objects);
+        }
+    });
+
+    objects.erase(objects.begin() + 5);
+    objects.push_back(std::make_shared<Sphere>(2.0f, 16, 32));
+    journal.record(objects);
+    size_t journalSize = fs::file_size(EditJournal::getJournalPath(path));
+    bool recovered = recoversScene(path, objects);
+
+    uint64_t saveId = 42;
+    journal.beginSave(saveId, objects);
+    BinaryPrjFile::write(path, snapshot(objects, saveId));
+    journal.finishSave(saveId);
+    objects[3]->updateVertex(0, Vector3(1.0f, 2.0f, 3.0f));
+    objects.erase(objects.begin() + 7);
+    journal.record(objects);
+    size_t savedJournalSize = fs::file_size(EditJournal::getJournalPath(path));
+    bool recoveredAfterSave = recoversScene(path, objects);
+
+    std::cout << objects.size() - 1 << " objects, vertex edit " << vertexEdits / edits * 1e6
+              << " us, transform edit " << transformEdits / edits * 1e6 << " us per frame" << std::endl;
+    std::cout << "journal " << journalSize / 1024 << " KB after " << 2 * edits << " edits, "
+              << savedJournalSize << " bytes after saving" << std::endl;
+    std::cout << "replay " << (recovered ? "ok" : "MISMATCH") << ", replay after save "
+              << (recoveredAfterSave ? "ok" : "MISMATCH") << std::endl;
+
+    journal.discard();
+    fs::remove(path);
+    return recovered && recoveredAfterSave ? 0 : 1;
+}
@@ -0,0 +1,78 @@
+#include "../src/utils/files/ObjReader.hpp"
+#include "../src/utils/ThreadPool.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Writes a height-field scan of roughly the requested size, mixing plain and v//vn face syntax.
+static void generateScan(const std::string& path, size_t targetMegabytes) {
+    std::ofstream file(path, std::ios::binary);
+    std::vector<char> buffer(1 << 20);
+    file.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+
+    // Each grid cell costs about 30 bytes of vertex line and 48 bytes of face lines
+    size_t side = static_cast<size_t>(std::sqrt(targetMegabytes * 1024.0 * 1024.0 / 78.0));
+
+    char line[128];
+    file << "# generated scan " << side << "x" << side << "\n";
+    for (size_t z = 0; z <= side; ++z) {
+        for (size_t x = 0; x <= side; ++x) {
+            float height = 0.05f * static_cast<float>((x * 7 + z * 13) % 17);
+            int length = std::snprintf(line, sizeof(line), "v %.6f %.6f %.6f\n",
+                                       x / static_cast<float>(side), height, z / static_cast<float>(side));
+            file.write(line, length);
+        }
+    }
+    file << "vn 0 1 0\n";
+    for (size_t z = 0; z < side; ++z) {
+        for (size_t x = 0; x < side; ++x) {
+            size_t v0 = z * (side + 1) + x + 1;
+            size_t v1 = v0 + 1;
+            size_t v2 = v0 + side + 1;
+            size_t v3 = v2 + 1;
+            int length = (x % 2 == 0)
+                ? std::snprintf(line, sizeof(line), "f %zu//1 %zu//1 %zu//1 %zu//1\n", v0, v2, v3, v1)
+                : std::snprintf(line, sizeof(line), "f %zu %zu %zu\nf %zu %zu %zu\n", v0, v2, v1, v1, v2, v3);
+            file.write(line, length);
+        }
+    }
+}
+
+// Usage: obj_import_benchmark [file.obj | --generate megabytes]
+int main(int argc, char* argv[]) {
+    std::string path;
+    bool generated = false;
+
+    if (argc > 1 && std::string(argv[1]) != "--generate") {
+        path = argv[1];
+    } else {
+        size_t megabytes = argc > 2 ? std::stoul(argv[2]) : 1024;
+        path = (fs::temp_directory_path() / "obj_import_benchmark.obj").string();
+        std::cout << "generating " << megabytes << " MB scan..." << std::endl;
+        generateScan(path, megabytes);
+        generated = true;
+    }
+
+    double megabytes = static_cast<double>(fs::file_size(path)) / (1024.0 * 1024.0);
+
+    auto start = std::chrono::steady_clock::now();
+    ObjMesh mesh = ObjReader::read(path);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << megabytes << " MB, " << mesh.vertices.size() << " vertices, "
+              << mesh.faces.size() << " triangles in " << elapsed.count() << " s ("
+              << megabytes / elapsed.count() << " MB/s, "
+              << ThreadPool::getInstance().getThreadCount() + 1 << " threads)" << std::endl;
+
+    if (generated) {
+        fs::remove(path);
+    }
+    return 0;
+}
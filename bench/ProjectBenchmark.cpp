@@ -0,0 +1,212 @@
+#include "../src/core/objects/Sphere.hpp"
+#include "../src/utils/files/BinaryPrjFile.hpp"
+#include "../src/utils/files/PrjFile.hpp"
+#include "BenchmarkUtils.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static size_t countFaces(const ProjectData& project) {
+    size_t faces = 0;
+    for (const auto& object : project.objects) {
+        faces += object.faces.size();
+    }
+    return faces;
+}
+
+// Colour channels are stored as bytes, the same narrowing sf::Color applies when drawing
+static bool sameFaces(const std::vector<std::array<int, 7>>& loaded, const std::vector<std::array<int, 7>>& original) {
+    if (loaded.size() != original.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < loaded.size(); ++i) {
+        for (int k = 0; k < 7; ++k) {
+            int expected = k < 3 ? original[i][k] : (original[i][k] & 0xFF);
+            if (loaded[i][k] != expected) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Saves many small objects, then times saves that touch one object's geometry or transform.
+// Repeated edits eventually trigger a compacting rewrite.
+static bool benchmarkIncrementalSave() {
+    std::vector<std::shared_ptr<Object3d>> objects;
+    for (int i = 0; i < 500; ++i) {
+        auto sphere = std::make_shared<Sphere>(1.0f, 16, 32);
+        sphere->translate(Vector3(static_cast<float>(i % 25) * 3.0f, 0.0f, static_cast<float>(i / 25) * 3.0f));
+        objects.push_back(sphere);
+    }
+
+    ProjectCamera camera;
+    std::string path = (fs::temp_directory_path() / "project_benchmark_incremental.prj").string();
+    std::vector<BinaryPrjSection> sections;
+    double fullWrite = measure([&]() { sections = BinaryPrjFile::write(path, camera, objects); });
+
+    double slowest = 0.0;
+    double total = 0.0;
+    const int edits = 200;
+    for (int edit = 0; edit < edits; ++edit) {
+        size_t dirty = static_cast<size_t>(edit * 37) % objects.size();
+        objects[dirty]->updateVertex(0, objects[dirty]->getVertices()[0] + Vector3(0.0f, 0.01f, 0.0f));
+        objects[(dirty + 1) % objects.size()]->translate(Vector3(0.0f, 0.0f, 0.1f));
+
+        ProjectData project;
+        project.camera = camera;
+        BinaryPrjFile::SectionReuse reuse;
+        for (size_t i = 0; i < objects.size(); ++i) {
+            ProjectObject& object = project.objects.emplace_back();
+            object.position = objects[i]->getPosition();
+            object.rotation = objects[i]->getRotation();
+            object.scale = objects[i]->getScale();
+            if (i == dirty) {
+                object.vertices = objects[i]->getVertices();
+                object.faces = objects[i]->getFaces();
+                reuse.push_back(std::nullopt);
+            } else {
+                reuse.push_back(sections[i]);
+            }
+        }
+
+        double elapsed = measure([&]() { sections = BinaryPrjFile::update(path, project, reuse); });
+        slowest = std::max(slowest, elapsed);
+        total += elapsed;
+    }
+
+    ProjectData loaded = BinaryPrjFile::read(path);
+    bool matches = loaded.objects.size() == objects.size();
+    for (size_t i = 0; matches && i < objects.size(); ++i) {
+        matches = loaded.objects[i].vertices.size() == objects[i]->getVertices().size() &&
+                  loaded.objects[i].vertices[0].y == objects[i]->getVertices()[0].y &&
+                  loaded.objects[i].position.z == objects[i]->getPosition().z;
+    }
+
+    std::cout << "incremental: " << objects.size() << " objects, full write " << fullWrite
+              << " s, one-object save avg " << total / edits * 1000.0 << " ms, slowest "
+              << slowest * 1000.0 << " ms, file " << fs::file_size(path) / 1024 << " KB, round trip "
+              << (matches ? "ok" : "MISMATCH") << std::endl;
+    fs::remove(path);
+    return matches;
+}
+
+// Rotates on mixed axes the way the keyboard and properties panel do, then checks that the
+// orientation rebuilt from the saved Euler angles is the one that was drawn
+static bool checkRotationRoundTrip() {
+    auto sphere = std::make_shared<Sphere>(1.0f, 8, 16);
+    for (int i = 0; i < 20; ++i) {
+        sphere->rotate(0.05f, 'x');
+    }
+    for (int i = 0; i < 15; ++i) {
+        sphere->rotate(-0.05f, 'y');
+    }
+    sphere->rotate(0.7f, 'z');
+    sphere->rotate(1.2f, 'x');
+    std::vector<std::shared_ptr<Object3d>> objects = {sphere};
+
+    ProjectCamera camera;
+    std::string jsonPath = (fs::temp_directory_path() / "project_benchmark_rotation_json.prj").string();
+    std::string binaryPath = (fs::temp_directory_path() / "project_benchmark_rotation_binary.prj").string();
+    PrjFile prjFile;
+    prjFile.setCamera(camera.position, camera.yaw, camera.pitch, camera.orbitCenter);
+    prjFile.addObject(*sphere);
+    prjFile.write(jsonPath);
+    BinaryPrjFile::write(binaryPath, camera, objects);
+
+    auto sameOrientation = [&sphere](const Vector3& savedRotation) {
+        Object3d loaded;
+        loaded.setRotation(savedRotation);
+        Quaternion a = sphere->getOrientation();
+        Quaternion b = loaded.getOrientation();
+        // q and -q are the same rotation
+        return std::abs(a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w) > 1.0f - 1e-5f;
+    };
+    bool matches = sameOrientation(PrjFile::load(jsonPath).objects[0].rotation) &&
+                   sameOrientation(BinaryPrjFile::read(binaryPath).objects[0].rotation);
+
+    std::cout << "mixed-axis rotation round trip " << (matches ? "ok" : "MISMATCH") << std::endl;
+    fs::remove(jsonPath);
+    fs::remove(binaryPath);
+    return matches;
+}
+
+// Usage: project_benchmark [sphere count]
+// Saves the same scene as a JSON and a binary project, then times loading each back.
+int main(int argc, char* argv[]) {
+    int sphereCount = argc > 1 ? std::stoi(argv[1]) : 8;
+
+    std::vector<std::shared_ptr<Object3d>> objects;
+    for (int i = 0; i < sphereCount; ++i) {
+        auto sphere = std::make_shared<Sphere>(1.0f, 256, 512);
+        sphere->translate(Vector3(static_cast<float>(i) * 3.0f, 0.0f, 0.0f));
+        objects.push_back(sphere);
+    }
+
+    ProjectCamera camera;
+    std::string jsonPath = (fs::temp_directory_path() / "project_benchmark_json.prj").string();
+    std::string binaryPath = (fs::temp_directory_path() / "project_benchmark_binary.prj").string();
+
+    double jsonWrite = measure([&]() {
+        PrjFile prjFile;
+        prjFile.setCamera(camera.position, camera.yaw, camera.pitch, camera.orbitCenter);
+        for (const auto& object : objects) {
+            prjFile.addObject(*object);
+        }
+        prjFile.write(jsonPath);
+    });
+    double binaryWrite = measure([&]() { BinaryPrjFile::write(binaryPath, camera, objects); });
+
+    ProjectData binaryProject;
+    double jsonRead = measure([&]() {
+        PrjFile prjFile;
+        prjFile.read(jsonPath);
+        ProjectData jsonProject = prjFile.toProjectData();
+    });
+    ProjectData streamedProject;
+    double streamedRead = measure([&]() { streamedProject = PrjFile::load(jsonPath); });
+    double binaryRead = measure([&]() { binaryProject = BinaryPrjFile::read(binaryPath); });
+    std::vector<BinaryPrjSection> sections;
+    double headersRead = measure([&]() { BinaryPrjFile::readHeaders(binaryPath, sections); });
+
+    bool matches = binaryProject.objects.size() == objects.size();
+    for (size_t i = 0; matches && i < objects.size(); ++i) {
+        matches = sameFaces(binaryProject.objects[i].faces, objects[i]->getFaces()) &&
+                  binaryProject.objects[i].vertices.size() == objects[i]->getVertices().size() &&
+                  streamedProject.objects[i].faces == objects[i]->getFaces() &&
+                  streamedProject.objects[i].vertices.size() == objects[i]->getVertices().size();
+    }
+    // Geometry paged in later from the sections must match the full read
+    for (size_t i = 0; matches && i < sections.size(); ++i) {
+        std::vector<Vector3> vertices;
+        std::vector<std::array<int, 7>> faces;
+        BinaryPrjFile::readGeometry(binaryPath, sections[i], vertices, faces);
+        matches = faces == binaryProject.objects[i].faces &&
+                  vertices.size() == binaryProject.objects[i].vertices.size() &&
+                  std::equal(vertices.begin(), vertices.end(), binaryProject.objects[i].vertices.begin(),
+                             [](const Vector3& a, const Vector3& b) { return a.x == b.x && a.y == b.y && a.z == b.z; });
+    }
+
+    std::cout << countFaces(binaryProject) << " triangles in " << objects.size() << " objects" << std::endl;
+    std::cout << "json:   " << fs::file_size(jsonPath) / (1024 * 1024) << " MB, write " << jsonWrite
+              << " s, DOM read " << jsonRead << " s, streamed read " << streamedRead << " s ("
+              << countFaces(streamedProject) << " triangles)" << std::endl;
+    std::cout << "binary: " << fs::file_size(binaryPath) / (1024 * 1024) << " MB, write " << binaryWrite
+              << " s, read " << binaryRead << " s, headers only " << headersRead * 1000.0 << " ms" << std::endl;
+    std::cout << "speedup " << jsonRead / binaryRead << "x, round trip "
+              << (matches ? "ok" : "MISMATCH") << std::endl;
+
+    fs::remove(jsonPath);
+    fs::remove(binaryPath);
+
+    bool incrementalMatches = benchmarkIncrementalSave();
+    bool rotationMatches = checkRotationRoundTrip();
+    return matches && incrementalMatches && rotationMatches ? 0 : 1;
+}
@@ -0,0 +1,54 @@
+#include "../src/core/objects/Sphere.hpp"
+#include "../src/utils/files/StlFile.hpp"
+#include "BenchmarkUtils.hpp"
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Usage: stl_benchmark [file.stl | --generate million facets]
+// Without a file, exports a coloured sphere as binary STL and imports it again.
+int main(int argc, char* argv[]) {
+    std::string path;
+    bool generated = false;
+    size_t expectedFaces = 0;
+    size_t expectedVertices = 0;
+
+    if (argc > 1 && std::string(argv[1]) != "--generate") {
+        path = argv[1];
+    } else {
+        double millions = argc > 2 ? std::stod(argv[2]) : 4.0;
+        int segments = static_cast<int>(std::sqrt(millions * 1e6 / 4.0));
+        auto sphere = std::make_shared<Sphere>(1.0f, segments, segments * 2);
+        sphere->setFacesColor("#c85028");
+        expectedFaces = sphere->getFaces().size();
+        expectedVertices = sphere->getVertices().size();
+
+        path = (fs::temp_directory_path() / "stl_benchmark.stl").string();
+        double exportTime = measure([&]() { StlFile({sphere}).write(path); });
+        std::cout << "exported " << expectedFaces << " facets in " << exportTime << " s" << std::endl;
+        generated = true;
+    }
+
+    double size = megabytes(static_cast<double>(fs::file_size(path)));
+    StlFile stlFile;
+    double importTime = measure([&]() { stlFile.read(path); });
+    std::cout << size << " MB, " << stlFile.getVertices().size() << " vertices, " << stlFile.getFaces().size()
+              << " facets imported in " << importTime << " s (" << size / importTime << " MB/s)" << std::endl;
+
+    int result = 0;
+    if (generated) {
+        // Poles repeat a vertex per segment in the sphere but weld to one in STL
+        bool ok = stlFile.getFaces().size() == expectedFaces && stlFile.getVertices().size() <= expectedVertices &&
+                  !stlFile.getFaces().empty() && (stlFile.getFaces()[0][3] >> 3) == (200 >> 3) &&
+                  (stlFile.getFaces()[0][5] >> 3) == (40 >> 3);
+        std::cout << "round trip " << (ok ? "ok" : "MISMATCH") << std::endl;
+        result = ok ? 0 : 1;
+        fs::remove(path);
+    }
+    return result;
+}
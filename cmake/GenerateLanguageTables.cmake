@@ -0,0 +1,111 @@
+# Compiles the language packs into string tables indexed by the TextKey enum, so the app never
+# parses them at runtime. Each key becomes an enumerator in PascalCase ("new_project" and
+# "New project" both become NewProject). Every pack must define exactly the keys of the first.
+#
+# cmake -DINPUT=<LanguagePacks.json> -DOUTPUT_DIR=<dir> -P GenerateLanguageTables.cmake
+
+cmake_minimum_required(VERSION 3.21)
+
+file(READ "${INPUT}" packs)
+
+function(to_identifier key result)
+    string(REGEX MATCHALL "[A-Za-z0-9]+" words "${key}")
+    set(identifier "")
+    foreach(word IN LISTS words)
+        string(SUBSTRING "${word}" 0 1 first)
+        string(SUBSTRING "${word}" 1 -1 rest)
+        string(TOUPPER "${first}" first)
+        string(APPEND identifier "${first}${rest}")
+    endforeach()
+    if(NOT identifier MATCHES "^[A-Za-z]")
+        message(FATAL_ERROR "${INPUT}: key \"${key}\" does not start with a letter")
+    endif()
+    set(${result} "${identifier}" PARENT_SCOPE)
+endfunction()
+
+function(to_literal text result)
+    string(REPLACE "\\" "\\\\" text "${text}")
+    string(REPLACE "\"" "\\\"" text "${text}")
+    string(REPLACE "\n" "\\n" text "${text}")
+    set(${result} "\"${text}\"" PARENT_SCOPE)
+endfunction()
+
+string(JSON packCount LENGTH "${packs}")
+if(packCount EQUAL 0)
+    message(FATAL_ERROR "${INPUT}: no language packs")
+endif()
+math(EXPR lastPack "${packCount} - 1")
+
+# The first pack's keys define the enum
+string(JSON words GET "${packs}" 0 words)
+string(JSON keyCount LENGTH "${words}")
+math(EXPR lastKey "${keyCount} - 1")
+set(keys "")
+set(identifiers "")
+foreach(k RANGE ${lastKey})
+    string(JSON key MEMBER "${words}" ${k})
+    to_identifier("${key}" identifier)
+    if(identifier IN_LIST identifiers)
+        message(FATAL_ERROR "${INPUT}: key \"${key}\" gives the same name as another key, ${identifier}")
+    endif()
+    list(APPEND keys "${key}")
+    list(APPEND identifiers "${identifier}")
+endforeach()
+
+set(header "// Generated from LanguagePacks.json by GenerateLanguageTables.cmake; do not edit\n")
+string(APPEND header "#ifndef LANGUAGE_TABLES_HPP\n#define LANGUAGE_TABLES_HPP\n\n")
+string(APPEND header "#include <array>\n#include <cstddef>\n#include <cstdint>\n#include <string>\n\n")
+string(APPEND header "enum class TextKey : uint16_t {\n")
+foreach(identifier IN LISTS identifiers)
+    string(APPEND header "    ${identifier},\n")
+endforeach()
+string(APPEND header "};\n\n")
+string(APPEND header "constexpr size_t TEXT_KEY_COUNT = ${keyCount};\n")
+string(APPEND header "constexpr size_t LANGUAGE_COUNT = ${packCount};\n\n")
+string(APPEND header "struct LanguagePack {\n")
+string(APPEND header "    const char* language;\n")
+string(APPEND header "    const char* showName;\n")
+string(APPEND header "    std::array<std::string, TEXT_KEY_COUNT> texts;\n\n")
+string(APPEND header "    const std::string& operator[](TextKey key) const {\n")
+string(APPEND header "        return texts[static_cast<size_t>(key)];\n")
+string(APPEND header "    }\n")
+string(APPEND header "};\n\n")
+string(APPEND header "const std::array<LanguagePack, LANGUAGE_COUNT>& getLanguagePacks();\n\n")
+string(APPEND header "#endif\n")
+
+set(source "// Generated from LanguagePacks.json by GenerateLanguageTables.cmake; do not edit\n")
+string(APPEND source "#include \"LanguageTables.hpp\"\n\n")
+string(APPEND source "const std::array<LanguagePack, LANGUAGE_COUNT>& getLanguagePacks() {\n")
+string(APPEND source "    static const std::array<LanguagePack, LANGUAGE_COUNT> packs = {{\n")
+foreach(p RANGE ${lastPack})
+    string(JSON language GET "${packs}" ${p} language)
+    string(JSON showName GET "${packs}" ${p} showName)
+    string(JSON words GET "${packs}" ${p} words)
+    string(JSON packKeyCount LENGTH "${words}")
+    if(NOT packKeyCount EQUAL keyCount)
+        message(FATAL_ERROR "${INPUT}: pack \"${language}\" has ${packKeyCount} keys, not ${keyCount}")
+    endif()
+
+    to_literal("${language}" languageLiteral)
+    to_literal("${showName}" showNameLiteral)
+    string(APPEND source "        {${languageLiteral}, ${showNameLiteral}, {{\n")
+    foreach(key IN LISTS keys)
+        string(JSON text ERROR_VARIABLE missing GET "${words}" "${key}")
+        if(missing)
+            message(FATAL_ERROR "${INPUT}: pack \"${language}\" has no \"${key}\"")
+        endif()
+        to_literal("${text}" literal)
+        string(APPEND source "            ${literal},\n")
+    endforeach()
+    string(APPEND source "        }}},\n")
+endforeach()
+string(APPEND source "    }};\n")
+string(APPEND source "    return packs;\n")
+string(APPEND source "}\n")
+
+# Written only when changed, so editing a pack without changing its keys rebuilds one file
+file(WRITE "${OUTPUT_DIR}/LanguageTables.hpp.tmp" "${header}")
+file(WRITE "${OUTPUT_DIR}/LanguageTables.cpp.tmp" "${source}")
+file(COPY_FILE "${OUTPUT_DIR}/LanguageTables.hpp.tmp" "${OUTPUT_DIR}/LanguageTables.hpp" ONLY_IF_DIFFERENT)
+file(COPY_FILE "${OUTPUT_DIR}/LanguageTables.cpp.tmp" "${OUTPUT_DIR}/LanguageTables.cpp" ONLY_IF_DIFFERENT)
+file(REMOVE "${OUTPUT_DIR}/LanguageTables.hpp.tmp" "${OUTPUT_DIR}/LanguageTables.cpp.tmp")
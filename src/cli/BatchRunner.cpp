@@ -0,0 +1,80 @@
+#include "BatchRunner.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <stdexcept>
+#include "../utils/ThreadPool.hpp"
+
+namespace fs = std::filesystem;
+
+static std::string lowerExtension(const fs::path& path) {
+    std::string extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return extension;
+}
+
+std::vector<std::string> BatchRunner::collectInputs(const std::vector<std::string>& paths,
+                                                    const std::vector<std::string>& extensions) {
+    std::vector<std::string> inputs;
+    for (const auto& path : paths) {
+        if (!fs::is_directory(path)) {
+            inputs.push_back(path);
+            continue;
+        }
+
+        std::vector<std::string> files;
+        for (const auto& entry : fs::directory_iterator(path)) {
+            if (entry.is_regular_file() &&
+                std::find(extensions.begin(), extensions.end(), lowerExtension(entry.path())) != extensions.end()) {
+                files.push_back(entry.path().string());
+            }
+        }
+        std::sort(files.begin(), files.end());
+        inputs.insert(inputs.end(), files.begin(), files.end());
+    }
+    return inputs;
+}
+
+std::vector<BatchResult> BatchRunner::run(const std::vector<std::string>& inputs, const Task& task) {
+    std::vector<BatchResult> results(inputs.size());
+    ThreadPool::getInstance().parallelFor(inputs.size(), [&](size_t index) {
+        BatchResult& result = results[index];
+        result.input = inputs[index];
+        auto start = std::chrono::steady_clock::now();
+        try {
+            result.message = task(index, inputs[index]);
+            result.succeeded = true;
+        } catch (const std::exception& e) {
+            result.message = e.what();
+        }
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    });
+    return results;
+}
+
+bool BatchRunner::report(const std::vector<BatchResult>& results, double totalSeconds, std::ostream& out) {
+    size_t failed = 0;
+    double workSeconds = 0.0;
+    out << std::fixed << std::setprecision(3);
+    for (const auto& result : results) {
+        out << std::setw(9) << result.seconds << " s  " << (result.succeeded ? "ok     " : "FAILED ") << result.input;
+        if (!result.message.empty()) {
+            out << "  " << result.message;
+        }
+        out << "\n";
+        failed += result.succeeded ? 0 : 1;
+        workSeconds += result.seconds;
+    }
+
+    out << results.size() << (results.size() == 1 ? " file" : " files");
+    if (failed > 0) {
+        out << ", " << failed << " failed";
+    }
+    // The pool's workers plus the calling thread
+    out << " in " << totalSeconds << " s (" << workSeconds << " s of work on "
+        << ThreadPool::getInstance().getThreadCount() + 1 << " threads)" << std::endl;
+    return failed == 0;
+}
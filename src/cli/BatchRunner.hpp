@@ -0,0 +1,33 @@
+#ifndef BATCH_RUNNER_HPP
+#define BATCH_RUNNER_HPP
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+struct BatchResult {
+    std::string input;
+    double seconds = 0.0;
+    bool succeeded = false;
+    // What the task reported, or the error that stopped it
+    std::string message;
+};
+
+// Runs a command over many inputs on the thread pool and reports how long each one took
+class BatchRunner {
+public:
+    // Returns a line describing what was done with the input; throws on failure
+    using Task = std::function<std::string(size_t index, const std::string& input)>;
+
+    // Files are kept as given; folders are replaced by the files in them with one of the
+    // extensions, sorted by name
+    static std::vector<std::string> collectInputs(const std::vector<std::string>& paths,
+                                                  const std::vector<std::string>& extensions);
+    // Results come back in input order, whichever order the inputs finished in
+    static std::vector<BatchResult> run(const std::vector<std::string>& inputs, const Task& task);
+    // Prints one line per result and a summary; returns whether every input succeeded
+    static bool report(const std::vector<BatchResult>& results, double totalSeconds, std::ostream& out);
+};
+
+#endif
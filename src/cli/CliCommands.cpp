@@ -0,0 +1,367 @@
+#include "CliCommands.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include "BatchRunner.hpp"
+#include "../core/feature/ProjectsManager.hpp"
+#include "../core/feature/ThumbnailRenderer.hpp"
+#include "../core/objects/ObjectsFactory.hpp"
+#include "../utils/files/BinaryPrjFile.hpp"
+#include "../utils/files/GlbExporter.hpp"
+#include "../utils/files/ObjExporter.hpp"
+#include "../utils/files/PrjFile.hpp"
+#include "../utils/files/StlFile.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+const std::vector<std::string> INPUT_EXTENSIONS = {".obj", ".stl", ".prj", ".json"};
+
+// Meshes without a project camera are scaled into a sphere of this radius, so the framed view
+// stays well inside the preview's far plane
+constexpr float FRAME_RADIUS = 5.0f;
+
+struct LoadedScene {
+    // Only projects have one
+    std::optional<ProjectCamera> camera;
+    std::vector<std::shared_ptr<Object3d>> objects;
+};
+
+std::string lowerExtension(const std::string& path) {
+    std::string extension = fs::path(path).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return extension;
+}
+
+LoadedScene loadScene(const std::string& path) {
+    LoadedScene scene;
+    std::string extension = lowerExtension(path);
+    if (extension == ".prj" || extension == ".json") {
+        std::vector<BinaryPrjSection> sections;
+        ProjectData project = ProjectsManager::readProject(path, sections);
+        scene.camera = project.camera;
+        for (auto& object : project.objects) {
+            scene.objects.push_back(ProjectsManager::createObject(std::move(object)));
+        }
+    } else if (extension == ".obj" || extension == ".stl") {
+        scene.objects.push_back(std::make_shared<CustomShape>(ObjectsFactory::importFile(path)));
+    } else {
+        throw std::runtime_error("unsupported input format '" + extension + "'");
+    }
+    return scene;
+}
+
+std::string getExtension(const std::string& format) {
+    if (format == "obj" || format == "stl" || format == "glb") return "." + format;
+    if (format == "prj" || format == "prj-text") return ".prj";
+    throw std::invalid_argument("Unknown format '" + format + "'; expected obj, stl, glb, prj or prj-text");
+}
+
+// The format a file of this name is written in, keeping JSON projects as text
+std::string getFormat(const std::string& path) {
+    std::string extension = lowerExtension(path);
+    if (extension == ".json" || (extension == ".prj" && fs::exists(path) && !BinaryPrjFile::isBinary(path))) {
+        return "prj-text";
+    }
+    return extension.empty() ? extension : extension.substr(1);
+}
+
+void saveScene(const std::string& path, const std::string& format, const LoadedScene& scene) {
+    if (format == "obj") {
+        ObjExporter::write(path, scene.objects);
+    } else if (format == "stl") {
+        StlFile(scene.objects).write(path);
+    } else if (format == "glb") {
+        GlbExporter::write(path, scene.objects);
+    } else if (format == "prj") {
+        BinaryPrjFile::write(path, scene.camera.value_or(ProjectCamera{}), scene.objects);
+    } else if (format == "prj-text") {
+        ProjectCamera camera = scene.camera.value_or(ProjectCamera{});
+        PrjFile prjFile;
+        prjFile.setCamera(camera.position, camera.yaw, camera.pitch, camera.orbitCenter);
+        for (const auto& object : scene.objects) {
+            prjFile.addObject(*object);
+        }
+        prjFile.write(path);
+    } else {
+        throw std::invalid_argument("Unknown format '" + format + "'");
+    }
+}
+
+struct PlannedOutput {
+    std::string path;
+    // Why the input cannot be written, if it cannot
+    std::string conflict;
+};
+
+// Outputs are worked out before the batch starts, so the output folder is created once and inputs
+// that would overwrite themselves or each other are caught instead of racing
+std::vector<PlannedOutput> planOutputs(const std::vector<std::string>& inputs, const CliOptions& options,
+                                       const std::vector<std::string>& extensions) {
+    bool toFolder = !options.output.empty() && (inputs.size() > 1 || fs::is_directory(options.output));
+    if (toFolder) {
+        fs::create_directories(options.output);
+    }
+
+    std::vector<PlannedOutput> outputs(inputs.size());
+    std::map<std::string, size_t> writers;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        fs::path output;
+        if (options.output.empty()) {
+            output = fs::path(inputs[i]).replace_extension(extensions[i]);
+        } else if (toFolder) {
+            output = fs::path(options.output) / fs::path(inputs[i]).stem();
+            output += extensions[i];
+        } else {
+            output = options.output;
+        }
+        outputs[i].path = output.string();
+
+        std::error_code error;
+        auto writer = writers.emplace(fs::absolute(output, error).lexically_normal().string(), i);
+        if (fs::equivalent(output, inputs[i], error)) {
+            outputs[i].conflict = "output would overwrite the input; choose another with -o";
+        } else if (!writer.second) {
+            outputs[i].conflict = "output " + outputs[i].path + " is already written for " + inputs[writer.first->second];
+        }
+    }
+    return outputs;
+}
+
+const std::string& getPath(const PlannedOutput& output) {
+    if (!output.conflict.empty()) {
+        throw std::runtime_error(output.conflict);
+    }
+    return output.path;
+}
+
+std::vector<std::string> getInputs(const CliOptions& options) {
+    std::vector<std::string> inputs = BatchRunner::collectInputs(options.inputs, INPUT_EXTENSIONS);
+    if (inputs.empty()) {
+        throw std::invalid_argument("No input files");
+    }
+    return inputs;
+}
+
+size_t countFaces(const LoadedScene& scene) {
+    size_t faces = 0;
+    for (const auto& object : scene.objects) {
+        faces += object->getFaces().size();
+    }
+    return faces;
+}
+
+std::string describe(const LoadedScene& scene) {
+    std::ostringstream description;
+    description << scene.objects.size() << (scene.objects.size() == 1 ? " object, " : " objects, ")
+                << countFaces(scene) << " faces";
+    return description.str();
+}
+
+// Returns false when the scene has no vertices
+bool getWorldBounds(const LoadedScene& scene, Vector3& min, Vector3& max) {
+    constexpr float infinity = std::numeric_limits<float>::infinity();
+    min = Vector3(infinity, infinity, infinity);
+    max = Vector3(-infinity, -infinity, -infinity);
+    for (const auto& object : scene.objects) {
+        const Matrix4& transform = object->getTransformation();
+        for (const auto& vertex : object->getVertices()) {
+            Vector3 world = transform * vertex;
+            min = Vector3(std::min(min.x, world.x), std::min(min.y, world.y), std::min(min.z, world.z));
+            max = Vector3(std::max(max.x, world.x), std::max(max.y, world.y), std::max(max.z, world.z));
+        }
+    }
+    return min.x <= max.x;
+}
+
+// Copies every object's geometry into one mesh in world space
+std::shared_ptr<Object3d> bakeObjects(const std::vector<std::shared_ptr<Object3d>>& objects) {
+    std::vector<Vector3> vertices;
+    std::vector<std::array<int, 7>> faces;
+    for (const auto& object : objects) {
+        int offset = static_cast<int>(vertices.size());
+        const Matrix4& transform = object->getTransformation();
+        for (const auto& vertex : object->getVertices()) {
+            vertices.push_back(transform * vertex);
+        }
+        // A mirroring scale turns faces inside out unless the winding is flipped too
+        Vector3 scale = object->getScale();
+        bool mirrored = scale.x * scale.y * scale.z < 0.0f;
+        for (auto face : object->getFaces()) {
+            face[0] += offset;
+            face[1] += offset;
+            face[2] += offset;
+            if (mirrored) {
+                std::swap(face[1], face[2]);
+            }
+            faces.push_back(face);
+        }
+    }
+    return std::make_shared<CustomShape>(std::move(vertices), std::move(faces));
+}
+
+// Scales the objects around the centre of their bounds to fit the preview and returns a camera
+// looking at them
+ProjectCamera frameScene(LoadedScene& scene) {
+    Vector3 min;
+    Vector3 max;
+    if (getWorldBounds(scene, min, max)) {
+        Vector3 centre = (min + max) * 0.5f;
+        float radius = (max - min).length() * 0.5f;
+        float factor = radius > 0.0f ? FRAME_RADIUS / radius : 1.0f;
+        for (const auto& object : scene.objects) {
+            Vector3 scale = object->getScale();
+            object->setPosition((object->getPosition() - centre) * factor);
+            object->setScale(scale * factor - scale);
+        }
+    }
+
+    return ThumbnailRenderer::frame(Vector3(0.0f, 0.0f, 0.0f), FRAME_RADIUS);
+}
+}
+
+int CliCommands::convert(const CliOptions& options) {
+    std::string extension = getExtension(options.format);
+    std::vector<std::string> inputs = getInputs(options);
+    auto outputs = planOutputs(inputs, options, std::vector<std::string>(inputs.size(), extension));
+
+    auto start = std::chrono::steady_clock::now();
+    auto results = BatchRunner::run(inputs, [&](size_t index, const std::string& input) {
+        const std::string& output = getPath(outputs[index]);
+        LoadedScene scene = loadScene(input);
+        saveScene(output, options.format, scene);
+        return "-> " + output + " (" + describe(scene) + ")";
+    });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return BatchRunner::report(results, seconds, std::cout) ? 0 : 1;
+}
+
+int CliCommands::weld(const CliOptions& options) {
+    std::vector<std::string> inputs = getInputs(options);
+    std::vector<std::string> formats;
+    std::vector<std::string> extensions;
+    for (const auto& input : inputs) {
+        formats.push_back(options.format.empty() ? getFormat(input) : options.format);
+        extensions.push_back(getExtension(formats.back()));
+    }
+    auto outputs = planOutputs(inputs, options, extensions);
+
+    auto start = std::chrono::steady_clock::now();
+    auto results = BatchRunner::run(inputs, [&](size_t index, const std::string& input) {
+        const std::string& output = getPath(outputs[index]);
+        const std::string& format = formats[index];
+        LoadedScene scene = loadScene(input);
+        size_t merged = 0;
+        for (const auto& object : scene.objects) {
+            merged += static_cast<size_t>(object->mergeVerticesByDistance(options.tolerance));
+        }
+        saveScene(output, format, scene);
+        return "-> " + output + " (" + std::to_string(merged) + " vertices merged, " + describe(scene) + ")";
+    });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return BatchRunner::report(results, seconds, std::cout) ? 0 : 1;
+}
+
+int CliCommands::merge(const CliOptions& options) {
+    if (options.output.empty()) {
+        throw std::invalid_argument("merge needs an output file (-o)");
+    }
+    std::string format = options.format.empty() ? getFormat(options.output) : options.format;
+    getExtension(format);
+    std::vector<std::string> inputs = getInputs(options);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<LoadedScene> scenes(inputs.size());
+    auto results = BatchRunner::run(inputs, [&](size_t index, const std::string& input) {
+        scenes[index] = loadScene(input);
+        return describe(scenes[index]);
+    });
+
+    BatchResult merged;
+    merged.input = options.output;
+    if (std::all_of(results.begin(), results.end(), [](const BatchResult& result) { return result.succeeded; })) {
+        auto mergeStart = std::chrono::steady_clock::now();
+        try {
+            LoadedScene scene;
+            for (auto& loaded : scenes) {
+                if (!scene.camera) {
+                    scene.camera = loaded.camera;
+                }
+                scene.objects.insert(scene.objects.end(), loaded.objects.begin(), loaded.objects.end());
+            }
+            if (options.booleanUnion) {
+                scene.objects = {ObjectsFactory::combineObjects(scene.objects)};
+            } else if (!options.keepObjects) {
+                auto object = bakeObjects(scene.objects);
+                object->mergeVerticesByDistance(options.tolerance);
+                scene.objects = {object};
+            }
+            saveScene(options.output, format, scene);
+            merged.succeeded = true;
+            merged.message = "merged " + std::to_string(inputs.size()) + " inputs (" + describe(scene) + ")";
+        } catch (const std::exception& e) {
+            merged.message = e.what();
+        }
+        merged.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - mergeStart).count();
+    } else {
+        merged.message = "not written, as inputs failed to load";
+    }
+    results.push_back(merged);
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return BatchRunner::report(results, seconds, std::cout) ? 0 : 1;
+}
+
+int CliCommands::stats(const CliOptions& options) {
+    std::vector<std::string> inputs = getInputs(options);
+
+    auto start = std::chrono::steady_clock::now();
+    auto results = BatchRunner::run(inputs, [&](size_t, const std::string& input) {
+        LoadedScene scene = loadScene(input);
+        size_t vertices = 0;
+        for (const auto& object : scene.objects) {
+            vertices += object->getVertices().size();
+        }
+
+        std::ostringstream description;
+        description << scene.objects.size() << (scene.objects.size() == 1 ? " object, " : " objects, ")
+                    << vertices << " vertices, " << countFaces(scene) << " faces";
+        Vector3 min;
+        Vector3 max;
+        if (getWorldBounds(scene, min, max)) {
+            Vector3 size = max - min;
+            description << ", size " << size.x << " x " << size.y << " x " << size.z;
+        }
+        description << ", " << fs::file_size(input) << " bytes";
+        return description.str();
+    });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return BatchRunner::report(results, seconds, std::cout) ? 0 : 1;
+}
+
+int CliCommands::renderThumbnail(const CliOptions& options) {
+    std::vector<std::string> inputs = getInputs(options);
+    auto outputs = planOutputs(inputs, options, std::vector<std::string>(inputs.size(), ".png"));
+
+    auto start = std::chrono::steady_clock::now();
+    auto results = BatchRunner::run(inputs, [&](size_t index, const std::string& input) {
+        const std::string& output = getPath(outputs[index]);
+        LoadedScene scene = loadScene(input);
+        ProjectCamera camera = scene.camera ? *scene.camera : frameScene(scene);
+        if (!ThumbnailRenderer::render(scene.objects, camera).saveToFile(output)) {
+            throw std::runtime_error("could not write " + output);
+        }
+        return "-> " + output;
+    });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return BatchRunner::report(results, seconds, std::cout) ? 0 : 1;
+}
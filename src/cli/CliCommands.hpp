@@ -0,0 +1,29 @@
+#ifndef CLI_COMMANDS_HPP
+#define CLI_COMMANDS_HPP
+
+#include <string>
+#include <vector>
+
+struct CliOptions {
+    // Files, or folders of files, in the order given
+    std::vector<std::string> inputs;
+    // Output file, or folder when there are several inputs; empty writes next to each input
+    std::string output;
+    // obj, stl, glb, prj (binary) or prj-text (JSON)
+    std::string format;
+    float tolerance = 1e-5f;
+    bool keepObjects = false;
+    bool booleanUnion = false;
+};
+
+// Subcommands of the command-line tool. Each returns the process exit code.
+class CliCommands {
+public:
+    static int convert(const CliOptions& options);
+    static int weld(const CliOptions& options);
+    static int merge(const CliOptions& options);
+    static int stats(const CliOptions& options);
+    static int renderThumbnail(const CliOptions& options);
+};
+
+#endif
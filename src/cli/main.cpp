@@ -0,0 +1,82 @@
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "CliCommands.hpp"
+
+static void printUsage() {
+    std::cerr <<
+        "Usage: 3d-cli <command> <inputs...> [options]\n"
+        "Inputs are .obj, .stl or .prj files, or folders of them, processed in parallel.\n"
+        "\n"
+        "Commands:\n"
+        "  convert           --to <format> [-o <file|folder>]\n"
+        "  weld              [--tolerance <distance>] [--to <format>] [-o <file|folder>]\n"
+        "  merge             -o <file> [--to <format>] [--tolerance <distance>] [--keep-objects | --union]\n"
+        "  stats\n"
+        "  render-thumbnail  [-o <file|folder>]\n"
+        "\n"
+        "Formats: obj, stl, glb, prj (binary project), prj-text (JSON project).\n"
+        "Outputs are written next to their inputs unless -o is given, and never over them.\n"
+        "merge bakes every object into one welded mesh unless it keeps the objects or unites them.\n";
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || std::strcmp(argv[1], "--help") == 0 || std::strcmp(argv[1], "-h") == 0) {
+        printUsage();
+        return argc < 2 ? 2 : 0;
+    }
+
+    std::string command = argv[1];
+    CliOptions options;
+    try {
+        for (int i = 2; i < argc; ++i) {
+            std::string argument = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument(argument + " needs a value");
+                }
+                return argv[++i];
+            };
+
+            if (argument == "-o" || argument == "--output") {
+                options.output = value();
+            } else if (argument == "--to") {
+                options.format = value();
+            } else if (argument == "--tolerance") {
+                options.tolerance = std::stof(value());
+            } else if (argument == "--keep-objects") {
+                options.keepObjects = true;
+            } else if (argument == "--union") {
+                options.booleanUnion = true;
+            } else if (argument.size() > 1 && argument[0] == '-') {
+                throw std::invalid_argument("Unknown option " + argument);
+            } else {
+                options.inputs.push_back(argument);
+            }
+        }
+
+        if (command == "convert") {
+            if (options.format.empty()) {
+                throw std::invalid_argument("convert needs a format (--to)");
+            }
+            return CliCommands::convert(options);
+        } else if (command == "weld") {
+            return CliCommands::weld(options);
+        } else if (command == "merge") {
+            return CliCommands::merge(options);
+        } else if (command == "stats") {
+            return CliCommands::stats(options);
+        } else if (command == "render-thumbnail") {
+            return CliCommands::renderThumbnail(options);
+        }
+        throw std::invalid_argument("Unknown command " + command);
+    } catch (const std::invalid_argument& e) {
+        std::cerr << e.what() << "\n\n";
+        printUsage();
+        return 2;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
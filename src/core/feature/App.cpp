@@ -2,6 +2,7 @@
 #include "../../views/ViewsManager.hpp"
 #include "../../utils/WindowManager.hpp"
 #include "../ui/Snackbar.hpp"
+#include "ProjectsManager.hpp"
 
 App::App() {}
 
@@ -18,8 +19,10 @@ void App::run() {
         }
         window.clear(sf::Color::Black);
         viewsManager.draw(window);
+        ProjectsManager::getInstance().update();
         Snackbar::getInstance().update();
         Snackbar::getInstance().draw(window);
         window.display();
     }
+    ProjectsManager::getInstance().closeProject();
 }
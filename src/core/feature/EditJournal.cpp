@@ -0,0 +1,218 @@
+#include "EditJournal.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+// Flushed records survive the app crashing; forcing them to disk is rarer since it is slow
+constexpr float JOURNAL_SYNC_SECONDS = 1.0f;
+
+static JournalFile::Transform getTransform(const Object3d& object) {
+    return {object.getPosition(), object.getRotation(), object.getScale()};
+}
+
+static bool sameTransform(const JournalFile::Transform& a, const JournalFile::Transform& b) {
+    return a.position == b.position && a.rotation == b.rotation && a.scale == b.scale;
+}
+
+static void sortUnique(std::vector<int>& indices) {
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+}
+
+EditJournal& EditJournal::getInstance() {
+    static EditJournal instance;
+    return instance;
+}
+
+std::string EditJournal::getJournalPath(const std::string& projectPath) {
+    return projectPath + ".journal";
+}
+
+void EditJournal::open(const std::string& projectPath, uint64_t saveId, const std::vector<uint32_t>& ids,
+                       bool recovered) {
+    discard();
+    path = getJournalPath(projectPath);
+    for (uint32_t id : ids) {
+        nextId = std::max(nextId, id + 1);
+    }
+    try {
+        if (!recovered) {
+            fs::remove(path);
+        }
+        file = std::make_unique<JournalFile>(path);
+        if (!recovered) {
+            file->writeBase(saveId, {});
+            file->sync();
+        }
+    } catch (const std::exception& e) {
+        fail(e);
+    }
+}
+
+void EditJournal::track(const std::shared_ptr<Object3d>& object, uint32_t id) {
+    if (!file) {
+        return;
+    }
+    object->setEditTracking(true);
+    entries[object.get()] = {object, id, object->getGeometryRevision(), getTransform(*object), frame};
+}
+
+void EditJournal::record(const std::vector<std::shared_ptr<Object3d>>& objects) {
+    if (!file) {
+        return;
+    }
+
+    ++frame;
+    try {
+        // Skip the grid plane
+        for (size_t i = 1; i < objects.size(); ++i) {
+            recordObject(objects[i]);
+        }
+        for (auto it = entries.begin(); it != entries.end();) {
+            if (it->second.seenFrame != frame) {
+                file->writeDeleteObject(it->second.id);
+                written = true;
+                it = entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        if (written) {
+            file->flush();
+            written = false;
+            unsynced = true;
+        }
+        if (unsynced && sinceSync.getElapsedTime().asSeconds() >= JOURNAL_SYNC_SECONDS) {
+            file->sync();
+            unsynced = false;
+            sinceSync.restart();
+        }
+    } catch (const std::exception& e) {
+        fail(e);
+    }
+}
+
+void EditJournal::recordObject(const std::shared_ptr<Object3d>& object) {
+    auto found = entries.find(object.get());
+    if (found != entries.end() && found->second.object.lock() != object) {
+        // A deleted object's address was reused by a new one
+        file->writeDeleteObject(found->second.id);
+        entries.erase(found);
+        found = entries.end();
+    }
+
+    if (found == entries.end()) {
+        uint32_t id = nextId++;
+        file->writeAddObject(id, getTransform(*object), object->getVertices(), object->getFaces());
+        track(object, id);
+        written = true;
+        return;
+    }
+
+    Entry& entry = found->second;
+    entry.seenFrame = frame;
+    if (entry.geometryRevision != object->getGeometryRevision()) {
+        Object3d::GeometryEdits edits = object->takeGeometryEdits();
+        if (edits.topologyChanged || (edits.movedVertices.empty() && edits.recoloredFaces.empty())) {
+            file->writeGeometry(entry.id, object->getVertices(), object->getFaces());
+        } else {
+            sortUnique(edits.movedVertices);
+            sortUnique(edits.recoloredFaces);
+            if (!edits.movedVertices.empty()) {
+                file->writeMovedVertices(entry.id, edits.movedVertices, object->getVertices());
+            }
+            if (!edits.recoloredFaces.empty()) {
+                file->writeFaceColors(entry.id, edits.recoloredFaces, object->getFaces());
+            }
+        }
+        entry.geometryRevision = object->getGeometryRevision();
+        written = true;
+    }
+
+    JournalFile::Transform transform = getTransform(*object);
+    if (!sameTransform(transform, entry.transform)) {
+        file->writeTransform(entry.id, transform);
+        entry.transform = transform;
+        written = true;
+    }
+}
+
+void EditJournal::beginSave(uint64_t saveId, const std::vector<std::shared_ptr<Object3d>>& objects) {
+    record(objects);
+    if (!file) {
+        return;
+    }
+
+    try {
+        // The save stores objects in scene order, which becomes their id in the new segment
+        std::vector<uint32_t> previousIds;
+        for (size_t i = 1; i < objects.size(); ++i) {
+            previousIds.push_back(entries.at(objects[i].get()).id);
+        }
+        file->writeBase(saveId, previousIds);
+        file->sync();
+        unsynced = false;
+
+        for (size_t i = 1; i < objects.size(); ++i) {
+            entries.at(objects[i].get()).id = static_cast<uint32_t>(i - 1);
+        }
+        nextId = static_cast<uint32_t>(previousIds.size());
+    } catch (const std::exception& e) {
+        fail(e);
+    }
+}
+
+void EditJournal::finishSave(uint64_t saveId) {
+    if (!file) {
+        return;
+    }
+
+    try {
+        file->dropBefore(saveId);
+    } catch (const std::exception& e) {
+        fail(e);
+    }
+}
+
+void EditJournal::close() {
+    if (file) {
+        try {
+            file->sync();
+        } catch (const std::exception& e) {
+            std::cerr << "Error syncing edit journal: " << e.what() << std::endl;
+        }
+    }
+    stop();
+}
+
+void EditJournal::discard() {
+    std::string journalPath = path;
+    stop();
+    if (!journalPath.empty()) {
+        std::error_code error;
+        fs::remove(journalPath, error);
+    }
+}
+
+void EditJournal::stop() {
+    for (const auto& [object, entry] : entries) {
+        if (auto tracked = entry.object.lock()) {
+            tracked->setEditTracking(false);
+        }
+    }
+    entries.clear();
+    file.reset();
+    path.clear();
+    nextId = 0;
+    written = false;
+    unsynced = false;
+}
+
+void EditJournal::fail(const std::exception& e) {
+    // Keep what was already journaled for recovery, but stop adding to it
+    std::cerr << "Edit journal disabled: " << e.what() << std::endl;
+    stop();
+}
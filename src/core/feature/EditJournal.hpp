@@ -0,0 +1,63 @@
+#ifndef EDIT_JOURNAL_HPP
+#define EDIT_JOURNAL_HPP
+
+#include <SFML/System.hpp>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../../utils/files/JournalFile.hpp"
+#include "../objects/Object3d.hpp"
+
+// Logs scene edits made since the last save to a journal next to the project, so they can be
+// recovered after a crash without writing the whole project. Small vertex and colour edits are
+// logged as deltas; anything that changes topology logs the object's full geometry.
+class EditJournal {
+public:
+    static EditJournal& getInstance();
+    static std::string getJournalPath(const std::string& projectPath);
+
+    // Starts a new journal against the save saveId, or continues a replayed one when recovered.
+    // ids holds the journal id of every object the project loads with.
+    void open(const std::string& projectPath, uint64_t saveId, const std::vector<uint32_t>& ids, bool recovered);
+    // Starts tracking an object loaded from the project under its journal id
+    void track(const std::shared_ptr<Object3d>& object, uint32_t id);
+    // Called every frame to log what changed since the previous call
+    void record(const std::vector<std::shared_ptr<Object3d>>& objects);
+    // Starts a segment against a save about to be written from the scene as it is now
+    void beginSave(uint64_t saveId, const std::vector<std::shared_ptr<Object3d>>& objects);
+    // Drops the segments the completed save made redundant
+    void finishSave(uint64_t saveId);
+    // Stops journaling, keeping the journal for the next time the project is opened
+    void close();
+    // Stops journaling and removes the journal
+    void discard();
+
+private:
+    EditJournal() = default;
+    EditJournal(const EditJournal&) = delete;
+    EditJournal& operator=(const EditJournal&) = delete;
+
+    struct Entry {
+        std::weak_ptr<Object3d> object;
+        uint32_t id = 0;
+        uint64_t geometryRevision = 0;
+        JournalFile::Transform transform;
+        uint64_t seenFrame = 0;
+    };
+
+    void recordObject(const std::shared_ptr<Object3d>& object);
+    void stop();
+    void fail(const std::exception& e);
+
+    std::unique_ptr<JournalFile> file;
+    std::string path;
+    std::unordered_map<const Object3d*, Entry> entries;
+    uint32_t nextId = 0;
+    uint64_t frame = 0;
+    bool written = false;
+    bool unsynced = false;
+    sf::Clock sinceSync;
+};
+
+#endif
@@ -0,0 +1,227 @@
+#include "GeometryPager.hpp"
+#include "../../utils/ThreadPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+constexpr size_t MAX_READS_IN_FLIGHT = 4;
+// Objects are paged in a little before they come into view
+constexpr float PAGE_IN_MARGIN = 1.25f;
+// Matches the renderer's clip planes
+constexpr float NEAR_PLANE = 0.1f;
+constexpr float FAR_PLANE = 100.0f;
+
+static size_t geometryBytes(const Object3d& object) {
+    return object.getVertices().size() * sizeof(Vector3) +
+           object.getFaces().size() * sizeof(std::array<int, 7>) +
+           object.getEdges().size() * sizeof(std::pair<int, int>);
+}
+
+// Tests the object's bounding sphere against the view, returning its camera-space depth in distance
+static bool isInView(const Object3d& object, const Matrix4& viewMatrix, const Matrix4& projectionMatrix,
+                     float& distance) {
+    const BoundingSphere& sphere = object.getLocalBoundingSphere();
+    Vector4 center = viewMatrix * (object.getTransformation() * Vector4(sphere.center, 1.0f));
+    Vector3 scale = object.getScale();
+    float radius = sphere.radius * std::max({std::abs(scale.x), std::abs(scale.y), std::abs(scale.z)}) * PAGE_IN_MARGIN;
+    distance = center.z;
+
+    if (center.z + radius < NEAR_PLANE || center.z - radius > FAR_PLANE) return false;
+    if (center.z <= radius) return true;
+
+    // Screen-space extent of the sphere in normalized device coordinates
+    float x = center.x * projectionMatrix(0, 0) / center.z;
+    float y = center.y * projectionMatrix(1, 1) / center.z;
+    float extentX = radius * std::abs(projectionMatrix(0, 0)) / center.z;
+    float extentY = radius * std::abs(projectionMatrix(1, 1)) / center.z;
+    return std::abs(x) <= 1.0f + extentX && std::abs(y) <= 1.0f + extentY;
+}
+
+GeometryPager& GeometryPager::getInstance() {
+    static GeometryPager instance;
+    return instance;
+}
+
+BoundingBox GeometryPager::getBounds(const BinaryPrjSection& section) {
+    return {section.boundsMin, section.boundsMax};
+}
+
+void GeometryPager::open(const std::string& path) {
+    close();
+    projectPath = path;
+}
+
+void GeometryPager::close() {
+    // Reads map the project file, which must be released before it is replaced or deleted
+    collectReads(true);
+    entries.clear();
+    projectPath.clear();
+    writing = false;
+    waitForWrite = nullptr;
+}
+
+GeometryPager::Entry* GeometryPager::findEntry(const std::shared_ptr<Object3d>& object) {
+    auto found = entries.find(object.get());
+    if (found == entries.end() || found->second.object.lock() != object) {
+        return nullptr;
+    }
+    return &found->second;
+}
+
+void GeometryPager::setSection(const std::shared_ptr<Object3d>& object, const BinaryPrjSection& section,
+                               uint64_t revision) {
+    Entry& entry = entries[object.get()];
+    if (entry.object.lock() != object) {
+        entry = Entry();
+        entry.object = object;
+        entry.lastUsedFrame = frame;
+    }
+    entry.section = section;
+    entry.revision = revision;
+    entry.failed = false;
+}
+
+void GeometryPager::beginWrite(std::function<void()> waitForWriteFunction) {
+    collectReads(true);
+    writing = true;
+    waitForWrite = std::move(waitForWriteFunction);
+}
+
+void GeometryPager::endWrite() {
+    writing = false;
+    waitForWrite = nullptr;
+}
+
+void GeometryPager::require(const std::shared_ptr<Object3d>& object) {
+    if (!object->isPagedOut()) {
+        return;
+    }
+    if (writing && waitForWrite) {
+        // The save refreshes the sections before it ends the write
+        std::function<void()> wait = waitForWrite;
+        wait();
+    }
+
+    Entry* entry = findEntry(object);
+    if (!entry || !object->isPagedOut()) {
+        return;
+    }
+    try {
+        Geometry geometry;
+        BinaryPrjFile::readGeometry(projectPath, entry->section, geometry.vertices, geometry.faces);
+        object->pageIn(std::move(geometry.vertices), std::move(geometry.faces));
+        entry->lastUsedFrame = frame;
+    } catch (const std::exception& e) {
+        entry->failed = true;
+        std::cerr << "Error reading object geometry: " << e.what() << std::endl;
+    }
+}
+
+void GeometryPager::requireAll(const std::vector<std::shared_ptr<Object3d>>& objects) {
+    for (const auto& object : objects) {
+        require(object);
+    }
+}
+
+void GeometryPager::collectReads(bool wait) {
+    for (auto it = reads.begin(); it != reads.end();) {
+        if (!wait && it->result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ++it;
+            continue;
+        }
+
+        auto object = it->object.lock();
+        Entry* entry = object ? findEntry(object) : nullptr;
+        if (entry) {
+            entry->reading = false;
+        }
+        try {
+            Geometry geometry = it->result.get();
+            // require() may have read it in meanwhile
+            if (entry && object->isPagedOut()) {
+                object->pageIn(std::move(geometry.vertices), std::move(geometry.faces));
+            }
+        } catch (const std::exception& e) {
+            if (entry) {
+                entry->failed = true;
+            }
+            std::cerr << "Error reading object geometry: " << e.what() << std::endl;
+        }
+        it = reads.erase(it);
+    }
+}
+
+void GeometryPager::update(const std::vector<std::shared_ptr<Object3d>>& objects, int editedIndex,
+                           const Camera& camera) {
+    ++frame;
+    collectReads(false);
+    if (projectPath.empty()) {
+        return;
+    }
+
+    Matrix4 viewMatrix = camera.getViewMatrix();
+    Matrix4 projectionMatrix = camera.getProjectionMatrix();
+    std::vector<std::pair<float, std::shared_ptr<Object3d>>> wanted;
+    size_t residentBytes = 0;
+
+    // Skip the grid plane
+    for (size_t i = 1; i < objects.size(); ++i) {
+        const auto& object = objects[i];
+        float distance = 0.0f;
+        bool used = object->isSelected || static_cast<int>(i) == editedIndex ||
+                    isInView(*object, viewMatrix, projectionMatrix, distance);
+        Entry* entry = findEntry(object);
+        if (entry && used) {
+            entry->lastUsedFrame = frame;
+        }
+
+        if (!object->isPagedOut()) {
+            residentBytes += geometryBytes(*object);
+        } else if (used && entry && !entry->reading && !entry->failed) {
+            wanted.emplace_back(distance, object);
+        }
+    }
+
+    if (!writing && reads.size() < MAX_READS_IN_FLIGHT) {
+        std::sort(wanted.begin(), wanted.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (const auto& [distance, object] : wanted) {
+            if (reads.size() >= MAX_READS_IN_FLIGHT) break;
+            Entry* entry = findEntry(object);
+            entry->reading = true;
+            reads.push_back({object, ThreadPool::getInstance().submit(
+                [path = projectPath, section = entry->section]() {
+                    Geometry geometry;
+                    BinaryPrjFile::readGeometry(path, section, geometry.vertices, geometry.faces);
+                    return geometry;
+                })});
+        }
+    }
+
+    if (residentBytes > MEMORY_BUDGET) {
+        pageOutLeastRecentlyUsed(residentBytes);
+    }
+
+    for (auto it = entries.begin(); it != entries.end();) {
+        it = it->second.object.expired() ? entries.erase(it) : std::next(it);
+    }
+}
+
+void GeometryPager::pageOutLeastRecentlyUsed(size_t residentBytes) {
+    // Only geometry identical to what the file holds can be dropped, and only if unused this frame
+    std::vector<std::pair<uint64_t, std::shared_ptr<Object3d>>> candidates;
+    for (const auto& [key, entry] : entries) {
+        auto object = entry.object.lock();
+        if (object && !object->isPagedOut() && !object->isSelected && entry.lastUsedFrame < frame &&
+            object->getGeometryRevision() == entry.revision) {
+            candidates.emplace_back(entry.lastUsedFrame, object);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    for (const auto& [lastUsed, object] : candidates) {
+        if (residentBytes <= MEMORY_BUDGET) break;
+        residentBytes -= std::min(residentBytes, geometryBytes(*object));
+        object->pageOut(getBounds(findEntry(object)->section));
+    }
+}
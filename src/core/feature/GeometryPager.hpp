@@ -0,0 +1,77 @@
+#ifndef GEOMETRY_PAGER_HPP
+#define GEOMETRY_PAGER_HPP
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../../utils/files/BinaryPrjFile.hpp"
+#include "../objects/Object3d.hpp"
+#include "Camera.hpp"
+
+// Keeps the geometry of objects saved in the binary project file in memory only while it is
+// needed. Visible objects are read in on the thread pool and selected or edited ones right away;
+// once the resident geometry exceeds the budget, the least recently used clean objects are paged out.
+class GeometryPager {
+public:
+    static constexpr size_t MEMORY_BUDGET = size_t(512) << 20;
+
+    static GeometryPager& getInstance();
+    static BoundingBox getBounds(const BinaryPrjSection& section);
+
+    void open(const std::string& projectPath);
+    void close();
+    // The object's geometry at revision is stored at section in the project file
+    void setSection(const std::shared_ptr<Object3d>& object, const BinaryPrjSection& section, uint64_t revision);
+
+    // Brackets a save, which may move sections. No reads run meanwhile; require() calls
+    // waitForWrite to let the save finish first.
+    void beginWrite(std::function<void()> waitForWrite);
+    void endWrite();
+
+    // Reads a paged out object's geometry right away
+    void require(const std::shared_ptr<Object3d>& object);
+    void requireAll(const std::vector<std::shared_ptr<Object3d>>& objects);
+
+    // Called every frame with the scene objects and the index of the one being edited
+    void update(const std::vector<std::shared_ptr<Object3d>>& objects, int editedIndex, const Camera& camera);
+
+private:
+    GeometryPager() = default;
+    GeometryPager(const GeometryPager&) = delete;
+    GeometryPager& operator=(const GeometryPager&) = delete;
+
+    struct Entry {
+        std::weak_ptr<Object3d> object;
+        BinaryPrjSection section;
+        uint64_t revision = 0;
+        uint64_t lastUsedFrame = 0;
+        bool reading = false;
+        bool failed = false;
+    };
+
+    struct Geometry {
+        std::vector<Vector3> vertices;
+        std::vector<std::array<int, 7>> faces;
+    };
+
+    struct PendingRead {
+        std::weak_ptr<Object3d> object;
+        std::future<Geometry> result;
+    };
+
+    Entry* findEntry(const std::shared_ptr<Object3d>& object);
+    void collectReads(bool wait);
+    void pageOutLeastRecentlyUsed(size_t residentBytes);
+
+    std::string projectPath;
+    std::unordered_map<const Object3d*, Entry> entries;
+    std::vector<PendingRead> reads;
+    bool writing = false;
+    std::function<void()> waitForWrite;
+    uint64_t frame = 0;
+};
+
+#endif
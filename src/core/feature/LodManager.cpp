@@ -0,0 +1,76 @@
+#include "LodManager.hpp"
+#include "../../utils/ThreadPool.hpp"
+#include <chrono>
+#include <iterator>
+
+constexpr size_t LOD_MIN_SOURCE_FACES = 512;
+constexpr size_t LOD_MIN_LEVEL_FACES = 256;
+constexpr int LOD_MAX_LEVELS = 3;
+constexpr float LOD_SETTLE_SECONDS = 0.3f;
+
+LodManager& LodManager::getInstance() {
+    static LodManager instance;
+    return instance;
+}
+
+LodManager::Entry& LodManager::entryFor(const std::shared_ptr<Object3d>& object) {
+    Entry& entry = entries[object.get()];
+    if (entry.object.lock() != object) {
+        entry = Entry();
+        entry.object = object;
+        entry.observedRevision = object->getGeometryRevision();
+    }
+    return entry;
+}
+
+void LodManager::collectFinished() {
+    for (auto& [key, entry] : entries) {
+        if (!entry.building) continue;
+        if (entry.result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) continue;
+        entry.building = false;
+
+        std::vector<LodLevel> levels;
+        try {
+            levels = entry.result.get();
+        } catch (const std::exception& e) {
+            std::cerr << "LOD generation failed: " << e.what() << std::endl;
+            continue;
+        }
+
+        auto object = entry.object.lock();
+        if (object && object->getGeometryRevision() == entry.buildRevision) {
+            object->setLodLevels(std::make_shared<const std::vector<LodLevel>>(std::move(levels)), entry.buildRevision);
+        }
+    }
+
+    for (auto it = entries.begin(); it != entries.end();) {
+        it = !it->second.building && it->second.object.expired() ? entries.erase(it) : std::next(it);
+    }
+}
+
+void LodManager::update(const std::vector<std::shared_ptr<Object3d>>& objects) {
+    collectFinished();
+
+    for (const auto& object : objects) {
+        if (object->getFaces().size() < LOD_MIN_SOURCE_FACES) continue;
+
+        Entry& entry = entryFor(object);
+        uint64_t revision = object->getGeometryRevision();
+        if (revision != entry.observedRevision) {
+            entry.observedRevision = revision;
+            entry.stableFor.restart();
+            continue;
+        }
+        if (entry.building || (entry.attempted && entry.buildRevision == revision)) continue;
+        if (entry.stableFor.getElapsedTime().asSeconds() < LOD_SETTLE_SECONDS) continue;
+
+        auto vertices = object->getVertices();
+        auto faces = object->getFaces();
+        entry.building = true;
+        entry.attempted = true;
+        entry.buildRevision = revision;
+        entry.result = ThreadPool::getInstance().submit([vertices = std::move(vertices), faces = std::move(faces)]() {
+            return MeshDecimator::buildLodChain(vertices, faces, LOD_MAX_LEVELS, LOD_MIN_LEVEL_FACES);
+        });
+    }
+}
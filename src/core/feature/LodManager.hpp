@@ -0,0 +1,40 @@
+#ifndef LOD_MANAGER_HPP
+#define LOD_MANAGER_HPP
+
+#include "../objects/Object3d.hpp"
+#include <SFML/System.hpp>
+#include <future>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Builds simplified meshes for heavy objects on the thread pool once their geometry stops changing.
+class LodManager {
+public:
+    static LodManager& getInstance();
+
+    void update(const std::vector<std::shared_ptr<Object3d>>& objects);
+
+private:
+    LodManager() = default;
+    LodManager(const LodManager&) = delete;
+    LodManager& operator=(const LodManager&) = delete;
+
+    struct Entry {
+        std::weak_ptr<Object3d> object;
+        uint64_t observedRevision = 0;
+        sf::Clock stableFor;
+        bool building = false;
+        bool attempted = false;
+        uint64_t buildRevision = 0;
+        std::future<std::vector<LodLevel>> result;
+    };
+
+    // Keyed by address; the weak pointer tells a live object from a new one at a reused address
+    std::unordered_map<const Object3d*, Entry> entries;
+
+    Entry& entryFor(const std::shared_ptr<Object3d>& object);
+    void collectFinished();
+};
+
+#endif
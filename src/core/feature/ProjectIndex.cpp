@@ -0,0 +1,351 @@
+#include "ProjectIndex.hpp"
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <nlohmann/json.hpp>
+#include "../../utils/LanguageManager.hpp"
+#include "../../utils/ThreadPool.hpp"
+#include "../../utils/files/BinaryPrjFile.hpp"
+#include "../../utils/files/Config.hpp"
+#include "../ui/Snackbar.hpp"
+#include "ThumbnailCache.hpp"
+
+namespace fs = std::filesystem;
+
+constexpr char CACHE_NAME[] = ".index.json";
+constexpr int CACHE_VERSION = 1;
+constexpr std::chrono::seconds SCAN_RETRY_DELAY(2);
+
+static bool isProject(const std::string& name) {
+    return fs::path(name).extension() == ".prj";
+}
+
+// Runs on pool threads, so it uses the reentrant localtime rather than its shared buffer
+static std::string formatDate(std::time_t time) {
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &time);
+#else
+    localtime_r(&time, &local);
+#endif
+    std::ostringstream oss;
+    oss << std::put_time(&local, "%Y-%m-%d %H:%M:%S");
+    return oss.str();
+}
+
+ProjectIndex& ProjectIndex::getInstance() {
+    static ProjectIndex instance;
+    return instance;
+}
+
+std::string ProjectIndex::getCachePath(const std::string& directory) {
+    return (fs::path(directory) / CACHE_NAME).string();
+}
+
+const std::vector<ProjectIndexEntry>& ProjectIndex::getEntries() const {
+    return sortedEntries;
+}
+
+uint64_t ProjectIndex::getRevision() const {
+    return revision;
+}
+
+void ProjectIndex::update() {
+    std::string projectsPath = Config::getInstance().getProjectsPath();
+    if (!watcher || projectsPath != directory) {
+        open(projectsPath);
+    }
+
+    if (pendingRefresh.valid()) {
+        if (pendingRefresh.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return;
+        }
+        apply(pendingRefresh.get());
+    }
+
+    if (watcher->takeOverflow()) {
+        scanNeeded = true;
+    }
+    for (const auto& name : watcher->takeChanges()) {
+        if (isProject(name)) {
+            changedNames.insert(name);
+        }
+    }
+    startRefresh();
+}
+
+void ProjectIndex::invalidate(const std::string& projectPath) {
+    fs::path path = fs::path(projectPath).lexically_normal();
+    if (!directory.empty() && path.parent_path() == fs::path(directory).lexically_normal()) {
+        changedNames.insert(path.filename().string());
+    }
+}
+
+void ProjectIndex::remove(const std::string& projectPath) {
+    fs::path path = fs::path(projectPath).lexically_normal();
+    if (directory.empty() || path.parent_path() != fs::path(directory).lexically_normal()) return;
+    if (entries.erase(path.filename().string()) == 0) return;
+    sortEntries();
+    writeCache();
+}
+
+void ProjectIndex::open(const std::string& projectsPath) {
+    watcher.reset();
+    directory = projectsPath;
+    entries.clear();
+    sortedEntries.clear();
+    changedNames.clear();
+    cacheRead = false;
+    scanNeeded = true;
+    scanFailed = false;
+    nextScanTime = {};
+    revision++;
+
+    std::error_code error;
+    fs::create_directories(directory, error);
+    if (error) {
+        std::cerr << "Error accessing projects folder: " << error.message() << std::endl;
+    }
+    // Started before the first scan so no change made during it is missed
+    watcher = std::make_unique<DirectoryWatcher>(directory);
+}
+
+void ProjectIndex::startRefresh() {
+    if (pendingRefresh.valid()) return;
+
+    if (!cacheRead) {
+        pendingRefresh = ThreadPool::getInstance().submit([directory = directory]() { return readCache(directory); });
+    } else if (scanNeeded && std::chrono::steady_clock::now() >= nextScanTime) {
+        scanNeeded = false;
+        changedNames.clear();
+        pendingRefresh = ThreadPool::getInstance().submit([directory = directory, cached = entries]() {
+            return scan(directory, cached);
+        });
+    } else if (!changedNames.empty()) {
+        std::map<std::string, ProjectIndexEntry> cached;
+        for (const auto& name : changedNames) {
+            auto found = entries.find(name);
+            if (found != entries.end()) {
+                cached.insert(*found);
+            }
+        }
+        pendingRefresh = ThreadPool::getInstance().submit(
+            [directory = directory, names = std::move(changedNames), cached = std::move(cached)]() {
+                return read(directory, names, cached);
+            });
+        changedNames.clear();
+    }
+}
+
+void ProjectIndex::apply(Refresh refresh) {
+    // Read from a folder the settings have since moved away from
+    if (refresh.directory != directory) return;
+
+    if (!refresh.error.empty()) {
+        if (!scanFailed) {
+            const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+            Snackbar::getInstance().addMessage(languagePack[TextKey::ErrorAccessingProjectsFolder]);
+            std::cerr << "Error accessing projects folder: " << refresh.error << std::endl;
+        }
+        // The list may have missed changes, so the folder is scanned again
+        scanFailed = true;
+        scanNeeded = true;
+        nextScanTime = std::chrono::steady_clock::now() + SCAN_RETRY_DELAY;
+    } else if (refresh.complete) {
+        scanFailed = false;
+    }
+
+    bool changed = false;
+    if (refresh.fromCache) {
+        cacheRead = true;
+    }
+    if (refresh.complete) {
+        for (auto entry = entries.begin(); entry != entries.end();) {
+            if (refresh.entries.find(entry->first) == refresh.entries.end()) {
+                entry = entries.erase(entry);
+                changed = true;
+            } else {
+                ++entry;
+            }
+        }
+    }
+    for (auto& [name, entry] : refresh.entries) {
+        auto found = entries.find(name);
+        if (!entry) {
+            if (found != entries.end()) {
+                entries.erase(found);
+                changed = true;
+            }
+        } else if (found == entries.end() || found->second.modified != entry->modified ||
+                   found->second.size != entry->size) {
+            entries[name] = std::move(*entry);
+            changed = true;
+        }
+    }
+    if (!changed) return;
+
+    sortEntries();
+    if (!refresh.fromCache) {
+        writeCache();
+    }
+}
+
+void ProjectIndex::sortEntries() {
+    sortedEntries.clear();
+    for (const auto& [name, entry] : entries) {
+        sortedEntries.push_back(entry);
+    }
+    std::stable_sort(sortedEntries.begin(), sortedEntries.end(), [](const ProjectIndexEntry& a, const ProjectIndexEntry& b) {
+        return a.lastModifiedTime > b.lastModifiedTime;
+    });
+    revision++;
+}
+
+void ProjectIndex::writeCache() {
+    nlohmann::json projects = nlohmann::json::array();
+    for (const auto& [name, entry] : entries) {
+        projects.push_back({
+            {"name", entry.fileName},
+            {"modified", entry.modified},
+            {"modifiedTime", static_cast<int64_t>(entry.lastModifiedTime)},
+            {"size", entry.size},
+            {"countsKnown", entry.countsKnown},
+            {"objects", entry.objectCount},
+            {"faces", entry.faceCount}
+        });
+    }
+    nlohmann::json json = {{"version", CACHE_VERSION}, {"projects", std::move(projects)}};
+
+    // Writes run one at a time and replace the file only once complete
+    if (pendingWrite.valid()) {
+        pendingWrite.wait();
+    }
+    pendingWrite = ThreadPool::getInstance().submit([path = getCachePath(directory), json = std::move(json)]() {
+        std::string temporaryPath = path + ".tmp";
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            file << json.dump();
+            if (!file) {
+                std::cerr << "Error writing project index: " << temporaryPath << std::endl;
+                return;
+            }
+        }
+        std::error_code error;
+        fs::rename(temporaryPath, path, error);
+        if (error) {
+            std::cerr << "Error writing project index: " << error.message() << std::endl;
+        }
+    });
+}
+
+ProjectIndex::Refresh ProjectIndex::readCache(const std::string& directory) {
+    Refresh refresh;
+    refresh.directory = directory;
+    refresh.fromCache = true;
+
+    std::ifstream file(getCachePath(directory), std::ios::binary);
+    if (!file) return refresh;
+    try {
+        nlohmann::json json = nlohmann::json::parse(file);
+        if (json.value("version", 0) != CACHE_VERSION) return refresh;
+        for (const auto& project : json.at("projects")) {
+            ProjectIndexEntry entry;
+            entry.fileName = project.at("name").get<std::string>();
+            entry.filePath = (fs::path(directory) / entry.fileName).string();
+            entry.modified = project.at("modified").get<int64_t>();
+            entry.lastModifiedTime = static_cast<std::time_t>(project.at("modifiedTime").get<int64_t>());
+            entry.lastUpdateDate = formatDate(entry.lastModifiedTime);
+            entry.size = project.at("size").get<uintmax_t>();
+            entry.countsKnown = project.at("countsKnown").get<bool>();
+            entry.objectCount = project.at("objects").get<uint32_t>();
+            entry.faceCount = project.at("faces").get<uint64_t>();
+            entry.thumbnailKey = ThumbnailCache::makeKey(entry.modified, entry.size);
+            refresh.entries[entry.fileName] = std::move(entry);
+        }
+    } catch (const std::exception& e) {
+        // A damaged cache only costs the full scan that follows anyway
+        std::cerr << "Ignoring project index: " << e.what() << std::endl;
+        refresh.entries.clear();
+    }
+    return refresh;
+}
+
+ProjectIndex::Refresh ProjectIndex::scan(const std::string& directory, const std::map<std::string, ProjectIndexEntry>& cached) {
+    Refresh refresh;
+    refresh.directory = directory;
+    refresh.complete = true;
+    try {
+        for (const auto& file : fs::directory_iterator(directory)) {
+            std::string name = file.path().filename().string();
+            if (!isProject(name)) continue;
+            auto found = cached.find(name);
+            if (auto entry = readEntry(directory, name, found != cached.end() ? &found->second : nullptr)) {
+                refresh.entries[name] = std::move(entry);
+            }
+        }
+    } catch (const std::exception& e) {
+        // Keep what the cache said rather than emptying the list
+        refresh.complete = false;
+        refresh.entries.clear();
+        refresh.error = e.what();
+    }
+    return refresh;
+}
+
+ProjectIndex::Refresh ProjectIndex::read(const std::string& directory, const std::set<std::string>& names,
+                                         const std::map<std::string, ProjectIndexEntry>& cached) {
+    Refresh refresh;
+    refresh.directory = directory;
+    for (const auto& name : names) {
+        auto found = cached.find(name);
+        refresh.entries[name] = readEntry(directory, name, found != cached.end() ? &found->second : nullptr);
+    }
+    return refresh;
+}
+
+std::optional<ProjectIndexEntry> ProjectIndex::readEntry(const std::string& directory, const std::string& name,
+                                                         const ProjectIndexEntry* cached) {
+    fs::path path = fs::path(directory) / name;
+    std::error_code error;
+    if (!fs::is_regular_file(path, error)) return std::nullopt;
+    auto modified = fs::last_write_time(path, error);
+    if (error) return std::nullopt;
+    auto size = fs::file_size(path, error);
+    if (error) return std::nullopt;
+
+    if (cached && cached->modified == modified.time_since_epoch().count() && cached->size == size) {
+        return *cached;
+    }
+
+    ProjectIndexEntry entry;
+    entry.fileName = name;
+    entry.filePath = path.string();
+    entry.modified = modified.time_since_epoch().count();
+    entry.size = size;
+    auto systemTime = std::chrono::time_point_cast<std::chrono::system_clock::duration>(
+        modified - fs::file_time_type::clock::now() + std::chrono::system_clock::now());
+    entry.lastModifiedTime = std::chrono::system_clock::to_time_t(systemTime);
+    entry.lastUpdateDate = formatDate(entry.lastModifiedTime);
+    entry.thumbnailKey = ThumbnailCache::makeKey(entry.modified, entry.size);
+
+    try {
+        if (BinaryPrjFile::isBinary(entry.filePath)) {
+            std::vector<BinaryPrjSection> sections;
+            ProjectData project = BinaryPrjFile::readHeaders(entry.filePath, sections);
+            entry.objectCount = static_cast<uint32_t>(project.objects.size());
+            for (const auto& section : sections) {
+                entry.faceCount += section.faceCount;
+            }
+            entry.countsKnown = true;
+        }
+    } catch (const std::exception& e) {
+        // Possibly still being written; the watcher reports it again once closed
+        std::cerr << "Error reading project " << name << ": " << e.what() << std::endl;
+    }
+    return entry;
+}
@@ -0,0 +1,93 @@
+#ifndef PROJECT_INDEX_HPP
+#define PROJECT_INDEX_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <future>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+#include "../../utils/files/DirectoryWatcher.hpp"
+
+struct ProjectIndexEntry {
+    std::string fileName;
+    std::string filePath;
+    std::string lastUpdateDate;
+    std::time_t lastModifiedTime = 0;
+    // Modification time in file clock ticks, compared to spot changed files
+    int64_t modified = 0;
+    uintmax_t size = 0;
+    // Only binary projects record their counts without being parsed
+    bool countsKnown = false;
+    uint32_t objectCount = 0;
+    uint64_t faceCount = 0;
+    std::string thumbnailKey;
+};
+
+// The projects in the projects folder, cached in a file inside it so the list shows at once.
+// Files are read again on the thread pool only when the directory watcher reports them changed;
+// the whole folder is rescanned once when it is opened and whenever events were lost.
+class ProjectIndex {
+public:
+    static ProjectIndex& getInstance();
+
+    // Called every frame the list is shown; follows the configured projects folder
+    void update();
+    // Newest first
+    const std::vector<ProjectIndexEntry>& getEntries() const;
+    // Increases whenever the entries change
+    uint64_t getRevision() const;
+    // Reads a project again that the app itself just wrote or removed
+    void invalidate(const std::string& projectPath);
+    // Drops a project the app itself just deleted, without waiting for the folder to be read again
+    void remove(const std::string& projectPath);
+
+private:
+    ProjectIndex() = default;
+    ProjectIndex(const ProjectIndex&) = delete;
+    ProjectIndex& operator=(const ProjectIndex&) = delete;
+
+    // Result of a background read. A complete one replaces every entry; otherwise a missing
+    // value means the file is gone.
+    struct Refresh {
+        std::string directory;
+        bool complete = false;
+        bool fromCache = false;
+        std::map<std::string, std::optional<ProjectIndexEntry>> entries;
+        std::string error;
+    };
+
+    static std::string getCachePath(const std::string& directory);
+    static Refresh readCache(const std::string& directory);
+    static Refresh scan(const std::string& directory, const std::map<std::string, ProjectIndexEntry>& cached);
+    static Refresh read(const std::string& directory, const std::set<std::string>& names,
+                        const std::map<std::string, ProjectIndexEntry>& cached);
+    static std::optional<ProjectIndexEntry> readEntry(const std::string& directory, const std::string& name,
+                                                      const ProjectIndexEntry* cached);
+
+    void open(const std::string& projectsPath);
+    void startRefresh();
+    void apply(Refresh refresh);
+    void sortEntries();
+    void writeCache();
+
+    std::string directory;
+    std::unique_ptr<DirectoryWatcher> watcher;
+    std::map<std::string, ProjectIndexEntry> entries;
+    std::vector<ProjectIndexEntry> sortedEntries;
+    uint64_t revision = 0;
+    bool cacheRead = false;
+    bool scanNeeded = false;
+    // A failed scan is retried after a delay, and only the first failure in a row is shown
+    bool scanFailed = false;
+    std::chrono::steady_clock::time_point nextScanTime;
+    std::set<std::string> changedNames;
+    std::future<Refresh> pendingRefresh;
+    std::future<void> pendingWrite;
+};
+
+#endif
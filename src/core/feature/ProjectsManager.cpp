@@ -1,140 +1,525 @@
 #include "ProjectsManager.hpp"
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <iostream>
+#include <numeric>
 #include <stdexcept>
-#include <bits/random.h>
+#include <random>
 
 #include "../../utils/LanguageManager.hpp"
 #include "../../utils/files/FileManager.hpp"
 #include "../../utils/WindowManager.hpp"
+#include "../../utils/ThreadPool.hpp"
 #include "../objects/CustomShape.hpp"
+#include "../../utils/files/BinaryPrjFile.hpp"
+#include "../../utils/files/JournalFile.hpp"
+#include "EditJournal.hpp"
+#include "GeometryPager.hpp"
+#include "ProjectIndex.hpp"
+#include "ThumbnailCache.hpp"
+#include "ThumbnailRenderer.hpp"
 #include "../ui/Snackbar.hpp"
 #include <sstream>
 
 namespace fs = std::filesystem;
 
+// Full-resolution faces a save may copy for its preview; past this, objects are drawn at a level
+// of detail or as boxes
+constexpr size_t THUMBNAIL_FACE_BUDGET = 200000;
+
+static uint64_t generateSaveId() {
+    static std::mt19937_64 generator(std::random_device{}());
+    uint64_t saveId;
+    do {
+        saveId = generator();
+    } while (saveId == 0);
+    return saveId;
+}
+
+static BoundingBox getLocalBounds(const std::vector<Vector3>& vertices) {
+    BoundingBox bounds{Vector3(), Vector3()};
+    if (!vertices.empty()) {
+        bounds = {vertices[0], vertices[0]};
+        for (const auto& vertex : vertices) {
+            bounds.min = Vector3(std::min(bounds.min.x, vertex.x), std::min(bounds.min.y, vertex.y), std::min(bounds.min.z, vertex.z));
+            bounds.max = Vector3(std::max(bounds.max.x, vertex.x), std::max(bounds.max.y, vertex.y), std::max(bounds.max.z, vertex.z));
+        }
+    }
+    return bounds;
+}
+
+// Orders objects by distance from the camera to the centre of their bounds, ignoring rotation
+static std::vector<size_t> nearestFirst(const ProjectData& project, const std::vector<BoundingBox>& bounds) {
+    std::vector<float> distances;
+    for (size_t i = 0; i < project.objects.size(); ++i) {
+        const ProjectObject& object = project.objects[i];
+        Vector3 local = (bounds[i].min + bounds[i].max) * 0.5f;
+        Vector3 centre = object.position + Vector3(local.x * object.scale.x, local.y * object.scale.y, local.z * object.scale.z);
+        distances.push_back((centre - project.camera.position).lengthSquared());
+    }
+
+    std::vector<size_t> order(project.objects.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return distances[a] < distances[b]; });
+    return order;
+}
+
 ProjectsManager& ProjectsManager::getInstance() {
     static ProjectsManager instance;
     return instance;
 }
 
-std::vector<FileInfo> ProjectsManager::getProjects() {
-    std::vector<FileInfo> projects;
-    std::string projectsPath = Config::getInstance().getProjectsPath();
+const std::vector<ProjectIndexEntry>& ProjectsManager::getProjects() {
+    ProjectIndex& index = ProjectIndex::getInstance();
+    index.update();
+    return index.getEntries();
+}
 
-    try {
-        if (!fs::exists(projectsPath)) {
-            fs::create_directories(projectsPath);
+void ProjectsManager::setProject(std::string projectPath) {
+    cancelLoad();
+    waitForPendingSave();
+    EditJournal::getInstance().discard();
+    sf::RenderWindow& window = WindowManager::getInstance().getWindow();
+    Scene::getInstance(window).resetObjects();
+
+    setSelectedProject(projectPath);
+    activeLoad = std::make_shared<ProjectLoad>();
+    loadHeaderApplied = false;
+    loadedObjects = 0;
+    loadTask = ThreadPool::getInstance().submit([load = activeLoad, projectPath]() {
+        bool binary = BinaryPrjFile::isBinary(projectPath);
+        // A journal left behind needs every object's geometry to replay; otherwise only the
+        // object table is read up front
+        std::error_code error;
+        bool lazy = binary && !fs::exists(EditJournal::getJournalPath(projectPath), error);
+        std::vector<BinaryPrjSection> sections;
+        ProjectData project = lazy ? BinaryPrjFile::readHeaders(projectPath, sections)
+                                   : readProject(projectPath, sections);
+        if (load->cancelled) {
+            return;
         }
 
-        auto files = FileManager::getInstance().getFolderFiles(projectsPath);
-        for (const auto& file : files) {
-            if (fs::path(file.fileName).extension() == ".prj") {
-                projects.push_back(file);
+        // Edits journaled after this save but never saved mean the app did not exit cleanly
+        std::vector<uint32_t> journalIds;
+        size_t recoveredEdits = 0;
+        if (!lazy) {
+            try {
+                recoveredEdits = JournalFile::replay(EditJournal::getJournalPath(projectPath), project, journalIds);
+            } catch (const std::exception& e) {
+                std::cerr << "Error reading edit journal: " << e.what() << std::endl;
             }
         }
-    } catch (const std::exception& e) {
-        auto languagePack = LanguageManager::getInstance().getSelectedPack();
-        Snackbar::getInstance().addMessage(languagePack["error_accessing_projects_folder"]);
-        std::cerr << "Error accessing projects folder: " << e.what() << std::endl;
+        if (recoveredEdits == 0) {
+            journalIds.resize(project.objects.size());
+            std::iota(journalIds.begin(), journalIds.end(), 0u);
+        }
+
+        std::vector<BoundingBox> bounds;
+        for (size_t i = 0; i < project.objects.size(); ++i) {
+            bounds.push_back(lazy ? GeometryPager::getBounds(sections[i]) : getLocalBounds(project.objects[i].vertices));
+        }
+        std::vector<size_t> order = nearestFirst(project, bounds);
+
+        // Nearest objects are read while they fit the memory budget; the rest start paged out
+        std::vector<bool> resident(project.objects.size(), !lazy);
+        if (lazy) {
+            size_t residentBytes = 0;
+            for (size_t index : order) {
+                size_t bytes = sections[index].vertexCount * sizeof(Vector3) +
+                               sections[index].faceCount * sizeof(std::array<int, 7>);
+                if (residentBytes + bytes <= GeometryPager::MEMORY_BUDGET) {
+                    residentBytes += bytes;
+                    resident[index] = true;
+                }
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(load->mutex);
+            load->binary = binary;
+            load->recovered = recoveredEdits > 0;
+            load->saveId = project.saveId;
+            load->camera = project.camera;
+            load->sections = sections;
+            load->journalIds = std::move(journalIds);
+            load->headerReady = true;
+        }
+
+        ThreadPool::getInstance().parallelFor(order.size(), [&](size_t k) {
+            if (load->cancelled) {
+                return;
+            }
+            size_t index = order[k];
+            ProjectObject& object = project.objects[index];
+            if (lazy && resident[index]) {
+                BinaryPrjFile::readGeometry(projectPath, sections[index], object.vertices, object.faces);
+            }
+            auto obj = createObject(std::move(object));
+            if (!resident[index]) {
+                obj->pageOut(bounds[index]);
+            }
+
+            std::lock_guard<std::mutex> lock(load->mutex);
+            load->ready.push_back({obj, order[k]});
+        });
+    });
+}
+
+bool ProjectsManager::isLoading() const {
+    return activeLoad != nullptr;
+}
+
+void ProjectsManager::cancelLoad() {
+    if (!activeLoad) {
+        return;
     }
 
-    return projects;
+    // The task keeps its own reference to the load state, so it is left to wind down on its own
+    activeLoad->cancelled = true;
+    activeLoad.reset();
+    loadTask = std::future<void>();
+    Snackbar::getInstance().clearProgress();
+
+    // Keep the journal, which may hold edits recovered from an earlier crash
+    EditJournal::getInstance().close();
+    sf::RenderWindow& window = WindowManager::getInstance().getWindow();
+    Scene::getInstance(window).resetObjects();
+    setSelectedProject("");
 }
 
-void ProjectsManager::setProject(std::string projectPath) {
+void ProjectsManager::updateLoad() {
+    if (!activeLoad) {
+        return;
+    }
+
+    // Checked before draining, so everything a finished load produced is taken this frame
+    bool finished = loadTask.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    std::vector<ProjectLoad::LoadedObject> arrived;
+    bool headerReady;
+    {
+        std::lock_guard<std::mutex> lock(activeLoad->mutex);
+        headerReady = activeLoad->headerReady;
+        arrived.swap(activeLoad->ready);
+    }
+
     sf::RenderWindow& window = WindowManager::getInstance().getWindow();
     Scene& scene = Scene::getInstance(window);
+    EditJournal& journal = EditJournal::getInstance();
+    if (headerReady && !loadHeaderApplied) {
+        loadHeaderApplied = true;
+        scene.setCameraPosition(activeLoad->camera.position);
+        scene.setCameraYawAndPitch(activeLoad->camera.yaw, activeLoad->camera.pitch);
+        scene.setOrbitCenter(activeLoad->camera.orbitCenter);
+        savedStateValid = activeLoad->binary;
+        journal.open(selectedProjectPath, activeLoad->saveId, activeLoad->journalIds, activeLoad->recovered);
+    }
 
-    setSelectedProject(projectPath);
-    PrjFile project;
-    project.read(selectedProjectPath);
-    auto projectData = project.projectData;
-    scene.setCameraPosition(Vector3({projectData["camera"]["position"][0], projectData["camera"]["position"][1], projectData["camera"]["position"][2]}));
-    scene.setCameraYawAndPitch(projectData["camera"]["yaw"], projectData["camera"]["pitch"]);
-    scene.setOrbitCenter(Vector3({projectData["camera"]["orbitCenter"][0], projectData["camera"]["orbitCenter"][1], projectData["camera"]["orbitCenter"][2]}));
-    scene.resetObjects();
-    for (auto object : projectData["objects"]) {
-        std::vector<Vector3> vertices;
-        for (const auto& vertex : object["vertices"]) {
-            vertices.push_back(Vector3(vertex[0], vertex[1], vertex[2]));
+    std::vector<std::shared_ptr<Object3d>> objects;
+    for (auto& loaded : arrived) {
+        // Recovered objects no longer match the file, so the next save rewrites it fully
+        if (!activeLoad->recovered && loaded.index < activeLoad->sections.size()) {
+            savedObjects[loaded.object.get()] = {loaded.object, loaded.object->getGeometryRevision(),
+                                                 activeLoad->sections[loaded.index]};
+            GeometryPager::getInstance().setSection(loaded.object, activeLoad->sections[loaded.index],
+                                                    loaded.object->getGeometryRevision());
         }
-        std::vector<std::array<int, 7>> faces;
-        for (const auto& face : object["faces"]) {
-            faces.push_back({face[0], face[1], face[2], face[3], face[4], face[5], face[6]});
+        journal.track(loaded.object, activeLoad->journalIds[loaded.index]);
+        objects.push_back(std::move(loaded.object));
+    }
+    scene.addObjects(objects);
+    loadedObjects += objects.size();
+
+    const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+    if (!finished) {
+        size_t total = headerReady ? activeLoad->journalIds.size() : 0;
+        float progress = total > 0 ? static_cast<float>(loadedObjects) / static_cast<float>(total) : 0.0f;
+        Snackbar::getInstance().setProgress(languagePack[TextKey::LoadingProject], progress);
+        return;
+    }
+
+    Snackbar::getInstance().clearProgress();
+    std::shared_ptr<ProjectLoad> load = std::move(activeLoad);
+    try {
+        loadTask.get();
+        if (load->recovered) {
+            Snackbar::getInstance().addMessage(languagePack[TextKey::RecoveredEdits]);
         }
-        CustomShape obj = CustomShape(vertices, faces);
-        obj.translate(Vector3({object["position"][0], object["position"][1], object["position"][2]}));
-        obj.setRotation(Vector3({object["rotation"][0], object["rotation"][1], object["rotation"][2]}));
-        obj.setScale(Vector3({static_cast<float>(object["scale"][0])  - 1.f, static_cast<float>(object["scale"][1]) - 1.f, static_cast<float>(object["scale"][2]) - 1.f}));
-        scene.addObject(std::make_shared<CustomShape>(obj));
+    } catch (const std::exception& e) {
+        std::cerr << "Error loading project: " << e.what() << std::endl;
+        Snackbar::getInstance().addMessage(
+            languagePack[TextKey::ErrorLoadingProject] + std::string(": ") + e.what()
+        );
+        journal.close();
+        scene.resetObjects();
+        setSelectedProject("");
     }
 }
 
+bool ProjectsManager::rejectWhileLoading() const {
+    if (!isLoading()) {
+        return false;
+    }
+    const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+    Snackbar::getInstance().addMessage(languagePack[TextKey::ProjectStillLoading]);
+    return true;
+}
+
+ProjectData ProjectsManager::readProject(const std::string& projectPath, std::vector<BinaryPrjSection>& sections) {
+    if (BinaryPrjFile::isBinary(projectPath)) {
+        return BinaryPrjFile::read(projectPath, &sections);
+    }
+    return PrjFile::load(projectPath);
+}
+
+std::shared_ptr<Object3d> ProjectsManager::createObject(ProjectObject&& object) {
+    auto obj = std::make_shared<CustomShape>(std::move(object.vertices), std::move(object.faces));
+    obj->translate(object.position);
+    obj->setRotation(object.rotation);
+    obj->setScale(object.scale - Vector3(1.f, 1.f, 1.f));
+    return obj;
+}
+
+ProjectCamera ProjectsManager::getSceneCamera(const Scene& scene) const {
+    ProjectCamera camera;
+    camera.position = scene.getCamera().getPosition();
+    camera.yaw = scene.getCamera().getYaw();
+    camera.pitch = scene.getCamera().getPitch();
+    camera.orbitCenter = scene.getCamera().getOrbitCenter();
+    return camera;
+}
+
 void ProjectsManager::createProject() {
     FileManager& fileManager = FileManager::getInstance();
     std::string projectPath = fileManager.saveAs();
-    PrjFile prjFile;
-    prjFile.write(projectPath);
+    BinaryPrjFile::write(projectPath, ProjectCamera{}, {});
+    std::error_code error;
+    fs::remove(EditJournal::getJournalPath(projectPath), error);
+    ProjectIndex::getInstance().invalidate(projectPath);
     setSelectedProject(projectPath);
     setProject(projectPath);
 }
 
 void ProjectsManager::updateProject(const Scene& scene) {
-    PrjFile prjFile;
-    prjFile.setCamera(
-        scene.getCamera().getPosition(),
-        scene.getCamera().getYaw(),
-        scene.getCamera().getPitch(),
-        scene.getCamera().getOrbitCenter()
-    );
-
-    int i = 0;
-    for (const auto& object : scene.getObjects()) {
-        if (i == 0) {
-            i++;
-            continue;
-        }
-        nlohmann::json objJson;
-        objJson["position"] = {object->getPosition().x, object->getPosition().y, object->getPosition().z};
-        objJson["rotation"] = {object->getRotation().x, object->getRotation().y, object->getRotation().z};
-        objJson["scale"] = {object->getScale().x, object->getScale().y, object->getScale().z};
-        for (const auto& vertex : object->getVerticesForJson()) {
-            objJson["vertices"].push_back({ vertex[0], vertex[1], vertex[2] });
-        }
-        for (const auto& face : object->getFaces()) {
-            objJson["faces"].push_back({ face[0], face[1], face[2], face[3], face[4], face[5], face[6] });
+    if (rejectWhileLoading()) {
+        return;
+    }
+    if (pendingSave.valid()) {
+        // Save again with a fresh snapshot once the running save finishes
+        saveQueued = true;
+        return;
+    }
+
+    // The journal starts a segment against this save before the scene is snapshotted for it
+    uint64_t saveId = generateSaveId();
+    EditJournal::getInstance().beginSave(saveId, scene.getObjects());
+
+    BinaryPrjFile::SectionReuse reuse;
+    ProjectData snapshot = snapshotScene(scene, reuse);
+    snapshot.saveId = saveId;
+    // Skip the grid plane
+    std::vector<std::shared_ptr<Object3d>> objects(scene.getObjects().begin() + 1, scene.getObjects().end());
+    // Only what the preview draws is captured here; the drawing runs on the pool like the save
+    auto thumbnailItems = ThumbnailRenderer::capture(objects, snapshot.camera, THUMBNAIL_FACE_BUDGET);
+    pendingThumbnail = ThreadPool::getInstance().submit(
+        [items = std::move(thumbnailItems), camera = snapshot.camera]() { return ThumbnailRenderer::render(items, camera); });
+    pendingSaveId = saveId;
+    bool incremental = savedStateValid &&
+        std::any_of(reuse.begin(), reuse.end(), [](const auto& section) { return section.has_value(); });
+
+    std::string projectPath = selectedProjectPath;
+    GeometryEncoding encoding{Config::getInstance().getCompressProjects(), Config::getInstance().getPositionBits()};
+    saveProgress = 0.0f;
+    // Sections may move while the save runs, so paging in waits for it
+    GeometryPager::getInstance().beginWrite([this]() { waitForPendingSave(); });
+    pendingSave = ThreadPool::getInstance().submit(
+        [this, snapshot = std::move(snapshot), reuse = std::move(reuse), projectPath, incremental, encoding]() {
+            auto onProgress = [this](float progress) { saveProgress = progress; };
+            return incremental ? BinaryPrjFile::update(projectPath, snapshot, reuse, onProgress, encoding)
+                               : BinaryPrjFile::write(projectPath, snapshot, onProgress, encoding);
+        });
+}
+
+void ProjectsManager::update() {
+    if (!selectedProjectPath.empty()) {
+        sf::RenderWindow& window = WindowManager::getInstance().getWindow();
+        EditJournal::getInstance().record(Scene::getInstance(window).getObjects());
+    }
+    updateLoad();
+
+    if (!pendingSave.valid()) {
+        return;
+    }
+
+    const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+    if (pendingSave.wait_for(std::chrono::seconds(0)) != std::future_status::ready ||
+        pendingThumbnail.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        Snackbar::getInstance().setProgress(languagePack[TextKey::SavingProject], saveProgress);
+        return;
+    }
+
+    Snackbar::getInstance().clearProgress();
+    GeometryPager& pager = GeometryPager::getInstance();
+    try {
+        std::vector<BinaryPrjSection> sections = pendingSave.get();
+        savedObjects.clear();
+        for (size_t i = 0; i < savingObjects.size(); ++i) {
+            if (auto object = savingObjects[i].object.lock()) {
+                savingObjects[i].section = sections[i];
+                savedObjects[object.get()] = savingObjects[i];
+                pager.setSection(object, sections[i], savingObjects[i].geometryRevision);
+            }
         }
+        pager.endWrite();
+        savedStateValid = true;
+        EditJournal::getInstance().finishSave(pendingSaveId);
+        ThumbnailCache::getInstance().store(selectedProjectPath, pendingThumbnail.get());
+        ProjectIndex::getInstance().invalidate(selectedProjectPath);
+        Snackbar::getInstance().addMessage(languagePack[TextKey::ProjectSaved]);
+    } catch (const std::exception& e) {
+        // The file may no longer match what was recorded, so the next save rewrites it fully
+        pager.endWrite();
+        resetSavedState();
+        pendingThumbnail = {};
+        std::cerr << "Error saving project: " << e.what() << std::endl;
+        Snackbar::getInstance().addMessage(
+            languagePack[TextKey::ErrorSavingProject] + std::string(": ") + e.what()
+        );
+    }
 
-        prjFile.addObject(objJson);
+    if (saveQueued) {
+        saveQueued = false;
+        sf::RenderWindow& window = WindowManager::getInstance().getWindow();
+        updateProject(Scene::getInstance(window));
     }
+}
 
-    prjFile.write(selectedProjectPath);
-    auto languagePack = LanguageManager::getInstance().getSelectedPack();
-    Snackbar::getInstance().addMessage(languagePack["project_saved"]);
+void ProjectsManager::waitForPendingSave() {
+    // update() may start a queued save, so keep waiting until none is left
+    while (pendingSave.valid()) {
+        pendingSave.wait();
+        pendingThumbnail.wait();
+        update();
+    }
+}
+
+void ProjectsManager::closeProject() {
+    cancelLoad();
+    waitForPendingSave();
+    EditJournal::getInstance().discard();
+    GeometryPager::getInstance().close();
+}
+
+ProjectData ProjectsManager::snapshotScene(const Scene& scene, BinaryPrjFile::SectionReuse& reuse) {
+    ProjectData project;
+    project.camera = getSceneCamera(scene);
+    savingObjects.clear();
+
+    // Skip the grid plane
+    const auto& objects = scene.getObjects();
+    for (size_t i = 1; i < objects.size(); ++i) {
+        const auto& sceneObject = objects[i];
+        ProjectObject& object = project.objects.emplace_back();
+        object.position = sceneObject->getPosition();
+        object.rotation = sceneObject->getRotation();
+        object.scale = sceneObject->getScale();
+
+        // Geometry unchanged since it was last written only needs its transform saved
+        auto saved = savedObjects.find(sceneObject.get());
+        if (saved != savedObjects.end() && !saved->second.object.expired() &&
+            saved->second.geometryRevision == sceneObject->getGeometryRevision()) {
+            reuse.push_back(saved->second.section);
+        } else {
+            if (sceneObject->isPagedOut()) {
+                GeometryPager::getInstance().require(sceneObject);
+            }
+            object.vertices = sceneObject->getVertices();
+            object.faces = sceneObject->getFaces();
+            reuse.push_back(std::nullopt);
+        }
+        savingObjects.push_back({sceneObject, sceneObject->getGeometryRevision(), {}});
+    }
+    return project;
+}
+
+void ProjectsManager::resetSavedState() {
+    savedObjects.clear();
+    savedStateValid = false;
 }
 
 void ProjectsManager::deleteProject(const std::string& filePath) {
+    waitForPendingSave();
+    if (filePath == selectedProjectPath) {
+        cancelLoad();
+        resetSavedState();
+        EditJournal::getInstance().discard();
+        GeometryPager::getInstance().close();
+    }
     if (!fs::exists(filePath)) {
-        auto languagePack = LanguageManager::getInstance().getSelectedPack();
-        Snackbar::getInstance().addMessage(languagePack["file_does_not_exist"]);
+        // Already gone, e.g. removed outside the app, so its row goes too
+        ProjectIndex::getInstance().remove(filePath);
+        const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+        Snackbar::getInstance().addMessage(languagePack[TextKey::FileDoesNotExist]);
         throw std::runtime_error("File does not exist: " + filePath);
     }
 
     fs::remove(filePath);
+    std::error_code error;
+    fs::remove(EditJournal::getJournalPath(filePath), error);
+    ThumbnailCache::getInstance().remove(filePath);
+    ProjectIndex::getInstance().remove(filePath);
 }
 
 void ProjectsManager::deleteCurrentProject() {
     if (selectedProjectPath.empty()) {
-        auto languagePack = LanguageManager::getInstance().getSelectedPack();
-        Snackbar::getInstance().addMessage(languagePack["no_project_selected"]);
+        const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+        Snackbar::getInstance().addMessage(languagePack[TextKey::NoProjectSelected]);
         throw std::runtime_error("No project is currently selected.");
     }
 
-    deleteProject(selectedProjectPath);
+    // deleteProject may deselect the project, so pass it a copy of the path
+    std::string projectPath = selectedProjectPath;
+    deleteProject(projectPath);
+
+    const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+    Snackbar::getInstance().addMessage(languagePack[TextKey::ProjectDeleted]);
+}
+
+bool ProjectsManager::exportAsJson() {
+    if (rejectWhileLoading()) {
+        return false;
+    }
+    if (selectedProjectPath.empty()) {
+        const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+        Snackbar::getInstance().addMessage(languagePack[TextKey::NoProjectSelected]);
+        return false;
+    }
+
+    try {
+        std::string jsonPath = FileManager::getInstance().getExportPath(L"JSON Project Files (*.json)", L"json", L"Export as JSON");
+        if (jsonPath.empty()) {
+            return false;
+        }
+
+        sf::RenderWindow& window = WindowManager::getInstance().getWindow();
+        Scene& scene = Scene::getInstance(window);
+        ProjectCamera camera = getSceneCamera(scene);
+        GeometryPager::getInstance().requireAll(scene.getObjects());
 
-    auto languagePack = LanguageManager::getInstance().getSelectedPack();
-    Snackbar::getInstance().addMessage(languagePack["project_deleted"]);
+        PrjFile prjFile;
+        prjFile.setCamera(camera.position, camera.yaw, camera.pitch, camera.orbitCenter);
+        for (size_t i = 1; i < scene.getObjects().size(); ++i) {
+            prjFile.addObject(*scene.getObjects()[i]);
+        }
+        prjFile.write(jsonPath);
+        return true;
+    } catch (const std::exception& e) {
+        const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+        Snackbar::getInstance().addMessage(
+            languagePack[TextKey::ErrorExporting] + std::string(": ") + e.what()
+        );
+        return false;
+    }
 }
 
 std::string ProjectsManager::getProjectFilePath(const std::string& projectName) const {
@@ -143,6 +528,12 @@ std::string ProjectsManager::getProjectFilePath(const std::string& projectName)
 
 void ProjectsManager::setSelectedProject(const std::string& projectPath) {
     selectedProjectPath = projectPath;
+    resetSavedState();
+    if (projectPath.empty()) {
+        GeometryPager::getInstance().close();
+    } else {
+        GeometryPager::getInstance().open(projectPath);
+    }
 }
 
 nlohmann::json ProjectsManager::sceneToJson(const Scene& scene) {
@@ -170,91 +561,64 @@ nlohmann::json ProjectsManager::sceneToJson(const Scene& scene) {
     return json;
 }
 
-bool ProjectsManager::exportAsObj() {
+bool ProjectsManager::exportScene(const std::function<std::string()>& choosePath, const SceneExporter& exporter) {
+    if (rejectWhileLoading()) {
+        return false;
+    }
     if (selectedProjectPath.empty()) {
-        auto languagePack = LanguageManager::getInstance().getSelectedPack();
-        Snackbar::getInstance().addMessage(languagePack["no_project_selected"]);
+        const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+        Snackbar::getInstance().addMessage(languagePack[TextKey::NoProjectSelected]);
         return false;
     }
 
     try {
-        PrjFile prjFile;
-        prjFile.read(selectedProjectPath);
         sf::RenderWindow& window = WindowManager::getInstance().getWindow();
         Scene& scene = Scene::getInstance(window);
-        auto [vertices, faces] = prepareObjData(scene);
+        // Skip the grid plane
+        std::vector<std::shared_ptr<Object3d>> objects(scene.getObjects().begin() + 1, scene.getObjects().end());
+        GeometryPager::getInstance().requireAll(objects);
 
-        std::string objPath = FileManager::getInstance().getExportObjPath();
-        if (objPath.empty()) {
+        std::string path = choosePath();
+        if (path.empty()) {
             return false;
         }
 
-        if (FileManager::getInstance().exportToObj(objPath, vertices, faces, prjFile.projectData)) {
+        if (exporter(path, objects)) {
             return true;
         } else {
-            auto languagePack = LanguageManager::getInstance().getSelectedPack();
-            Snackbar::getInstance().addMessage(languagePack["error_exporting"]);
+            const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+            Snackbar::getInstance().addMessage(languagePack[TextKey::ErrorExporting]);
             return false;
         }
     } catch (const std::exception& e) {
-        auto languagePack = LanguageManager::getInstance().getSelectedPack();
+        const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
         Snackbar::getInstance().addMessage(
-            static_cast<std::string>(languagePack["error_exporting"]) + std::string(": ") + e.what()
+            languagePack[TextKey::ErrorExporting] + std::string(": ") + e.what()
         );
         return false;
     }
 }
 
-std::pair<std::vector<std::string>, std::vector<std::string>>
-ProjectsManager::prepareObjData(const Scene& scene) {
-    std::vector<std::string> vertices;
-    std::vector<std::string> faces;
-    int vertexOffset = 1;  // OBJ indices start at 1
-    int materialCounter = 1;  // Counter for material names
-
-    int i = 0;
-    for (const auto& object : scene.getObjects()) {
-        if (i == 0) {
-            i++;
-            continue;
-        }
-        const auto& objVertices = object->getVerticesForJson();
-        const auto& position = object->getPosition();
-        const auto& scale = object->getScale();
-
-        std::ostringstream materialNameStream;
-        materialNameStream << "material_" << materialCounter++;
-        std::string materialName = materialNameStream.str();
-
-        // Add vertices
-        for (const auto& vertex : objVertices) {
-            // Transform vertex (you might want to add proper rotation)
-            float x = vertex[0] * (scale.x) + position.x;
-            float y = vertex[1] * (scale.y) + position.y;
-            float z = vertex[2] * (scale.z) + position.z;
-
-            std::ostringstream vertexStr;
-            vertexStr << "v " << x << " " << y << " " << z;
-            vertices.push_back(vertexStr.str());
-        }
-
-        // Add material assignment before faces
-        faces.push_back("usemtl " + materialName);
-
-        // Add faces
-        const auto& objFaces = object->getFaces();
-        for (const auto& face : objFaces) {
-            std::ostringstream faceStr;
-            faceStr << "f";
-            // Only use the first 3 indices for triangular faces
-            for (int i = 0; i < 3; ++i) {
-                faceStr << " " << (face[i] + vertexOffset);
-            }
-            faces.push_back(faceStr.str());
-        }
+bool ProjectsManager::exportAsObj() {
+    FileManager& fileManager = FileManager::getInstance();
+    return exportScene([&fileManager]() { return fileManager.getExportObjPath(); },
+                       [&fileManager](const std::string& path, const std::vector<std::shared_ptr<Object3d>>& objects) {
+                           return fileManager.exportToObj(path, objects);
+                       });
+}
 
-        vertexOffset += objVertices.size();
-    }
+bool ProjectsManager::exportAsStl() {
+    FileManager& fileManager = FileManager::getInstance();
+    return exportScene([&fileManager]() { return fileManager.getExportStlPath(); },
+                       [&fileManager](const std::string& path, const std::vector<std::shared_ptr<Object3d>>& objects) {
+                           return fileManager.exportToStl(path, objects);
+                       });
+}
 
-    return {vertices, faces};
+bool ProjectsManager::exportAsGlb() {
+    FileManager& fileManager = FileManager::getInstance();
+    return exportScene([&fileManager]() { return fileManager.getExportGlbPath(); },
+                       [&fileManager](const std::string& path, const std::vector<std::shared_ptr<Object3d>>& objects) {
+                           return fileManager.exportToGlb(path, objects);
+                       });
 }
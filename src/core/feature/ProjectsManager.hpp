@@ -1,25 +1,54 @@
 #ifndef PROJECT_MANAGER_HPP
 #define PROJECT_MANAGER_HPP
 
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "../../utils/files/Config.hpp"
+#include "../../utils/files/BinaryPrjFile.hpp"
 #include "../../utils/files/FileManager.hpp"
 #include "../../utils/files/PrjFile.hpp"
+#include "../../utils/files/ProjectData.hpp"
+#include "ProjectIndex.hpp"
 #include "Scene.hpp"
 
 class ProjectsManager {
 public:
     static ProjectsManager& getInstance();
 
-    std::vector<FileInfo> getProjects();
+    // Projects in the projects folder, newest first, as far as the index has read them
+    const std::vector<ProjectIndexEntry>& getProjects();
+    // Loads the project on the thread pool; update() streams its objects into the scene, nearest
+    // to the camera first
     void setProject(std::string projectPath);
+    bool isLoading() const;
+    // Stops a running load, leaving an empty scene and no project selected
+    void cancelLoad();
     void createProject();
+    // Snapshots the scene and writes it on the thread pool; progress is shown by update()
     void updateProject(const Scene& scene);
+    // Called every frame to report the state of background loads and saves
+    void update();
+    void waitForPendingSave();
+    // Finishes any save and drops the edit journal, as unsaved edits are discarded on a clean exit
+    void closeProject();
     void deleteProject(const std::string& filePath);
     void deleteCurrentProject();
     std::string getProjectFilePath(const std::string& projectName) const;
     bool exportAsObj();
+    bool exportAsStl();
+    bool exportAsGlb();
+    bool exportAsJson();
+
+    // Reads a binary or JSON project in full, with no window needed
+    static ProjectData readProject(const std::string& projectPath, std::vector<BinaryPrjSection>& sections);
+    // Builds a scene object from a project object, taking its geometry
+    static std::shared_ptr<Object3d> createObject(ProjectObject&& object);
 
 private:
     ProjectsManager() = default;
@@ -28,9 +57,56 @@ private:
 
     void setSelectedProject(const std::string& projectPath);
     nlohmann::json sceneToJson(const Scene& scene);
-    std::pair<std::vector<std::string>, std::vector<std::string>> prepareObjData(const Scene& scene);
+    ProjectCamera getSceneCamera(const Scene& scene) const;
+    ProjectData snapshotScene(const Scene& scene, BinaryPrjFile::SectionReuse& reuse);
+    void resetSavedState();
+    void updateLoad();
+    bool rejectWhileLoading() const;
+    using SceneExporter = std::function<bool(const std::string&, const std::vector<std::shared_ptr<Object3d>>&)>;
+    // Exports every object but the grid plane to the path choosePath returns
+    bool exportScene(const std::function<std::string()>& choosePath, const SceneExporter& exporter);
+
+    // State shared between a load running on the pool and the frames consuming its objects
+    struct ProjectLoad {
+        struct LoadedObject {
+            std::shared_ptr<Object3d> object;
+            size_t index;
+        };
+
+        std::atomic<bool> cancelled{false};
+        std::mutex mutex;
+        // Set once the file is read; the fields below it are then only read by the main thread
+        bool headerReady = false;
+        bool binary = false;
+        bool recovered = false;
+        uint64_t saveId = 0;
+        ProjectCamera camera;
+        std::vector<BinaryPrjSection> sections;
+        std::vector<uint32_t> journalIds;
+        std::vector<LoadedObject> ready;
+    };
+
+    // An object's geometry as last written to the selected project file
+    struct SavedObject {
+        std::weak_ptr<Object3d> object;
+        uint64_t geometryRevision = 0;
+        BinaryPrjSection section;
+    };
 
     std::string selectedProjectPath;
+    std::shared_ptr<ProjectLoad> activeLoad;
+    std::future<void> loadTask;
+    bool loadHeaderApplied = false;
+    size_t loadedObjects = 0;
+    std::unordered_map<const Object3d*, SavedObject> savedObjects;
+    std::vector<SavedObject> savingObjects;
+    bool savedStateValid = false;
+    std::future<std::vector<BinaryPrjSection>> pendingSave;
+    uint64_t pendingSaveId = 0;
+    // Preview of the scene being saved, drawn on the pool and cached once the save lands
+    std::future<sf::Image> pendingThumbnail;
+    std::atomic<float> saveProgress{0.0f};
+    bool saveQueued = false;
 };
 
 
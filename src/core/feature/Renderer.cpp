@@ -2,10 +2,27 @@
 #include <algorithm>
 #include "Scene.hpp"
 #include "../../utils/WindowManager.hpp"
+#include "../../utils/FontManager.hpp"
+#include <cmath>
+#include <limits>
+#include <sstream>
 
 constexpr float NEAR_PLANE = 0.1f;
 constexpr float FAR_PLANE = 100.0f;
 
+// Projected bounding-sphere radius (pixels) below which level i + 1 is used
+constexpr float LOD_PIXEL_THRESHOLDS[] = {240.0f, 120.0f, 60.0f};
+constexpr float LOD_HYSTERESIS = 0.15f;
+
+// Occluders are the largest simple objects on screen; dense meshes cost more to rasterize than they save
+constexpr size_t MAX_OCCLUDERS = 8;
+constexpr size_t MAX_OCCLUDER_FACES = 4096;
+constexpr float MIN_OCCLUDER_PIXEL_RADIUS = 48.0f;
+
+static float maxScaleComponent(const Vector3& scale) {
+    return std::max({std::abs(scale.x), std::abs(scale.y), std::abs(scale.z)});
+}
+
 Renderer::Renderer(sf::RenderWindow& window)
     : window(window), frustum() {}
 
@@ -75,11 +92,31 @@ sf::Vector2f Renderer::screenPosition(const Vector3& vertex) const {
     };
 }
 
+const RenderStats& Renderer::getStats() const {
+    return stats;
+}
+
+void Renderer::toggleStatsOverlay() {
+    showStats = !showStats;
+}
+
+void Renderer::toggleHiZOverlay() {
+    showHiZ = !showHiZ;
+}
+
 void Renderer::render(const std::vector<std::shared_ptr<Object3d>>& objects, Camera& camera) {
     std::vector<FaceData> facesToRender;
+    stats = RenderStats();
+
+    Scene& scene = Scene::getInstance(WindowManager::getInstance().getWindow());
+    bool fullResolutionOnly = scene.getFacesEditMode() || scene.getVerticesEditMode();
+
+    // Faces are drawn translucent in vertices edit mode, so nothing can hide anything
+    occlusionActive = !scene.getVerticesEditMode();
+    buildOcclusionBuffer(objects, camera);
 
     for (const auto& object : objects) {
-        processObject(object, camera, facesToRender);
+        processObject(object, camera, facesToRender, fullResolutionOnly);
     }
 
     // Improved sorting algorithm considering camera direction
@@ -118,10 +155,121 @@ void Renderer::render(const std::vector<std::shared_ptr<Object3d>>& objects, Cam
 
     renderFaces(facesToRender);
     renderEdges(objects, camera);
+    if (showStats) {
+        renderStats();
+    }
+    if (showHiZ) {
+        renderHiZOverlay();
+    }
+}
+
+void Renderer::buildOcclusionBuffer(const std::vector<std::shared_ptr<Object3d>>& objects, Camera& camera) {
+    occluders.clear();
+    occludedObjects.clear();
+    hiZBuffer.resize(window.getSize().x, window.getSize().y);
+    hiZBuffer.clear();
+    if (!occlusionActive) return;
+
+    Matrix4 viewMatrix = camera.getViewMatrix();
+    Matrix4 projectionMatrix = camera.getProjectionMatrix();
+    float pixelsPerUnit = projectionMatrix(1, 1) * window.getSize().y * 0.5f;
+
+    std::vector<std::pair<float, Object3d*>> candidates;
+    // The first object is always the grid plane, which is made of thin lines and occludes nothing
+    for (size_t i = 1; i < objects.size(); ++i) {
+        Object3d& object = *objects[i];
+        if (object.isPagedOut() || object.getFaces().size() > MAX_OCCLUDER_FACES) continue;
+
+        const BoundingSphere& sphere = object.getLocalBoundingSphere();
+        Vector4 center = viewMatrix * (object.getTransformation() * Vector4(sphere.center, 1.0f));
+        float radius = sphere.radius * maxScaleComponent(object.getScale());
+        if (center.z + radius <= NEAR_PLANE) continue;
+
+        float pixelRadius = radius * pixelsPerUnit / std::max(center.z, NEAR_PLANE);
+        if (pixelRadius < MIN_OCCLUDER_PIXEL_RADIUS) continue;
+        candidates.emplace_back(pixelRadius, &object);
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+        return a.first > b.first;
+    });
+    if (candidates.size() > MAX_OCCLUDERS) {
+        candidates.resize(MAX_OCCLUDERS);
+    }
+
+    for (const auto& [score, object] : candidates) {
+        std::vector<Vector3> cameraSpaceVertices = transformVertices(object->getVertices(), object->getTransformation(), viewMatrix);
+        std::vector<Vector3> projectedVertices = projectVertices(cameraSpaceVertices, projectionMatrix);
+
+        for (const auto& face : object->getFaces()) {
+            if (face[6] < 255) continue;
+
+            const Vector3& c1 = cameraSpaceVertices[face[0]];
+            const Vector3& c2 = cameraSpaceVertices[face[1]];
+            const Vector3& c3 = cameraSpaceVertices[face[2]];
+            if (c1.z < NEAR_PLANE || c2.z < NEAR_PLANE || c3.z < NEAR_PLANE) continue;
+
+            sf::Vector2f p1 = screenPosition(projectedVertices[face[0]]);
+            sf::Vector2f p2 = screenPosition(projectedVertices[face[1]]);
+            sf::Vector2f p3 = screenPosition(projectedVertices[face[2]]);
+            hiZBuffer.rasterizeTriangle(p1.x, p1.y, c1.z, p2.x, p2.y, c2.z, p3.x, p3.y, c3.z);
+        }
+        occluders.insert(object);
+    }
+
+    hiZBuffer.buildPyramid();
+    stats.occluders = static_cast<int>(occluders.size());
+}
+
+bool Renderer::isSphereOccluded(const Vector3& viewCenter, float radius, const Matrix4& projectionMatrix) const {
+    float nearestDepth = viewCenter.z - radius;
+    if (nearestDepth <= NEAR_PLANE) return false;
+
+    // Screen rectangle of the sphere's bounding cube, which contains the sphere's projection
+    float minX = std::numeric_limits<float>::max(), minY = std::numeric_limits<float>::max();
+    float maxX = std::numeric_limits<float>::lowest(), maxY = std::numeric_limits<float>::lowest();
+    for (int corner = 0; corner < 8; ++corner) {
+        Vector3 point(
+            viewCenter.x + ((corner & 1) ? radius : -radius),
+            viewCenter.y + ((corner & 2) ? radius : -radius),
+            viewCenter.z + ((corner & 4) ? radius : -radius)
+        );
+        Vector4 projected = projectionMatrix * Vector4(point, 1.0f);
+        if (projected.w != 0.0f) {
+            projected.x /= projected.w;
+            projected.y /= projected.w;
+        }
+        sf::Vector2f screen = screenPosition(Vector3(projected.x, projected.y, 0.0f));
+        minX = std::min(minX, screen.x);
+        minY = std::min(minY, screen.y);
+        maxX = std::max(maxX, screen.x);
+        maxY = std::max(maxY, screen.y);
+    }
+
+    return hiZBuffer.isRectOccluded(minX, minY, maxX, maxY, nearestDepth);
+}
+
+int Renderer::selectLodLevel(Object3d& object, const Vector3& viewCenter, float radius, const Matrix4& projectionMatrix) const {
+    int levelCount = object.getLodLevelCount();
+    if (levelCount <= 1) return 0;
+    if (viewCenter.z <= NEAR_PLANE) return 0;
+
+    float pixelRadius = radius * projectionMatrix(1, 1) / viewCenter.z * window.getSize().y * 0.5f;
+
+    int level = std::min(object.activeLodLevel, levelCount - 1);
+    while (level + 1 < levelCount && pixelRadius < LOD_PIXEL_THRESHOLDS[level] * (1.0f - LOD_HYSTERESIS)) {
+        level++;
+    }
+    while (level > 0 && pixelRadius > LOD_PIXEL_THRESHOLDS[level - 1] * (1.0f + LOD_HYSTERESIS)) {
+        level--;
+    }
+    return level;
 }
 
-void Renderer::processObject(const std::shared_ptr<Object3d>& object, Camera& camera, std::vector<FaceData>& facesToRender) {
-    Matrix4 modelMatrix = object->getTransformation();
+void Renderer::processObject(const std::shared_ptr<Object3d>& object, Camera& camera, std::vector<FaceData>& facesToRender, bool fullResolutionOnly) {
+    if (object->isPagedOut()) return;
+
+    const Matrix4& modelMatrix = object->getTransformation();
     Matrix4 viewMatrix = camera.getViewMatrix();
     Matrix4 projectionMatrix = camera.getProjectionMatrix();
 
@@ -131,13 +279,41 @@ void Renderer::processObject(const std::shared_ptr<Object3d>& object, Camera& ca
 
     if (cameraPosition.z < 0.0f) return;
 
-    std::vector<Vector3> cameraSpaceVertices = transformVertices(object->getVertices(), modelMatrix, viewMatrix);
+    const BoundingSphere& sphere = object->getLocalBoundingSphere();
+    Vector4 sphereCenter = viewMatrix * (modelMatrix * Vector4(sphere.center, 1.0f));
+    Vector3 viewCenter(sphereCenter.x, sphereCenter.y, sphereCenter.z);
+    float sphereRadius = sphere.radius * maxScaleComponent(object->getScale());
+
+    if (occlusionActive && occluders.count(object.get()) == 0 &&
+        isSphereOccluded(viewCenter, sphereRadius, projectionMatrix)) {
+        occludedObjects.insert(object.get());
+        stats.occludedObjects++;
+        stats.occludedFaces += static_cast<int>(object->getFaces().size());
+        return;
+    }
+
+    int level = fullResolutionOnly ? 0 : selectLodLevel(*object, viewCenter, sphereRadius, projectionMatrix);
+    object->activeLodLevel = level;
+
+    const std::vector<Vector3>* vertices = &object->getVertices();
+    const std::vector<std::array<int, 7>>* faces = &object->getFaces();
+    if (const LodLevel* lod = object->getLodLevel(level)) {
+        vertices = &lod->vertices;
+        faces = &lod->faces;
+    }
+    bool fullResolution = level == 0;
+
+    std::vector<Vector3> cameraSpaceVertices = transformVertices(*vertices, modelMatrix, viewMatrix);
 
     if (!isObjectInFrustum(cameraSpaceVertices)) return;
 
+    stats.objectsDrawn++;
+    stats.fullResolutionFaces += static_cast<int>(object->getFaces().size());
+    stats.objectsPerLodLevel[std::min<size_t>(level, stats.objectsPerLodLevel.size() - 1)]++;
+
     std::vector<Vector3> projectedVertices = projectVertices(cameraSpaceVertices, projectionMatrix);
     int i = 0;
-    for (const auto& triangle : object->getFaces()) {
+    for (const auto& triangle : *faces) {
         float zAvg = (
             cameraSpaceVertices[triangle[0]].z +
             cameraSpaceVertices[triangle[1]].z +
@@ -159,9 +335,10 @@ void Renderer::processObject(const std::shared_ptr<Object3d>& object, Camera& ca
             sf::Color(triangle[3], triangle[4], triangle[5], triangle[6]),
             zAvg,
             object,
-            object->isFaceSelected(i),
-            object->isFaceHovered(i)
+            fullResolution && object->isFaceSelected(i),
+            fullResolution && object->isFaceHovered(i)
         });
+        stats.facesSubmitted++;
         i++;
     }
 }
@@ -223,19 +400,30 @@ void Renderer::renderEdges(const std::vector<std::shared_ptr<Object3d>>& objects
     Scene& scene = Scene::getInstance(window);
 
     for (const auto& object : objects) {
+        if (object->isPagedOut()) {
+            renderProxy(*object, camera);
+            continue;
+        }
+        if (occludedObjects.count(object.get()) > 0) continue;
 
-        Matrix4 modelMatrix = object->getTransformation();
+        const Matrix4& modelMatrix = object->getTransformation();
         Matrix4 viewMatrix = camera.getViewMatrix();
         Matrix4 projectionMatrix = camera.getProjectionMatrix();
 
-        std::vector<Vector3> transformedVertices = transformVertices(object->getVertices(), modelMatrix, viewMatrix);
+        const std::vector<Vector3>* vertices = &object->getVertices();
+        const std::vector<std::pair<int, int>>* edges = &object->getEdges();
+        if (const LodLevel* lod = object->getLodLevel(object->activeLodLevel)) {
+            vertices = &lod->vertices;
+            edges = &lod->edges;
+        }
+
+        std::vector<Vector3> transformedVertices = transformVertices(*vertices, modelMatrix, viewMatrix);
 
         if (!isObjectInFrustum(transformedVertices)) continue;
 
         std::vector<Vector3> projectedVertices = projectVertices(transformedVertices, projectionMatrix);
 
-        auto edges = object->getEdges();
-        for (const auto& edge : edges) {
+        for (const auto& edge : *edges) {
             int idx1 = edge.first;
             int idx2 = edge.second;
 
@@ -292,4 +480,91 @@ void Renderer::renderEdges(const std::vector<std::shared_ptr<Object3d>>& objects
             window.draw(edgeVertices, 2, sf::Lines);
         }
     }
+}
+
+// Paged out objects are drawn as the box of their bounds until their geometry is read in
+void Renderer::renderProxy(const Object3d& object, Camera& camera) {
+    const BoundingBox& bounds = object.getPagedOutBounds();
+    std::vector<Vector3> corners;
+    for (int corner = 0; corner < 8; ++corner) {
+        corners.emplace_back(
+            (corner & 1) ? bounds.max.x : bounds.min.x,
+            (corner & 2) ? bounds.max.y : bounds.min.y,
+            (corner & 4) ? bounds.max.z : bounds.min.z
+        );
+    }
+    std::vector<Vector3> projectedCorners = projectVertices(
+        transformVertices(corners, object.getTransformation(), camera.getViewMatrix()),
+        camera.getProjectionMatrix()
+    );
+
+    sf::Color color = object.isSelected ? sf::Color(255, 255, 100, 160) : sf::Color(150, 150, 150, 160);
+    bool drawn = false;
+    for (int a = 0; a < 8; ++a) {
+        for (int axis = 1; axis < 8; axis <<= 1) {
+            if (a & axis) continue;
+            const Vector3& v1 = projectedCorners[a];
+            const Vector3& v2 = projectedCorners[a | axis];
+            if (v1.z < NEAR_PLANE || v2.z < NEAR_PLANE || v1.z > FAR_PLANE || v2.z > FAR_PLANE) continue;
+            if (v1.x < -1.0f || v1.x > 1.0f || v1.y < -1.0f || v1.y > 1.0f ||
+                v2.x < -1.0f || v2.x > 1.0f || v2.y < -1.0f || v2.y > 1.0f) continue;
+
+            sf::Vertex edgeVertices[] = {
+                sf::Vertex(screenPosition(v1), color),
+                sf::Vertex(screenPosition(v2), color)
+            };
+            window.draw(edgeVertices, 2, sf::Lines);
+            drawn = true;
+        }
+    }
+    if (drawn) {
+        stats.proxies++;
+    }
+}
+
+void Renderer::renderStats() {
+    std::ostringstream text;
+    text << "Objects: " << stats.objectsDrawn << "\n"
+         << "Faces: " << stats.facesSubmitted << " / " << stats.fullResolutionFaces << "\n"
+         << "LOD:";
+    for (size_t level = 0; level < stats.objectsPerLodLevel.size(); level++) {
+        text << " " << level << "=" << stats.objectsPerLodLevel[level];
+    }
+    text << "\n"
+         << "Occluders: " << stats.occluders << "\n"
+         << "Occluded: " << stats.occludedObjects << " objects, " << stats.occludedFaces << " faces\n"
+         << "Proxies: " << stats.proxies;
+
+    sf::Text overlay(text.str(), FontManager::getInstance().getFont(), 14);
+    overlay.setFillColor(sf::Color(255, 255, 255, 220));
+    overlay.setPosition(10.0f, 10.0f);
+    window.draw(overlay);
+}
+
+void Renderer::renderHiZOverlay() {
+    unsigned int width = hiZBuffer.getWidth();
+    unsigned int height = hiZBuffer.getHeight();
+    if (width == 0 || height == 0) return;
+
+    const std::vector<float>& depths = hiZBuffer.getDepths();
+    std::vector<sf::Uint8> pixels(static_cast<size_t>(width) * height * 4);
+    for (size_t i = 0; i < depths.size(); ++i) {
+        // Near occluders are bright, uncovered texels transparent
+        bool covered = std::isfinite(depths[i]);
+        float brightness = covered ? 1.0f - std::min(depths[i] / FAR_PLANE, 1.0f) : 0.0f;
+        sf::Uint8 value = static_cast<sf::Uint8>(55 + 200 * brightness);
+        pixels[i * 4] = value;
+        pixels[i * 4 + 1] = value;
+        pixels[i * 4 + 2] = value;
+        pixels[i * 4 + 3] = covered ? 220 : 80;
+    }
+
+    if (hiZTexture.getSize() != sf::Vector2u(width, height)) {
+        hiZTexture.create(width, height);
+    }
+    hiZTexture.update(pixels.data());
+
+    sf::Sprite sprite(hiZTexture);
+    sprite.setPosition(10.0f, static_cast<float>(window.getSize().y - height - 10));
+    window.draw(sprite);
 }
\ No newline at end of file
@@ -3,11 +3,14 @@
 
 #include <SFML/Graphics.hpp>
 #include "Camera.hpp"
-#include "../objects/Object3D.hpp"
+#include "../objects/Object3d.hpp"
 #include "../../utils/math/Matrix4.hpp"
 #include "../../utils/math/Vector3.hpp"
 #include "../../utils/Frustum.hpp"
+#include "../../utils/HiZBuffer.hpp"
+#include <array>
 #include <memory>
+#include <unordered_set>
 #include <vector>
 
 struct FaceData {
@@ -19,6 +22,17 @@ struct FaceData {
     bool isHovered;
 };
 
+struct RenderStats {
+    int objectsDrawn = 0;
+    int facesSubmitted = 0;
+    int fullResolutionFaces = 0;
+    std::array<int, 4> objectsPerLodLevel{};
+    int occluders = 0;
+    int occludedObjects = 0;
+    int occludedFaces = 0;
+    int proxies = 0;
+};
+
 class Renderer {
 public:
     explicit Renderer(sf::RenderWindow& window);
@@ -31,18 +45,39 @@ public:
     std::vector<Vector3> transformVertices(const std::vector<Vector3>& vertices, const Matrix4& modelMatrix, const Matrix4& viewMatrix) const;
     std::vector<Vector3> projectVertices(const std::vector<Vector3>& vertices, const Matrix4& projectionMatrix) const;
     sf::Vector2f screenPosition(const Vector3& vertex) const;
+
+    const RenderStats& getStats() const;
+    void toggleStatsOverlay();
+    void toggleHiZOverlay();
 protected:
     sf::RenderWindow& window;
     Frustum frustum;
 
 private:
+    RenderStats stats;
+    bool showStats = false;
+
+    HiZBuffer hiZBuffer;
+    bool occlusionActive = false;
+    bool showHiZ = false;
+    std::unordered_set<const Object3d*> occluders;
+    std::unordered_set<const Object3d*> occludedObjects;
+    sf::Texture hiZTexture;
+
     void renderFaces(const std::vector<FaceData>& facesToRender);
     void renderEdges(const std::vector<std::shared_ptr<Object3d>>& objects, Camera& camera);
+    void renderProxy(const Object3d& object, Camera& camera);
 
     bool isFaceCulled(const Vector3& v1, const Vector3& v2, const Vector3& v3, const Matrix4& viewMatrix) const;
     bool isObjectInFrustum(const std::vector<Vector3>& vertices) const;
 
-    void processObject(const std::shared_ptr<Object3d>& object, Camera& camera, std::vector<FaceData>& facesToRender);
+    void processObject(const std::shared_ptr<Object3d>& object, Camera& camera, std::vector<FaceData>& facesToRender, bool fullResolutionOnly);
+    int selectLodLevel(Object3d& object, const Vector3& viewCenter, float radius, const Matrix4& projectionMatrix) const;
+    void renderStats();
+
+    void buildOcclusionBuffer(const std::vector<std::shared_ptr<Object3d>>& objects, Camera& camera);
+    bool isSphereOccluded(const Vector3& viewCenter, float radius, const Matrix4& projectionMatrix) const;
+    void renderHiZOverlay();
 };
 
 #endif
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include "Scene.hpp"
+#include <algorithm>
 #include <memory>
 #include "../objects/ObjectsFactory.hpp"
+#include "GeometryPager.hpp"
+#include "LodManager.hpp"
 
 
 Scene::Scene(sf::RenderWindow &window)
@@ -19,8 +22,32 @@ Scene& Scene::getInstance(sf::RenderWindow& window) {
     return instance;
 }
 
+int Scene::addListener(Listener listener) {
+    listeners.emplace_back(nextListenerId, std::move(listener));
+    return nextListenerId++;
+}
+
+void Scene::removeListener(int id) {
+    listeners.erase(std::remove_if(listeners.begin(), listeners.end(), [id](const auto& entry) {
+        return entry.first == id;
+    }), listeners.end());
+}
+
+void Scene::notify(const SceneChange& change) {
+    // A listener may add or remove listeners
+    auto current = listeners;
+    for (const auto& entry : current) {
+        entry.second(change);
+    }
+}
+
+void Scene::notifyTopologyChanged(int objectIndex) {
+    notify({SceneChange::Type::TopologyChanged, objectIndex});
+}
+
 void Scene::addObject(std::shared_ptr<Object3d> object) {
     objects.push_back(object);
+    notify({SceneChange::Type::ObjectAdded, static_cast<int>(objects.size()) - 1});
     if (!getObjectsEditMode()) {
         for (int i = 0; i < objects.size(); i++) {
             objects[i]->isSelected = false;
@@ -33,7 +60,15 @@ void Scene::addObject(std::shared_ptr<Object3d> object) {
     toggleObjectSelected(objects.size() - 1);
 }
 
-void Scene::createCombination() {
+void Scene::addObjects(const std::vector<std::shared_ptr<Object3d>>& newObjects) {
+    if (newObjects.empty()) {
+        return;
+    }
+    objects.insert(objects.end(), newObjects.begin(), newObjects.end());
+    notify({SceneChange::Type::ObjectsReset});
+}
+
+void Scene::createCombination(BooleanOperation operation) {
     if (selectedObjects.size() < 2) {
         return;
     }
@@ -43,7 +78,7 @@ void Scene::createCombination() {
         selectedObjectsVector.push_back(objects[index]);
     }
 
-    std::shared_ptr<Object3d> result = ObjectsFactory::combineObjects(selectedObjectsVector);
+    std::shared_ptr<Object3d> result = ObjectsFactory::combineObjects(selectedObjectsVector, operation);
 
     std::vector<unsigned int> indicesToDelete = selectedObjects;
     std::sort(indicesToDelete.begin(), indicesToDelete.end(), std::greater<unsigned int>());
@@ -59,6 +94,24 @@ void Scene::createCombination() {
     addObject(result);
 }
 
+void Scene::translateSelected(const Vector3& translation) {
+    for (unsigned int index : selectedObjects) {
+        objects[index]->translate(translation);
+    }
+}
+
+void Scene::scaleSelected(const Vector3& scaleDelta) {
+    for (unsigned int index : selectedObjects) {
+        objects[index]->setScale(scaleDelta);
+    }
+}
+
+void Scene::rotateSelected(float angle, char axis) {
+    for (unsigned int index : selectedObjects) {
+        objects[index]->rotate(angle, axis);
+    }
+}
+
 void Scene::addObject(const std::string& objectType, float param1, int param2) {
     ObjectsFactory factory;
     std::shared_ptr<Object3d> object = factory.createObject(objectType, param1, param2);
@@ -109,11 +162,18 @@ void Scene::draw(sf::RenderWindow &window) {
         float deltaTime = dt.asSeconds();
         update(deltaTime);
     }
+    GeometryPager::getInstance().update(objects, selectedObjectIndex, camera);
+    LodManager::getInstance().update(objects);
     renderer.render(objects, camera);
 }
 
 void Scene::onChangeSelectedObjectIndex(int selectedObjectIndex) {
+    // The object about to be edited needs its geometry in memory
+    if (selectedObjectIndex > 0 && selectedObjectIndex < static_cast<int>(objects.size())) {
+        GeometryPager::getInstance().require(objects[selectedObjectIndex]);
+    }
     this->selectedObjectIndex = selectedObjectIndex;
+    notify({SceneChange::Type::SelectionChanged, selectedObjectIndex});
 }
 
 void Scene::handleScroll(sf::Event::MouseWheelScrollEvent event) {
@@ -122,6 +182,14 @@ void Scene::handleScroll(sf::Event::MouseWheelScrollEvent event) {
 
 void Scene::handleKeyPressed(sf::Keyboard::Key key) {
     Vector3 direction;
+    if (key == sf::Keyboard::F3) {
+        renderer.toggleStatsOverlay();
+        return;
+    }
+    if (key == sf::Keyboard::F4) {
+        renderer.toggleHiZOverlay();
+        return;
+    }
     if (getObjects().empty()) {
         return;
     }
@@ -270,6 +338,7 @@ void Scene::copyObjectByIndex(int index) {
     if (index < 0 || index >= objects.size()) {
         throw std::out_of_range("Index out of range");
     }
+    GeometryPager::getInstance().require(objects[index]);
     std::shared_ptr<Object3d> clonedObject = objects[index]->clone();
     clonedObject->isSelected = false;
     addObject(clonedObject);
@@ -288,6 +357,7 @@ void Scene::deleteObjectByIndex(int index) {
         selectedObjectIndex = std::max(0, selectedObjectIndex - 1);
 
     }
+    notify({SceneChange::Type::ObjectRemoved, index});
     if (!objects.empty()) {
         onChangeSelectedObjectIndex(selectedObjectIndex);
     }
@@ -301,7 +371,9 @@ void Scene::setFacesEditMode(bool value) {
 void Scene::resetObjects() {
     objects.clear();
     selectedObjects.clear();
+    selectedObjectIndex = 0;
     addObject(std::shared_ptr<Object3d>(new GridPlane()));
+    notify({SceneChange::Type::ObjectsReset});
 }
 
 bool Scene::getObjectsEditMode() {
@@ -329,6 +401,9 @@ bool Scene::isObjectSelected(unsigned int i) const {
 
 void Scene::toggleObjectSelected(unsigned int i) {
     if (i < 1) return;
+    if (!objects[i]->isSelected) {
+        GeometryPager::getInstance().require(objects[i]);
+    }
     objects[i]->isSelected = !objects[i]->isSelected;
     auto it = std::find(selectedObjects.begin(), selectedObjects.end(), i);
     if (it != selectedObjects.end()) {
@@ -7,19 +7,47 @@
 #include "../ui/Component.hpp"
 #include "Camera.hpp"
 #include "Renderer.hpp"
+#include <functional>
 #include <vector>
 #include <memory>
 #include "../../utils/files/Config.hpp"
 #include "../../utils/ZBuffer.hpp"
-
-
+#include "../../utils/geometry/MeshBoolean.hpp"
+
+
+
+// Sent to scene listeners, so views can patch their widgets instead of rebuilding them
+struct SceneChange {
+    enum class Type {
+        ObjectAdded,
+        ObjectRemoved,
+        // Many objects changed at once, e.g. while a project loads
+        ObjectsReset,
+        SelectionChanged,
+        // Vertices or faces of an object were added or removed
+        TopologyChanged
+    };
+    Type type;
+    // The object added, removed or edited
+    int objectIndex = -1;
+};
 
 class Scene : public Component {
 public:
+    using Listener = std::function<void(const SceneChange&)>;
+
     static Scene& getInstance(sf::RenderWindow& window);
 
+    // Returns an id for removeListener
+    int addListener(Listener listener);
+    void removeListener(int id);
+    // For edits made directly on an object's mesh
+    void notifyTopologyChanged(int objectIndex);
+
     void addObject(std::shared_ptr<Object3d> object);
     void addObject(const std::string& objectType, float param1 = 1.0f, int param2 = 16);
+    // Appends objects without changing the selection, for bulk loads
+    void addObjects(const std::vector<std::shared_ptr<Object3d>>& newObjects);
     const std::vector<std::shared_ptr<Object3d>>& getObjects() const;
 
     void setCamera(Camera &camera);
@@ -51,7 +79,11 @@ public:
 
     void copyObjectByIndex(int index);
     void deleteObjectByIndex(int index);
-    void createCombination();
+    void createCombination(BooleanOperation operation = BooleanOperation::Union);
+
+    void translateSelected(const Vector3& translation);
+    void scaleSelected(const Vector3& scaleDelta);
+    void rotateSelected(float angle, char axis);
 
     void resetObjects();
     Renderer renderer;
@@ -70,6 +102,10 @@ private:
 
     int selectedObjectIndex = 0;
 
+    std::vector<std::pair<int, Listener>> listeners;
+    int nextListenerId = 1;
+    void notify(const SceneChange& change);
+
     bool verticesEditMode = false;
     bool objectsEditMode = false;
     bool facesEditMode = false;
@@ -0,0 +1,156 @@
+#include "ThumbnailCache.hpp"
+#include "../../utils/ThreadPool.hpp"
+#include "../../utils/files/Config.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+constexpr char DIRECTORY_NAME[] = ".thumbnails";
+
+static uint64_t hashString(const std::string& text) {
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : text) {
+        hash = (hash ^ c) * 1099511628211ull;
+    }
+    return hash;
+}
+
+static std::string toHex(uint64_t value) {
+    char text[17];
+    std::snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(value));
+    return text;
+}
+
+// The same project is reached through differently spelled paths, e.g. with doubled separators
+static std::string normalize(const std::string& projectPath) {
+    return fs::path(projectPath).lexically_normal().string();
+}
+
+ThumbnailCache& ThumbnailCache::getInstance() {
+    static ThumbnailCache instance;
+    return instance;
+}
+
+std::string ThumbnailCache::getDirectory() {
+    return Config::getInstance().getProjectsPath() + "/" + DIRECTORY_NAME;
+}
+
+std::string ThumbnailCache::getPathPrefix(const std::string& projectPath) {
+    return toHex(hashString(projectPath));
+}
+
+std::string ThumbnailCache::getKey(const std::string& projectPath) {
+    std::error_code error;
+    auto modified = fs::last_write_time(projectPath, error);
+    if (error) return "";
+    auto size = fs::file_size(projectPath, error);
+    if (error) return "";
+    return makeKey(modified.time_since_epoch().count(), size);
+}
+
+std::string ThumbnailCache::makeKey(int64_t modified, uintmax_t size) {
+    return toHex(hashString(std::to_string(modified) + ":" + std::to_string(size)));
+}
+
+void ThumbnailCache::removeFiles(const std::string& directory, const std::string& prefix, const std::string& keep) {
+    std::error_code error;
+    for (const auto& file : fs::directory_iterator(directory, error)) {
+        std::string name = file.path().filename().string();
+        if (name.rfind(prefix + "-", 0) == 0 && name != keep) {
+            fs::remove(file.path(), error);
+        }
+    }
+}
+
+void ThumbnailCache::store(const std::string& projectPath, const sf::Image& image) {
+    std::string path = normalize(projectPath);
+    std::string key = getKey(path);
+    if (key.empty()) return;
+
+    Entry& entry = entries[path];
+    entry.key = key;
+    entry.loading = {};
+    entry.texture = std::make_unique<sf::Texture>();
+    if (entry.texture->loadFromImage(image)) {
+        entry.texture->setSmooth(true);
+    } else {
+        entry.texture.reset();
+    }
+
+    // Each write waits on the pool for the one before it so an older preview never replaces a newer
+    // one. The pool starts tasks in the order they were submitted, so the earlier one is running.
+    std::string directory = getDirectory();
+    std::string prefix = getPathPrefix(path);
+    std::shared_future<void> previous = pendingWrite;
+    pendingWrite = ThreadPool::getInstance().submit([previous, directory, prefix, key, image]() {
+        if (previous.valid()) {
+            previous.wait();
+        }
+        std::string name = prefix + "-" + key + ".png";
+        std::error_code error;
+        fs::create_directories(directory, error);
+        if (error || !image.saveToFile(directory + "/" + name)) {
+            std::cerr << "Error saving project thumbnail: " << name << std::endl;
+            return;
+        }
+        removeFiles(directory, prefix, name);
+    }).share();
+}
+
+const sf::Texture* ThumbnailCache::get(const std::string& projectPath, const std::string& key) {
+    std::string path = normalize(projectPath);
+    auto found = entries.find(path);
+    // The project changed since its preview was read
+    if (found != entries.end() && found->second.key != key) {
+        entries.erase(found);
+        found = entries.end();
+    }
+    if (found == entries.end()) {
+        Entry entry;
+        entry.key = key;
+        if (!entry.key.empty()) {
+            std::string file = getDirectory() + "/" + getPathPrefix(path) + "-" + entry.key + ".png";
+            entry.loading = ThreadPool::getInstance().submit([file]() -> std::optional<sf::Image> {
+                std::error_code error;
+                sf::Image image;
+                if (!fs::exists(file, error) || !image.loadFromFile(file)) {
+                    return std::nullopt;
+                }
+                return image;
+            });
+        }
+        found = entries.emplace(path, std::move(entry)).first;
+    }
+
+    Entry& entry = found->second;
+    if (entry.loading.valid() && entry.loading.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        std::optional<sf::Image> image = entry.loading.get();
+        // Textures are created here since only the main thread owns the OpenGL context
+        if (image) {
+            entry.texture = std::make_unique<sf::Texture>();
+            if (entry.texture->loadFromImage(*image)) {
+                entry.texture->setSmooth(true);
+            } else {
+                entry.texture.reset();
+            }
+        }
+    }
+    return entry.texture.get();
+}
+
+void ThumbnailCache::remove(const std::string& projectPath) {
+    std::string path = normalize(projectPath);
+    entries.erase(path);
+    // Queued behind any pending write, which could otherwise recreate the preview
+    std::string directory = getDirectory();
+    std::string prefix = getPathPrefix(path);
+    std::shared_future<void> previous = pendingWrite;
+    pendingWrite = ThreadPool::getInstance().submit([previous, directory, prefix]() {
+        if (previous.valid()) {
+            previous.wait();
+        }
+        removeFiles(directory, prefix, "");
+    }).share();
+}
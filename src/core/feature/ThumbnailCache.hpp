@@ -0,0 +1,52 @@
+#ifndef THUMBNAIL_CACHE_HPP
+#define THUMBNAIL_CACHE_HPP
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+// Project previews, kept as PNG files in a folder next to the projects. Each file is named after
+// the project's path and a key made from its modification time and size, so a project changed
+// since its preview was made shows none. Previews are read on the thread pool the first time
+// they are asked for.
+class ThumbnailCache {
+public:
+    static ThumbnailCache& getInstance();
+
+    // Records image as the preview of the project file as it is now
+    void store(const std::string& projectPath, const sf::Image& image);
+    // The preview for the project file in the state key describes, or nullptr while it is being
+    // read or when there is none
+    const sf::Texture* get(const std::string& projectPath, const std::string& key);
+    void remove(const std::string& projectPath);
+
+    // Key of a project file with the given modification time (file clock ticks) and size
+    static std::string makeKey(int64_t modified, uintmax_t size);
+
+private:
+    ThumbnailCache() = default;
+    ThumbnailCache(const ThumbnailCache&) = delete;
+    ThumbnailCache& operator=(const ThumbnailCache&) = delete;
+
+    struct Entry {
+        std::string key;
+        std::future<std::optional<sf::Image>> loading;
+        std::unique_ptr<sf::Texture> texture;
+    };
+
+    static std::string getDirectory();
+    static std::string getPathPrefix(const std::string& projectPath);
+    // Key of the project file as it is now; empty when it cannot be read
+    static std::string getKey(const std::string& projectPath);
+    static void removeFiles(const std::string& directory, const std::string& prefix, const std::string& keep);
+
+    std::unordered_map<std::string, Entry> entries;
+    // Last queued file change; each one waits for the one before it
+    std::shared_future<void> pendingWrite;
+};
+
+#endif
@@ -0,0 +1,251 @@
+#include "ThumbnailRenderer.hpp"
+#include "Camera.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+
+// Matches the editor camera and renderer
+constexpr float FIELD_OF_VIEW = 90.0f;
+constexpr float NEAR_PLANE = 0.1f;
+constexpr float FAR_PLANE = 100.0f;
+
+// Projected bounding-sphere radius (pixels) below which level i + 1 is used, as in the renderer
+constexpr float LOD_PIXEL_THRESHOLDS[] = {240.0f, 120.0f, 60.0f};
+
+// View used by frame(), and how much of the preview's height the framed sphere covers
+constexpr float FRAME_YAW = 30.0f;
+constexpr float FRAME_PITCH = -25.0f;
+constexpr float FRAME_FILL = 0.9f;
+
+const sf::Color BACKGROUND(20, 20, 20);
+const sf::Color PROXY_COLOR(90, 90, 90);
+
+namespace {
+struct Framebuffer {
+    std::vector<sf::Uint8> pixels;
+    std::vector<float> depths;
+
+    Framebuffer()
+        : pixels(ThumbnailRenderer::WIDTH * ThumbnailRenderer::HEIGHT * 4),
+          depths(ThumbnailRenderer::WIDTH * ThumbnailRenderer::HEIGHT, std::numeric_limits<float>::infinity()) {
+        for (size_t i = 0; i < depths.size(); ++i) {
+            pixels[i * 4] = BACKGROUND.r;
+            pixels[i * 4 + 1] = BACKGROUND.g;
+            pixels[i * 4 + 2] = BACKGROUND.b;
+            pixels[i * 4 + 3] = 255;
+        }
+    }
+};
+
+// A vertex in preview pixels, with its view-space depth
+struct ScreenVertex {
+    float x;
+    float y;
+    float depth;
+};
+
+float edge(const ScreenVertex& a, const ScreenVertex& b, float x, float y) {
+    return (b.x - a.x) * (y - a.y) - (b.y - a.y) * (x - a.x);
+}
+
+// Fills the pixels whose centre the triangle covers, interpolating depth linearly on screen
+void rasterize(Framebuffer& framebuffer, const ScreenVertex& a, const ScreenVertex& b, const ScreenVertex& c,
+               const sf::Color& color) {
+    float area = edge(a, b, c.x, c.y);
+    if (area == 0.0f) return;
+
+    int minX = std::max(0, static_cast<int>(std::floor(std::min({a.x, b.x, c.x}))));
+    int maxX = std::min(static_cast<int>(ThumbnailRenderer::WIDTH) - 1, static_cast<int>(std::ceil(std::max({a.x, b.x, c.x}))));
+    int minY = std::max(0, static_cast<int>(std::floor(std::min({a.y, b.y, c.y}))));
+    int maxY = std::min(static_cast<int>(ThumbnailRenderer::HEIGHT) - 1, static_cast<int>(std::ceil(std::max({a.y, b.y, c.y}))));
+
+    for (int y = minY; y <= maxY; ++y) {
+        for (int x = minX; x <= maxX; ++x) {
+            float px = static_cast<float>(x) + 0.5f;
+            float py = static_cast<float>(y) + 0.5f;
+            float wa = edge(b, c, px, py) / area;
+            float wb = edge(c, a, px, py) / area;
+            float wc = edge(a, b, px, py) / area;
+            if (wa < 0.0f || wb < 0.0f || wc < 0.0f) continue;
+
+            float depth = wa * a.depth + wb * b.depth + wc * c.depth;
+            size_t index = static_cast<size_t>(y) * ThumbnailRenderer::WIDTH + static_cast<size_t>(x);
+            if (depth >= framebuffer.depths[index]) continue;
+            framebuffer.depths[index] = depth;
+            framebuffer.pixels[index * 4] = color.r;
+            framebuffer.pixels[index * 4 + 1] = color.g;
+            framebuffer.pixels[index * 4 + 2] = color.b;
+        }
+    }
+}
+
+// Transforms local vertices to view space and preview pixels
+void project(const std::vector<Vector3>& vertices, const Matrix4& modelView, const Matrix4& projection,
+             std::vector<Vector3>& viewVertices, std::vector<ScreenVertex>& screenVertices) {
+    viewVertices.clear();
+    screenVertices.clear();
+    for (const auto& vertex : vertices) {
+        Vector4 view = modelView * Vector4(vertex, 1.0f);
+        Vector4 clip = projection * Vector4(view.x, view.y, view.z, 1.0f);
+        float w = clip.w != 0.0f ? clip.w : 1.0f;
+        viewVertices.emplace_back(view.x, view.y, view.z);
+        screenVertices.push_back({
+            (clip.x / w + 1.0f) * 0.5f * ThumbnailRenderer::WIDTH,
+            (1.0f - clip.y / w) * 0.5f * ThumbnailRenderer::HEIGHT,
+            view.z
+        });
+    }
+}
+
+// Faces turned away from the camera are drawn darker so shapes read without edges
+sf::Color shade(const sf::Color& color, const Vector3& a, const Vector3& b, const Vector3& c) {
+    Vector3 normal = (b - a).cross(c - a);
+    Vector3 toCamera = (a + b + c) * (-1.0f / 3.0f);
+    float lengths = normal.length() * toCamera.length();
+    float light = 0.45f + (lengths > 0.0f ? 0.55f * std::abs(normal.dot(toCamera)) / lengths : 0.0f);
+    return sf::Color(static_cast<sf::Uint8>(color.r * light), static_cast<sf::Uint8>(color.g * light),
+                     static_cast<sf::Uint8>(color.b * light));
+}
+
+void drawTriangles(Framebuffer& framebuffer, const std::vector<Vector3>& viewVertices,
+                   const std::vector<ScreenVertex>& screenVertices, const std::array<int, 3>& corners,
+                   const sf::Color& color) {
+    for (int corner : corners) {
+        if (viewVertices[corner].z < NEAR_PLANE || viewVertices[corner].z > FAR_PLANE) return;
+    }
+    rasterize(framebuffer, screenVertices[corners[0]], screenVertices[corners[1]], screenVertices[corners[2]],
+              shade(color, viewVertices[corners[0]], viewVertices[corners[1]], viewVertices[corners[2]]));
+}
+
+std::vector<Vector3> boxCorners(const BoundingBox& bounds) {
+    std::vector<Vector3> corners;
+    for (int corner = 0; corner < 8; ++corner) {
+        corners.emplace_back(
+            (corner & 1) ? bounds.max.x : bounds.min.x,
+            (corner & 2) ? bounds.max.y : bounds.min.y,
+            (corner & 4) ? bounds.max.z : bounds.min.z
+        );
+    }
+    return corners;
+}
+
+Camera makeCamera(const ProjectCamera& projectCamera) {
+    Camera camera(static_cast<float>(ThumbnailRenderer::WIDTH), static_cast<float>(ThumbnailRenderer::HEIGHT),
+                  FIELD_OF_VIEW, NEAR_PLANE, FAR_PLANE);
+    camera.setPosition(projectCamera.position);
+    camera.setYawAndPitch(projectCamera.yaw, projectCamera.pitch);
+    camera.setOrbitCenter(projectCamera.orbitCenter);
+    return camera;
+}
+
+// Two triangles per box side, over the corners from boxCorners
+constexpr std::array<std::array<int, 3>, 12> BOX_TRIANGLES = {{
+    {0, 1, 3}, {0, 3, 2}, {4, 6, 7}, {4, 7, 5},
+    {0, 4, 5}, {0, 5, 1}, {2, 3, 7}, {2, 7, 6},
+    {0, 2, 6}, {0, 6, 4}, {1, 5, 7}, {1, 7, 3}
+}};
+}
+
+std::vector<ThumbnailRenderer::Item> ThumbnailRenderer::capture(const std::vector<std::shared_ptr<Object3d>>& objects,
+                                                               const ProjectCamera& projectCamera, size_t faceBudget) {
+    Camera camera = makeCamera(projectCamera);
+    Matrix4 viewMatrix = camera.getViewMatrix();
+    Matrix4 projectionMatrix = camera.getProjectionMatrix();
+
+    std::vector<Item> items;
+    for (const auto& object : objects) {
+        Item item{object->getTransformation(), nullptr, {}};
+        if (object->isPagedOut()) {
+            item.bounds = object->getPagedOutBounds();
+            items.push_back(std::move(item));
+            continue;
+        }
+
+        const BoundingSphere& sphere = object->getLocalBoundingSphere();
+        Vector4 center = viewMatrix * item.transform * Vector4(sphere.center, 1.0f);
+        Vector3 scale = object->getScale();
+        float radius = sphere.radius * std::max({std::abs(scale.x), std::abs(scale.y), std::abs(scale.z)});
+        if (center.z + radius < NEAR_PLANE || center.z - radius > FAR_PLANE) continue;
+
+        int levelCount = std::min<int>(object->getLodLevelCount(), std::size(LOD_PIXEL_THRESHOLDS) + 1);
+        int level = 0;
+        if (center.z > NEAR_PLANE) {
+            float pixelRadius = radius * projectionMatrix(1, 1) / center.z * HEIGHT * 0.5f;
+            while (level + 1 < levelCount && pixelRadius < LOD_PIXEL_THRESHOLDS[level]) {
+                level++;
+            }
+        }
+
+        size_t faceCount = object->getFaces().size();
+        if (level > 0) {
+            item.mesh = object->shareLodLevel(level);
+        } else if (faceCount <= faceBudget) {
+            faceBudget -= faceCount;
+            item.mesh = std::make_shared<const LodLevel>(LodLevel{object->getVertices(), object->getFaces(), {}});
+        } else if (levelCount > 1) {
+            item.mesh = object->shareLodLevel(1);
+        } else {
+            item.bounds = {sphere.center - Vector3(sphere.radius, sphere.radius, sphere.radius),
+                           sphere.center + Vector3(sphere.radius, sphere.radius, sphere.radius)};
+        }
+        items.push_back(std::move(item));
+    }
+    return items;
+}
+
+sf::Image ThumbnailRenderer::render(const std::vector<Item>& items, const ProjectCamera& projectCamera) {
+    Camera camera = makeCamera(projectCamera);
+    Matrix4 viewMatrix = camera.getViewMatrix();
+    Matrix4 projectionMatrix = camera.getProjectionMatrix();
+
+    Framebuffer framebuffer;
+    std::vector<Vector3> viewVertices;
+    std::vector<ScreenVertex> screenVertices;
+    for (const auto& item : items) {
+        Matrix4 modelView = viewMatrix * item.transform;
+
+        if (!item.mesh) {
+            project(boxCorners(item.bounds), modelView, projectionMatrix, viewVertices, screenVertices);
+            for (const auto& triangle : BOX_TRIANGLES) {
+                drawTriangles(framebuffer, viewVertices, screenVertices, triangle, PROXY_COLOR);
+            }
+            continue;
+        }
+
+        project(item.mesh->vertices, modelView, projectionMatrix, viewVertices, screenVertices);
+        for (const auto& face : item.mesh->faces) {
+            sf::Color color(static_cast<sf::Uint8>(face[3]), static_cast<sf::Uint8>(face[4]),
+                            static_cast<sf::Uint8>(face[5]));
+            drawTriangles(framebuffer, viewVertices, screenVertices, {face[0], face[1], face[2]}, color);
+        }
+    }
+
+    sf::Image image;
+    image.create(WIDTH, HEIGHT, framebuffer.pixels.data());
+    return image;
+}
+
+sf::Image ThumbnailRenderer::render(const std::vector<std::shared_ptr<Object3d>>& objects, const ProjectCamera& camera) {
+    return render(capture(objects, camera), camera);
+}
+
+ProjectCamera ThumbnailRenderer::frame(const Vector3& center, float radius) {
+    Camera camera(static_cast<float>(WIDTH), static_cast<float>(HEIGHT), FIELD_OF_VIEW, NEAR_PLANE, FAR_PLANE);
+    camera.setPosition(Vector3(0.0f, 0.0f, 0.0f));
+    camera.setYawAndPitch(FRAME_YAW, FRAME_PITCH);
+    Matrix4 view = camera.getViewMatrix();
+
+    // Half the preview's height, in world units, at a depth of one
+    Vector4 clip = camera.getProjectionMatrix() * Vector4(Vector3(0.0f, 1.0f, 1.0f), 1.0f);
+    float scale = clip.w != 0.0f ? std::abs(clip.y / clip.w) : 1.0f;
+
+    // The third row of the view matrix is the direction the camera looks in
+    Vector3 viewDirection(view(2, 0), view(2, 1), view(2, 2));
+    ProjectCamera projectCamera;
+    projectCamera.position = center - viewDirection * (radius * scale / FRAME_FILL);
+    projectCamera.yaw = FRAME_YAW;
+    projectCamera.pitch = FRAME_PITCH;
+    projectCamera.orbitCenter = center;
+    return projectCamera;
+}
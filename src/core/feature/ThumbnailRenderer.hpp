@@ -0,0 +1,38 @@
+#ifndef THUMBNAIL_RENDERER_HPP
+#define THUMBNAIL_RENDERER_HPP
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "../objects/Object3d.hpp"
+#include "../../utils/files/ProjectData.hpp"
+
+// Draws a small preview of a scene into a CPU framebuffer, independent of the window. Objects
+// are drawn at the coarsest level of detail that suits the preview size, paged out objects as
+// their bounding box.
+class ThumbnailRenderer {
+public:
+    static constexpr unsigned int WIDTH = 256;
+    static constexpr unsigned int HEIGHT = 144;
+
+    // What to draw for one object, independent of the object so it can be drawn on another thread
+    struct Item {
+        Matrix4 transform;
+        // Drawn as the box of bounds when empty
+        std::shared_ptr<const LodLevel> mesh;
+        BoundingBox bounds;
+    };
+
+    // Picks the geometry for each visible object. Meshes are shared when a level of detail fits and
+    // copied otherwise, up to faceBudget faces in all; objects past the budget are drawn as boxes.
+    static std::vector<Item> capture(const std::vector<std::shared_ptr<Object3d>>& objects,
+                                     const ProjectCamera& camera, size_t faceBudget = SIZE_MAX);
+    static sf::Image render(const std::vector<Item>& items, const ProjectCamera& camera);
+    static sf::Image render(const std::vector<std::shared_ptr<Object3d>>& objects, const ProjectCamera& camera);
+    // A camera looking down at the sphere at an angle, close enough for it to fill most of
+    // the preview's height
+    static ProjectCamera frame(const Vector3& center, float radius);
+};
+
+#endif
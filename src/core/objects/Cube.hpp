@@ -1,7 +1,7 @@
 #ifndef CUBE_HPP
 #define CUBE_HPP
 
-#include "Object3D.hpp"
+#include "Object3d.hpp"
 
 class Cube : public Object3d {
 public:
@@ -1,7 +1,7 @@
 #ifndef GRIDPLANE_HPP
 #define GRIDPLANE_HPP
 
-#include "Object3D.hpp"
+#include "Object3d.hpp"
 #include "../../utils/math/Vector3.hpp"
 #include <vector>
 
@@ -3,9 +3,12 @@
 #include <algorithm>
 #include <iomanip>
 #include <unordered_set>
+#include "../../utils/geometry/MeshEdges.hpp"
+#include "../../utils/geometry/VertexWelder.hpp"
 
 Object3d::Object3d()
-    : transform(Matrix4::identity()), position(0.0f, 0.0f, 0.0f), rotation(0.0f, 0.0f, 0.0f), scale(1.0f, 1.0f, 1.0f) {}
+    : position(0.0f, 0.0f, 0.0f), orientation(Quaternion::identity()), rotation(0.0f, 0.0f, 0.0f), scale(1.0f, 1.0f, 1.0f),
+      transform(Matrix4::identity()) {}
 
 std::vector<std::array<int, 7>> Object3d::getSortedFaces(const std::vector<Vector3>& transformedVertices) const {
     std::vector<std::tuple<float, std::array<int, 7>>> faceDepths;
@@ -32,69 +35,35 @@ std::vector<std::array<int, 7>> Object3d::getSortedFaces(const std::vector<Vecto
     return sortedFaces;
 }
 
-void Object3d::setTransform(const Matrix4& newTransform) {
-    transform = newTransform;
+void Object3d::invalidateTransform() {
+    transformDirty = true;
 }
 
 void Object3d::rotate(float angle, char axis) {
-    Matrix4 rotationMatrix;
-
-    switch (axis) {
-        case 'x':
-            rotationMatrix = Matrix4::rotationX(angle);
-        rotation.x += angle;
-        break;
-        case 'y':
-            rotationMatrix = Matrix4::rotationY(angle);
-        rotation.y += angle;
-        break;
-        case 'z':
-            rotationMatrix = Matrix4::rotationZ(angle);
-        rotation.z += angle;
-        break;
-        default:
-            return;
+    if (axis != 'x' && axis != 'y' && axis != 'z') {
+        return;
     }
 
-    transform = transform * rotationMatrix;
+    // The orientation is the source of truth; the Euler angles that get saved and journaled follow it
+    orientation = (orientation * Quaternion::fromAxisAngle(axis, angle)).normalized();
+    rotation = orientation.toEuler();
+    invalidateTransform();
 }
 
 void Object3d::setRotation(const Vector3& newRotation) {
     rotation = newRotation;
-
-    Matrix4 rotationX = Matrix4::rotationX(newRotation.x);
-    Matrix4 rotationY = Matrix4::rotationY(newRotation.y);
-    Matrix4 rotationZ = Matrix4::rotationZ(newRotation.z);
-
-    Matrix4 rotationMatrix = rotationZ * rotationY * rotationX; // Assuming ZYX rotation order
-
-    Matrix4 translationMatrix = Matrix4::translation(position.x, position.y, position.z);
-    Matrix4 scaleMatrix = Matrix4::scale(scale.x, scale.y, scale.z);
-    transform = translationMatrix * rotationMatrix * scaleMatrix;
+    orientation = Quaternion::fromEuler(newRotation);
+    invalidateTransform();
 }
 
 void Object3d::translate(const Vector3& translation) {
     position = position + translation;
-
-    Matrix4 rotationMatrix = Matrix4::rotationZ(rotation.z) *
-                             Matrix4::rotationY(rotation.y) *
-                             Matrix4::rotationX(rotation.x);
-    Matrix4 scaleMatrix = Matrix4::scale(scale.x, scale.y, scale.z);
-    Matrix4 translationMatrix = Matrix4::translation(position.x, position.y, position.z);
-
-    transform = translationMatrix * rotationMatrix * scaleMatrix;
+    invalidateTransform();
 }
 
 void Object3d::setScale(const Vector3& newScale) {
     scale = scale + newScale;
-
-    Matrix4 rotationMatrix = Matrix4::rotationZ(rotation.z) *
-                             Matrix4::rotationY(rotation.y) *
-                             Matrix4::rotationX(rotation.x);
-    Matrix4 translationMatrix = Matrix4::translation(position.x, position.y, position.z);
-    Matrix4 scaleMatrix = Matrix4::scale(scale.x, scale.y, scale.z);
-
-    transform = translationMatrix * rotationMatrix * scaleMatrix;
+    invalidateTransform();
 }
 
 Vector3 Object3d::getPosition() const {
@@ -109,19 +78,27 @@ Vector3 Object3d::getScale() const {
     return scale;
 }
 
-Matrix4 Object3d::getTransformation() const {
+Quaternion Object3d::getOrientation() const {
+    return orientation;
+}
+
+const Matrix4& Object3d::getTransformation() const {
+    if (transformDirty) {
+        transform = Matrix4::composeTRS(position, orientation, scale);
+        transformDirty = false;
+    }
     return transform;
 }
 
-std::vector<Vector3> Object3d::getVertices() {
+const std::vector<Vector3>& Object3d::getVertices() const {
     return vertices;
 }
 
-std::vector<std::pair<int, int>> Object3d::getEdges() {
+const std::vector<std::pair<int, int>>& Object3d::getEdges() const {
     return edges;
 }
 
-std::vector<std::array<int, 7>> Object3d::getFaces() {
+const std::vector<std::array<int, 7>>& Object3d::getFaces() const {
     return faces;
 }
 
@@ -154,6 +131,7 @@ void Object3d::setFaceColor(int faceIndex, const std::string& hexColor) {
     faces[faceIndex][4] = g;
     faces[faceIndex][5] = b;
     faces[faceIndex][6] = a;
+    markFacesRecolored(faceIndex);
 }
 
 std::string Object3d::getFaceColor(int faceIndex) const {
@@ -201,6 +179,7 @@ void Object3d::setFacesColor(const std::string& hexColor) {
         face[5] = b;  // Blue
         face[6] = a;  // Alpha
     }
+    markGeometryChanged();
 }
 
 std::array<Vector3, 3> Object3d::getFaceVerticesForEditing(int faceIndex) const {
@@ -226,6 +205,7 @@ void Object3d::updateFaceVertex(int faceIndex, int vertexPosition, const Vector3
 
     // Update the vertex in the main vertices array
     vertices[vertexIndex] = newVertexPosition;
+    markVerticesMoved(vertexIndex);
 }
 
 void Object3d::addVertex() {
@@ -245,6 +225,7 @@ void Object3d::addVertex() {
     center.z /= vertices.size();
 
     vertices.push_back(center);
+    markGeometryChanged();
 }
 
 void Object3d::updateVertex(int vertexIndex, const Vector3& newVertexPosition) {
@@ -253,6 +234,7 @@ void Object3d::updateVertex(int vertexIndex, const Vector3& newVertexPosition) {
     }
 
     vertices[vertexIndex] = newVertexPosition;
+    markVerticesMoved(vertexIndex);
 }
 
 void Object3d::deleteVertex(int vertexIndex) {
@@ -284,13 +266,72 @@ void Object3d::deleteVertex(int vertexIndex) {
             if (face[i] > vertexIndex) face[i]--;
         }
     }
+    markGeometryChanged();
+}
+
+int Object3d::mergeVerticesByDistance(float tolerance) {
+    size_t originalCount = vertices.size();
+    std::vector<int> remap = VertexWelder::weld(vertices, tolerance);
+    if (vertices.size() == originalCount) {
+        return 0;
+    }
+
+    for (auto& face : faces) {
+        for (int i = 0; i < 3; ++i) {
+            face[i] = remap[face[i]];
+        }
+    }
+    faces.erase(std::remove_if(faces.begin(), faces.end(),
+        [](const std::array<int, 7>& face) {
+            return face[0] == face[1] || face[1] == face[2] || face[0] == face[2];
+        }),
+        faces.end());
+
+    for (auto& edge : edges) {
+        edge.first = remap[edge.first];
+        edge.second = remap[edge.second];
+        if (edge.first > edge.second) std::swap(edge.first, edge.second);
+    }
+    edges.erase(std::remove_if(edges.begin(), edges.end(),
+        [](const std::pair<int, int>& edge) {
+            return edge.first == edge.second;
+        }),
+        edges.end());
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    selectedVertices.clear();
+    hoveredVertices.clear();
+    selectedFaces.clear();
+    hoveredFaces.clear();
+    markGeometryChanged();
+
+    return static_cast<int>(originalCount - vertices.size());
 }
 
 void Object3d::setVertices(const std::vector<Vector3> &vector) {
     vertices = vector;
+    markGeometryChanged();
 }
 
 BoundingBox Object3d::getBoundingBox() const {
+    if (pagedOut) {
+        const Matrix4& transform = getTransformation();
+        BoundingBox bbox{transform * pagedOutBounds.min, transform * pagedOutBounds.min};
+        for (int corner = 1; corner < 8; ++corner) {
+            Vector3 transformedCorner = transform * Vector3(
+                (corner & 1) ? pagedOutBounds.max.x : pagedOutBounds.min.x,
+                (corner & 2) ? pagedOutBounds.max.y : pagedOutBounds.min.y,
+                (corner & 4) ? pagedOutBounds.max.z : pagedOutBounds.min.z
+            );
+            bbox.min = Vector3(std::min(bbox.min.x, transformedCorner.x), std::min(bbox.min.y, transformedCorner.y),
+                               std::min(bbox.min.z, transformedCorner.z));
+            bbox.max = Vector3(std::max(bbox.max.x, transformedCorner.x), std::max(bbox.max.y, transformedCorner.y),
+                               std::max(bbox.max.z, transformedCorner.z));
+        }
+        return bbox;
+    }
+
     if (vertices.empty()) {
         // Return an invalid bounding box if there are no vertices
         return BoundingBox{
@@ -300,6 +341,7 @@ BoundingBox Object3d::getBoundingBox() const {
     }
 
     // Initialize the bounding box with the first transformed vertex
+    const Matrix4& transform = getTransformation();
     Vector3 firstTransformedVertex = transform * vertices[0];
     BoundingBox bbox;
     bbox.min = firstTransformedVertex;
@@ -324,14 +366,141 @@ BoundingBox Object3d::getBoundingBox() const {
 }
 
 
-void Object3d::setPosition(Vector3& newPos) {
+void Object3d::markGeometryChanged() {
+    geometryRevision++;
+    if (editTracking) {
+        recordTopologyChange();
+    }
+}
+
+void Object3d::markVerticesMoved(int vertexIndex) {
+    geometryRevision++;
+    if (editTracking && !pendingEdits.topologyChanged) {
+        pendingEdits.movedVertices.push_back(vertexIndex);
+        trimPendingEdits();
+    }
+}
+
+void Object3d::markVerticesMoved(const std::unordered_set<int>& vertexIndices) {
+    geometryRevision++;
+    if (editTracking && !pendingEdits.topologyChanged) {
+        pendingEdits.movedVertices.insert(pendingEdits.movedVertices.end(), vertexIndices.begin(), vertexIndices.end());
+        trimPendingEdits();
+    }
+}
+
+void Object3d::markFacesRecolored(int faceIndex) {
+    geometryRevision++;
+    if (editTracking && !pendingEdits.topologyChanged) {
+        pendingEdits.recoloredFaces.push_back(faceIndex);
+        trimPendingEdits();
+    }
+}
+
+void Object3d::recordTopologyChange() {
+    pendingEdits.topologyChanged = true;
+    pendingEdits.movedVertices.clear();
+    pendingEdits.recoloredFaces.clear();
+}
+
+void Object3d::trimPendingEdits() {
+    // Past this size a full copy of the mesh is the smaller record
+    if (pendingEdits.movedVertices.size() > vertices.size() || pendingEdits.recoloredFaces.size() > faces.size()) {
+        recordTopologyChange();
+    }
+}
+
+void Object3d::setEditTracking(bool enabled) {
+    editTracking = enabled;
+    pendingEdits = GeometryEdits();
+}
+
+Object3d::GeometryEdits Object3d::takeGeometryEdits() {
+    GeometryEdits edits = std::move(pendingEdits);
+    pendingEdits = GeometryEdits();
+    return edits;
+}
+
+uint64_t Object3d::getGeometryRevision() const {
+    return geometryRevision;
+}
+
+const BoundingSphere& Object3d::getLocalBoundingSphere() const {
+    if (pagedOut) {
+        localBoundingSphere = {(pagedOutBounds.min + pagedOutBounds.max) * 0.5f,
+                               (pagedOutBounds.max - pagedOutBounds.min).length() * 0.5f};
+        boundingSphereRevision = UINT64_MAX;
+    } else if (boundingSphereRevision != geometryRevision) {
+        boundingSphereRevision = geometryRevision;
+        localBoundingSphere = {Vector3(), 0.0f};
+        if (!vertices.empty()) {
+            Vector3 min = vertices[0], max = vertices[0];
+            for (const auto& vertex : vertices) {
+                min = Vector3(std::min(min.x, vertex.x), std::min(min.y, vertex.y), std::min(min.z, vertex.z));
+                max = Vector3(std::max(max.x, vertex.x), std::max(max.y, vertex.y), std::max(max.z, vertex.z));
+            }
+            Vector3 center = (min + max) * 0.5f;
+            float radiusSquared = 0.0f;
+            for (const auto& vertex : vertices) {
+                radiusSquared = std::max(radiusSquared, (vertex - center).lengthSquared());
+            }
+            localBoundingSphere = {center, std::sqrt(radiusSquared)};
+        }
+    }
+    return localBoundingSphere;
+}
+
+void Object3d::pageOut(const BoundingBox& localBounds) {
+    std::vector<Vector3>().swap(vertices);
+    std::vector<std::array<int, 7>>().swap(faces);
+    std::vector<std::pair<int, int>>().swap(edges);
+    selectedFaces.clear();
+    hoveredFaces.clear();
+    selectedVertices.clear();
+    hoveredVertices.clear();
+    pagedOut = true;
+    pagedOutBounds = localBounds;
+}
+
+void Object3d::pageIn(std::vector<Vector3> newVertices, std::vector<std::array<int, 7>> newFaces) {
+    vertices = std::move(newVertices);
+    faces = std::move(newFaces);
+    edges = computeVisibleEdges(vertices, faces);
+    pagedOut = false;
+    boundingSphereRevision = UINT64_MAX;
+}
+
+bool Object3d::isPagedOut() const {
+    return pagedOut;
+}
+
+const BoundingBox& Object3d::getPagedOutBounds() const {
+    return pagedOutBounds;
+}
+
+void Object3d::setLodLevels(std::shared_ptr<const std::vector<LodLevel>> levels, uint64_t revision) {
+    lodLevels = std::move(levels);
+    lodRevision = revision;
+}
+
+int Object3d::getLodLevelCount() const {
+    if (!lodLevels || lodRevision != geometryRevision) return 1;
+    return 1 + static_cast<int>(lodLevels->size());
+}
+
+const LodLevel* Object3d::getLodLevel(int level) const {
+    if (level <= 0 || level >= getLodLevelCount()) return nullptr;
+    return &(*lodLevels)[level - 1];
+}
+
+std::shared_ptr<const LodLevel> Object3d::shareLodLevel(int level) const {
+    const LodLevel* lod = getLodLevel(level);
+    return lod ? std::shared_ptr<const LodLevel>(lodLevels, lod) : nullptr;
+}
+
+void Object3d::setPosition(const Vector3& newPos) {
     position = newPos;
-    Matrix4 rotationMatrix = Matrix4::rotationZ(rotation.z) *
-                             Matrix4::rotationY(rotation.y) *
-                             Matrix4::rotationX(rotation.x);
-    Matrix4 scaleMatrix = Matrix4::scale(scale.x, scale.y, scale.z);
-    Matrix4 translationMatrix = Matrix4::translation(position.x, position.y, position.z);
-    transform = translationMatrix * rotationMatrix * scaleMatrix;
+    invalidateTransform();
 }
 
 bool Object3d::isFaceSelected(unsigned int faceIndex) const {
@@ -360,6 +529,7 @@ void Object3d::createFace() {
     int v3 = selectedVertices[2];
 
     faces.push_back({v1, v2, v3, 255, 255, 255, 255});
+    markGeometryChanged();
 }
 
 void Object3d::createEdge() {
@@ -373,6 +543,7 @@ void Object3d::createEdge() {
     };
 
     edges.push_back(edge);
+    markGeometryChanged();
 }
 
 void Object3d::moveFaces(const Vector3& translation) {
@@ -393,6 +564,7 @@ void Object3d::moveFaces(const Vector3& translation) {
             }
         }
     }
+    markVerticesMoved(updatedVertices);
 }
 
 void Object3d::rotateFaces(float angle, char axis) {
@@ -452,6 +624,7 @@ void Object3d::rotateFaces(float angle, char axis) {
             }
         }
     }
+    markVerticesMoved(updatedVertices);
 }
 
 void Object3d::scaleFaces(float delta) {
@@ -499,6 +672,7 @@ void Object3d::scaleFaces(float delta) {
             }
         }
     }
+    markVerticesMoved(updatedVertices);
 }
 
 std::vector<std::array<float, 3>> Object3d::getVerticesForJson() {
@@ -515,6 +689,7 @@ void Object3d::inverseFaceNormals() {
             std::swap(faces[faceIndex][0], faces[faceIndex][2]);
         }
     }
+    markGeometryChanged();
 }
 
 bool Object3d::hasEdgeFromSelection() const {
@@ -574,4 +749,5 @@ void Object3d::deleteFaceByIndex(int faceIndex) {
 
     std::for_each(selectedFaces.begin(), selectedFaces.end(), updateIndex);
     std::for_each(hoveredFaces.begin(), hoveredFaces.end(), updateIndex);
-}
\ No newline at end of file
+    markGeometryChanged();
+}
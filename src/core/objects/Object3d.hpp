@@ -3,28 +3,37 @@
 
 #include "../../utils/math/Matrix4.hpp"
 #include "../../utils/math/Vector3.hpp"
+#include "../../utils/math/Quaternion.hpp"
+#include "../../utils/geometry/MeshDecimator.hpp"
 #include <vector>
 #include <array>
 #include <tuple>
 #include <algorithm>
 #include <memory>
+#include <cstdint>
+#include <unordered_set>
 
 struct BoundingBox {
     Vector3 min;
     Vector3 max;
 };
 
+struct BoundingSphere {
+    Vector3 center;
+    float radius;
+};
+
 class Object3d {
 public:
-    Matrix4 transform;
-    Vector3 position;
-    Vector3 rotation;
-    Vector3 scale;
     bool isSelected = false;
     bool isHovered = false;
 
     Object3d();
     virtual ~Object3d() = default;
+    Object3d(const Object3d&) = default;
+    Object3d(Object3d&&) = default;
+    Object3d& operator=(const Object3d&) = default;
+    Object3d& operator=(Object3d&&) = default;
     virtual std::shared_ptr<Object3d> clone() const {
         return std::make_shared<Object3d>(*this);
     }
@@ -33,14 +42,14 @@ public:
 
     virtual std::vector<std::array<int, 7>> getSortedFaces(const std::vector<Vector3>& transformedVertices) const;
 
-    void setTransform(const Matrix4& newTransform);
     void rotate(float angle, char axis);
     void translate(const Vector3& translation);
 
     Vector3 getPosition() const;
     Vector3 getRotation() const;
     Vector3 getScale() const;
-    Matrix4 getTransformation() const;
+    Quaternion getOrientation() const;
+    const Matrix4& getTransformation() const;
 
     void setRotation(const Vector3& newRotation);
     void setScale(const Vector3& newScale);
@@ -53,9 +62,38 @@ public:
     void updateFaceVertex(int faceIndex, int vertexPosition, const Vector3& newVertexPosition);
 
     BoundingBox getBoundingBox() const;
+    const BoundingSphere& getLocalBoundingSphere() const;
+
+    uint64_t getGeometryRevision() const;
+
+    // Geometry edits made while edit tracking is on, so consumers such as the edit journal can
+    // log small changes without diffing whole meshes
+    struct GeometryEdits {
+        std::vector<int> movedVertices;
+        std::vector<int> recoloredFaces;
+        bool topologyChanged = false;
+    };
+    void setEditTracking(bool enabled);
+    GeometryEdits takeGeometryEdits();
+
+    // Geometry can be paged out to the project file, keeping only its local bounds so the object
+    // can still be culled and drawn as a proxy. Paging does not change the geometry revision.
+    void pageOut(const BoundingBox& localBounds);
+    void pageIn(std::vector<Vector3> newVertices, std::vector<std::array<int, 7>> newFaces);
+    bool isPagedOut() const;
+    const BoundingBox& getPagedOutBounds() const;
+
+    // Simplified meshes built from a given geometry revision; stale ones are ignored
+    void setLodLevels(std::shared_ptr<const std::vector<LodLevel>> levels, uint64_t revision);
+    int getLodLevelCount() const;
+    const LodLevel* getLodLevel(int level) const;
+    // The same level, kept alive by the pointer so other threads can read it while the object changes
+    std::shared_ptr<const LodLevel> shareLodLevel(int level) const;
+    int activeLodLevel = 0;
     void addVertex();
     void updateVertex(int vertexIndex, const Vector3& newVertexPosition);
     void deleteVertex(int vertexIndex);
+    int mergeVerticesByDistance(float tolerance);
 
     void deleteFaceByIndex(int faceIndex);
     bool isFaceSelected(unsigned int i) const;
@@ -71,10 +109,10 @@ public:
     void moveFaces(const Vector3& translation);
     void rotateFaces(float angle, char axis);
 
-    std::vector<Vector3> getVertices();
+    const std::vector<Vector3>& getVertices() const;
     std::vector<std::array<float, 3>> getVerticesForJson();
-    std::vector<std::pair<int, int>> getEdges();
-    std::vector<std::array<int, 7>> getFaces();
+    const std::vector<std::pair<int, int>>& getEdges() const;
+    const std::vector<std::array<int, 7>>& getFaces() const;
 
     std::vector<unsigned int> selectedFaces;
     std::vector<unsigned int> hoveredFaces;
@@ -87,9 +125,38 @@ public:
     bool hasFaceFromSelection() const;
     std::vector<Vector3> vertices;
     std::vector<std::array<int, 7>> faces;
-    void setPosition(Vector3& newPos);
+    void setPosition(const Vector3& newPos);
 protected:
     std::vector<std::pair<int, int>> edges;
+
+    void markGeometryChanged();
+    void markVerticesMoved(int vertexIndex);
+    void markVerticesMoved(const std::unordered_set<int>& vertexIndices);
+    void markFacesRecolored(int faceIndex);
+
+    Vector3 position;
+    Quaternion orientation;
+    Vector3 rotation;
+    Vector3 scale;
+
+private:
+    mutable Matrix4 transform;
+    mutable bool transformDirty = true;
+
+    uint64_t geometryRevision = 0;
+    bool editTracking = false;
+    GeometryEdits pendingEdits;
+    bool pagedOut = false;
+    BoundingBox pagedOutBounds;
+    std::shared_ptr<const std::vector<LodLevel>> lodLevels;
+    uint64_t lodRevision = 0;
+
+    mutable BoundingSphere localBoundingSphere{Vector3(), 0.0f};
+    mutable uint64_t boundingSphereRevision = UINT64_MAX;
+
+    void invalidateTransform();
+    void recordTopologyChange();
+    void trimPendingEdits();
 };
 
 #endif
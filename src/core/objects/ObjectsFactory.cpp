@@ -1,39 +1,22 @@
 #include "ObjectsFactory.hpp"
+#include <algorithm>
+#include <cctype>
 #include <cmath>
-#include <sstream>
-#include "../../utils/files/ObjFile.hpp"
+#include <filesystem>
+#include "../../utils/files/ObjReader.hpp"
+#include "../../utils/files/StlFile.hpp"
 #include "../../utils/files/FileManager.hpp"
-#include <unordered_map>
-#include <unordered_set>
-
-struct Triangle {
-    Vector3 v1, v2, v3;
-    std::array<int, 4> color;
-
-    bool operator==(const Triangle& other) const {
-        return (v1 == other.v1 && v2 == other.v2 && v3 == other.v3) ||
-               (v1 == other.v2 && v2 == other.v3 && v3 == other.v1) ||
-               (v1 == other.v3 && v2 == other.v1 && v3 == other.v2);
-    }
-
-    Vector3 getNormal() const;
-};
-
-struct TriangleHash {
-    std::size_t operator()(const Triangle& triangle) const {
-        std::hash<float> floatHash;
-        return floatHash(triangle.v1.x) ^ floatHash(triangle.v1.y) ^ floatHash(triangle.v1.z) ^
-               floatHash(triangle.v2.x) ^ floatHash(triangle.v2.y) ^ floatHash(triangle.v2.z) ^
-               floatHash(triangle.v3.x) ^ floatHash(triangle.v3.y) ^ floatHash(triangle.v3.z);
-    }
-};
+#include "../../utils/geometry/VertexWelder.hpp"
 
 namespace {
-    std::vector<Triangle> getTriangles(std::shared_ptr<Object3d> obj) {
-        std::vector<Triangle> triangles;
-        auto vertices = obj->getVertices();
-        auto faces = obj->getFaces();
-        auto modelMatrix = obj->getTransformation();
+    constexpr float COMBINE_WELD_TOLERANCE = 1e-5f;
+
+    std::vector<MeshTriangle> getTriangles(std::shared_ptr<Object3d> obj) {
+        std::vector<MeshTriangle> triangles;
+        triangles.reserve(obj->faces.size());
+        const auto& vertices = obj->vertices;
+        const auto& faces = obj->faces;
+        const auto& modelMatrix = obj->getTransformation();
 
         std::vector<Vector3> worldVertices(vertices.size());
         for (size_t i = 0; i < vertices.size(); ++i) {
@@ -54,27 +37,15 @@ namespace {
         return triangles;
     }
 
-    std::shared_ptr<Object3d> trianglesToObject(std::vector<Triangle>& triangles) {
-        std::vector<Vector3> vertices;
+    std::shared_ptr<Object3d> trianglesToObject(const std::vector<MeshTriangle>& triangles) {
+        VertexWelder welder(COMBINE_WELD_TOLERANCE, triangles.size() * 3);
         std::vector<std::array<int, 7>> faces;
-        std::unordered_map<std::string, int> vertexMap;
-
-        auto getVertexIndex = [&](const Vector3& v) {
-            std::string key = std::to_string(v.x) + "," +
-                            std::to_string(v.y) + "," +
-                            std::to_string(v.z);
-
-            if (vertexMap.find(key) == vertexMap.end()) {
-                vertexMap[key] = vertices.size();
-                vertices.push_back(v);
-            }
-            return vertexMap[key];
-        };
+        faces.reserve(triangles.size());
 
         for (const auto& triangle : triangles) {
-            int v1 = getVertexIndex(triangle.v1);
-            int v2 = getVertexIndex(triangle.v2);
-            int v3 = getVertexIndex(triangle.v3);
+            int v1 = welder.addVertex(triangle.v1);
+            int v2 = welder.addVertex(triangle.v2);
+            int v3 = welder.addVertex(triangle.v3);
 
             faces.push_back({v1, v2, v3,
                            triangle.color[0],
@@ -82,16 +53,20 @@ namespace {
                            triangle.color[2],
                            triangle.color[3]});
         }
-        return std::make_shared<CustomShape>(vertices, faces);
+        return std::make_shared<CustomShape>(welder.releaseVertices(), faces);
     }
 }
 
-std::shared_ptr<Object3d> ObjectsFactory::combineObjects(const std::vector<std::shared_ptr<Object3d>>& objects) {
-    std::vector<Triangle> result;
+std::shared_ptr<Object3d> ObjectsFactory::combineObjects(const std::vector<std::shared_ptr<Object3d>>& objects,
+                                                         BooleanOperation operation) {
+    if (objects.empty()) {
+        return std::make_shared<CustomShape>();
+    }
 
-    for (const auto& obj : objects) {
-        auto triangles = getTriangles(obj);
-        result.insert(result.end(), triangles.begin(), triangles.end());
+    // Difference subtracts every following object from the first one
+    std::vector<MeshTriangle> result = getTriangles(objects[0]);
+    for (size_t i = 1; i < objects.size(); ++i) {
+        result = MeshBoolean::compute(result, getTriangles(objects[i]), operation);
     }
 
     Vector3 centroid(0.0f, 0.0f, 0.0f);
@@ -377,37 +352,19 @@ CustomShape ObjectsFactory::createCustomShape(const std::vector<Vector3>& vertic
 
 CustomShape ObjectsFactory::import() {
     FileManager& fileManager = FileManager::getInstance();
-    std::string objFilePath = fileManager.selectFile();
-
-    ObjFile objFile;
-    objFile.read(objFilePath);
-
-    std::vector<Vector3> vertices;
-    for (const auto& vertexLine : objFile.getVertices()) {
-        std::istringstream stream(vertexLine);
-        std::string prefix;
-        float x, y, z;
-
-        stream >> prefix >> x >> y >> z;
-        vertices.emplace_back(Vector3(x, y, z));
-    }
-
-    std::vector<std::array<int, 7>> faces;
-    const auto& objFaces = objFile.getFaces();
-
-    for (const auto& faceLine : objFaces) {
-        std::istringstream stream(faceLine);
-        std::string prefix;
-        int v1, v2, v3, r = 128, g = 128, b = 128, a = 255;
-
-        stream >> prefix >> v1 >> v2 >> v3;
+    return importFile(fileManager.selectFile());
+}
 
-        if (stream >> r >> g >> b >> a) {
-            faces.push_back({v1 - 1, v2 - 1, v3 - 1, r, g, b, a});
-        } else {
-            faces.push_back({v1 - 1, v2 - 1, v3 - 1, 128, 128, 128, 255});
-        }
+CustomShape ObjectsFactory::importFile(const std::string& filePath) {
+    std::string extension = std::filesystem::path(filePath).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (extension == ".stl") {
+        StlFile stlFile;
+        stlFile.read(filePath);
+        return CustomShape(stlFile.releaseVertices(), stlFile.releaseFaces());
     }
 
-    return createCustomShape(vertices, faces);
-}
\ No newline at end of file
+    ObjMesh mesh = ObjReader::read(filePath);
+    return CustomShape(std::move(mesh.vertices), std::move(mesh.faces));
+}
@@ -2,10 +2,12 @@
 #define OBJECTS_FACTORY_HPP
 
 #include "CustomShape.hpp"
+#include "../../utils/geometry/MeshBoolean.hpp"
 
 class ObjectsFactory {
 public:
-    static std::shared_ptr<Object3d> combineObjects(const std::vector<std::shared_ptr<Object3d>>& objects);
+    static std::shared_ptr<Object3d> combineObjects(const std::vector<std::shared_ptr<Object3d>>& objects,
+                                                    BooleanOperation operation = BooleanOperation::Union);
 
     std::shared_ptr<Object3d> createObject(const std::string& objectType, float param1, int param2);
 
@@ -18,6 +20,8 @@ public:
     static CustomShape createCustomShape(const std::vector<Vector3>& vertices, const std::vector<std::array<int, 7>>& faces);
 
     static CustomShape import();
+    // Reads an OBJ or STL mesh, chosen by extension
+    static CustomShape importFile(const std::string& filePath);
 };
 
 #endif
\ No newline at end of file
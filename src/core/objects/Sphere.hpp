@@ -1,7 +1,7 @@
 #ifndef SPHERE_HPP
 #define SPHERE_HPP
 
-#include "Object3D.hpp"
+#include "Object3d.hpp"
 
 class Sphere : public Object3d {
 public:
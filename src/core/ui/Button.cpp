@@ -64,13 +64,10 @@ void Button::handleEvent(const sf::Event &event, const sf::RenderWindow &window)
     }
 }
 
-void Button::setIcon(std::string iconName) {
-    if (!texture.loadFromFile("../src/assets/images/icons/" + iconName + ".png")) {
-        throw std::runtime_error("Failed to load icon: " + iconName);
-    }
-    icon.setTexture(texture);
+void Button::setIcon(const std::string& iconName) {
+    float iconSize = buttonRect.getSize().y / 2.f;
+    TextureManager::getInstance().applyIcon(icon, iconName, {iconSize, iconSize});
     hasIcon = true;
-    icon.setScale(buttonRect.getSize().y / texture.getSize().y / 2.f, buttonRect.getSize().y / texture.getSize().y / 2.f);
     icon.setPosition(
         buttonRect.getPosition().x + (buttonRect.getSize().y - icon.getGlobalBounds().height) / 2.f,
         buttonRect.getPosition().y + (buttonRect.getSize().y - icon.getGlobalBounds().height) / 2.f
@@ -103,6 +100,11 @@ void Button::setColor(sf::Color color) {
     this->color = color;
 }
 
+void Button::setText(const std::string& text) {
+    buttonText.setString(text);
+    setPosition(buttonRect.getPosition());
+}
+
 
 sf::Color Button::darkenColor(const sf::Color &color, int amount) {
     return sf::Color(
@@ -137,7 +139,7 @@ void Button::setPosition(const sf::Vector2f &position) {
         );
 
         // Adjust button size if necessary to fit the icon and text
-        if (buttonRect.getSize().x < buttonRect.getSize().y * 1.5f + textBounds.width) {
+        if (buttonRect.getSize().x < buttonRect.getSize().y * 1.5f + textBounds.width && buttonText.getString() != "") {
             buttonRect.setSize({buttonRect.getSize().y * 1.5f + textBounds.width, buttonRect.getSize().y});
         }
     } else {
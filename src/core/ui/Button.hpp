@@ -4,6 +4,7 @@
 #include <SFML/Graphics.hpp>
 #include <functional>
 #include "../../utils/FontManager.hpp"
+#include "../../utils/TextureManager.hpp"
 #include "Component.hpp"
 
 struct ButtonSettings {
@@ -27,18 +28,18 @@ public:
     void setPosition(const sf::Vector2f& position) override;
 
     void setColor(sf::Color color);
+    void setText(const std::string& text);
 
-    void setIcon(std::string iconName);
+    void setIcon(const std::string& iconName);
 
 protected:
     sf::RectangleShape buttonRect;
     sf::Text buttonText;
 
     sf::Sprite icon;
-    sf::Texture texture;
 
     sf::Color color;
-    bool hasIcon;
+    bool hasIcon = false;
 
     bool inBounds(const sf::Vector2i &mousePos) const;
     sf::Color darkenColor(const sf::Color &color, int amount);
@@ -1,4 +1,4 @@
-#include "CheckBox.hpp"
+#include "Checkbox.hpp"
 
 CheckBox::CheckBox(const sf::Vector2f& position, float size, bool isChecked, const sf::Color& boxColor, const sf::Color& checkColor)
     : isChecked(isChecked), size(size), boxColor(boxColor), checkColor(checkColor) {
@@ -185,6 +185,13 @@ void Expandable::setTextColor(sf::Color color) {
     headerText.setFillColor(color);
 }
 
+void Expandable::setHeaderText(const std::string& text) {
+    headerText.setString(text);
+    sf::FloatRect textBounds = headerText.getLocalBounds();
+    headerText.setOrigin(textBounds.width / 2, textBounds.height / 2);
+    setPosition(headerRect.getPosition());
+}
+
 
 std::vector<std::shared_ptr<Component>> Expandable::getContent() const {
     return contentComponents;
@@ -27,6 +27,7 @@ public:
 
     void setColor(sf::Color color);
     void setTextColor(sf::Color color);
+    void setHeaderText(const std::string& text);
 
     std::vector<std::shared_ptr<Component>> getContent() const;
 
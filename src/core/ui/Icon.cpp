@@ -1,19 +1,10 @@
 #include "Icon.hpp"
+#include "../../utils/TextureManager.hpp"
 
 Icon::Icon(const sf::Vector2f& position, const sf::Vector2f& size, const std::string& iconName)
     : iconName(iconName) {
-    if (!texture.loadFromFile("../src/assets/images/icons/" + iconName + ".png")) {
-        throw std::runtime_error("Failed to load icon: " + iconName);
-    }
-    
-    sprite.setTexture(texture);
+    TextureManager::getInstance().applyIcon(sprite, iconName, size);
     sprite.setPosition(position);
-
-    sf::Vector2u textureSize = texture.getSize();
-    sprite.setScale(
-        size.x / textureSize.x,
-        size.y / textureSize.y
-    );
 }
 
 void Icon::draw(sf::RenderWindow& window) {
@@ -52,18 +43,16 @@ void Icon::setPosition(const sf::Vector2f& position) {
 
 void Icon::setIconName(const std::string& newIconName) {
     if (newIconName != iconName) {
+        sf::Vector2f size(sprite.getGlobalBounds().width, sprite.getGlobalBounds().height);
         iconName = newIconName;
-        if (!texture.loadFromFile(iconName)) {
-            throw std::runtime_error("Failed to load icon: " + iconName);
-        }
-        sprite.setTexture(texture);
+        TextureManager::getInstance().applyIcon(sprite, iconName, size);
     }
 }
 
 void Icon::setSize(const sf::Vector2f& size) {
-    sf::Vector2u textureSize = texture.getSize();
+    sf::IntRect rect = sprite.getTextureRect();
     sprite.setScale(
-        size.x / textureSize.x,
-        size.y / textureSize.y
+        size.x / rect.width,
+        size.y / rect.height
     );
 }
\ No newline at end of file
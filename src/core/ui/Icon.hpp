@@ -23,7 +23,6 @@ protected:
 
 private:
     sf::Sprite sprite;
-    sf::Texture texture;
     std::string iconName;
 };
 
@@ -1,7 +1,7 @@
 #include "Input.hpp"
 #include <iostream>
 #include <algorithm>
-#include <windows.h>
+#include <SFML/Window/Clipboard.hpp>
 
 Input::Input(const sf::Vector2f& position, const sf::Vector2f& size,
              const std::string& titleText, const std::string& placeholder,
@@ -84,23 +84,7 @@ void Input::handleEvent(const sf::Event& event, const sf::RenderWindow& window)
 }
 
 std::string Input::getClipboardText() const {
-    if (!OpenClipboard(nullptr)) {
-        return "";
-    }
-    HANDLE hData = GetClipboardData(CF_TEXT);
-    if (!hData) {
-        CloseClipboard();
-        return "";
-    }
-    char* pszText = static_cast<char*>(GlobalLock(hData));
-    if (!pszText) {
-        CloseClipboard();
-        return "";
-    }
-    std::string text(pszText);
-    GlobalUnlock(hData);
-    CloseClipboard();
-    return text;
+    return sf::Clipboard::getString().toAnsiString();
 }
 
 std::string Input::getValue() const {
@@ -0,0 +1,51 @@
+#include "ItemRow.hpp"
+
+ItemRow::ItemRow(const sf::Vector2f& position, const sf::Vector2f& size, const std::vector<std::string>& actionIcons)
+    : itemButton(position, {size.x - size.y * actionIcons.size(), size.y}, "") {
+    actionButtons.reserve(actionIcons.size());
+    float x = position.x + itemButton.getWidth();
+    for (const auto& icon : actionIcons) {
+        actionButtons.emplace_back(sf::Vector2f(x, position.y), sf::Vector2f(size.y, size.y), "");
+        actionButtons.back().setIcon(icon);
+        x += size.y;
+    }
+}
+
+void ItemRow::handleEvent(const sf::Event& event, const sf::RenderWindow& window) {
+    itemButton.handleEvent(event, window);
+    for (auto& button : actionButtons) {
+        button.handleEvent(event, window);
+    }
+}
+
+void ItemRow::draw(sf::RenderWindow& window) {
+    itemButton.draw(window);
+    for (auto& button : actionButtons) {
+        button.draw(window);
+    }
+}
+
+float ItemRow::getHeight() const {
+    return itemButton.getHeight();
+}
+
+sf::Vector2f ItemRow::getPosition() const {
+    return itemButton.getPosition();
+}
+
+void ItemRow::setPosition(const sf::Vector2f& position) {
+    itemButton.setPosition(position);
+    float x = position.x + itemButton.getWidth();
+    for (auto& button : actionButtons) {
+        button.setPosition({x, position.y});
+        x += button.getWidth();
+    }
+}
+
+Button& ItemRow::getItemButton() {
+    return itemButton;
+}
+
+Button& ItemRow::getActionButton(size_t index) {
+    return actionButtons.at(index);
+}
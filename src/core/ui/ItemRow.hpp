@@ -0,0 +1,32 @@
+#ifndef ITEM_ROW_HPP
+#define ITEM_ROW_HPP
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+#include "Button.hpp"
+#include "Component.hpp"
+
+// A list row: a button for the item followed by square icon buttons for its actions. Meant to
+// be rebound to another item when a virtual ScrollView recycles it.
+class ItemRow : public Component {
+public:
+    ItemRow(const sf::Vector2f& position, const sf::Vector2f& size, const std::vector<std::string>& actionIcons = {"delete"});
+
+    void handleEvent(const sf::Event& event, const sf::RenderWindow& window) override;
+    void draw(sf::RenderWindow& window) override;
+
+    float getHeight() const override;
+    sf::Vector2f getPosition() const override;
+    void setPosition(const sf::Vector2f& position) override;
+
+    Button& getItemButton();
+    // In the order of the icons given to the constructor
+    Button& getActionButton(size_t index);
+
+private:
+    Button itemButton;
+    std::vector<Button> actionButtons;
+};
+
+#endif
@@ -3,7 +3,6 @@
 #include <sstream>
 #include <algorithm>
 #include <cmath>
-#include <windows.h>
 
 NumberInput::NumberInput(const sf::Vector2f& position, const sf::Vector2f& size,const std::string& titleText,
                          float step, const sf::Color& boxColor, const sf::Color& textColor,
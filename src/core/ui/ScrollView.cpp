@@ -46,13 +46,95 @@ void ScrollView::addComponent(std::shared_ptr<Component> component) {
 
 void ScrollView::clearComponents() {
     components.clear();
+    virtualRows = false;
+    rowCount = 0;
+    visibleRows.clear();
+    recycledRows.clear();
     scrollOffset = 0;
     updateScrollBar();
 }
 
+void ScrollView::setVirtualRows(size_t count, float height, RowFactory factory) {
+    clearComponents();
+    virtualRows = true;
+    rowHeight = height;
+    createRow = std::move(factory);
+    setRowCount(count);
+}
+
+void ScrollView::setRowCount(size_t count) {
+    rowCount = count;
+    rowsDirty = true;
+    scrollOffset = std::clamp(scrollOffset, 0.f, std::max(0.f, getTotalContentHeight() - maxHeight));
+    updateScrollBar();
+}
+
+void ScrollView::forEachVisibleRow(const std::function<void(size_t index, Component& row)>& visit) {
+    if (!virtualRows) {
+        return;
+    }
+    updateVisibleRows();
+    for (size_t k = 0; k < visibleRows.size(); ++k) {
+        visit(firstRow + k, *visibleRows[k]);
+    }
+}
+
+void ScrollView::updateVisibleRows() {
+    size_t first = std::min(rowCount, static_cast<size_t>(scrollOffset / rowHeight));
+    size_t last = std::min(rowCount, static_cast<size_t>(std::ceil((scrollOffset + maxHeight) / rowHeight)));
+    std::vector<std::shared_ptr<Component>> rows(std::max(first, last) - first);
+
+    // Rows still in view keep their item; the rest go to the pool
+    for (size_t k = 0; k < visibleRows.size(); ++k) {
+        size_t index = firstRow + k;
+        if (index >= first && index < last) {
+            rows[index - first] = std::move(visibleRows[k]);
+        } else {
+            recycledRows.push_back(std::move(visibleRows[k]));
+        }
+    }
+
+    for (size_t index = first; index < last; ++index) {
+        auto& row = rows[index - first];
+        if (!row || rowsDirty) {
+            std::shared_ptr<Component> recycled = std::move(row);
+            if (!recycled && !recycledRows.empty()) {
+                recycled = std::move(recycledRows.back());
+                recycledRows.pop_back();
+            }
+            row = createRow(index, std::move(recycled));
+        }
+
+        // Rows are placed in viewport space, so huge lists never reach imprecise float coordinates
+        float y = static_cast<float>(position.y + static_cast<double>(index) * rowHeight - scrollOffset);
+        if (row->getPosition().y != y) {
+            row->setPosition({row->getPosition().x, y});
+        }
+    }
+
+    visibleRows = std::move(rows);
+    firstRow = first;
+    rowsDirty = false;
+    if (recycledRows.size() > visibleRows.size()) {
+        recycledRows.resize(visibleRows.size());
+    }
+}
+
 void ScrollView::handleEvent(const sf::Event& event, const sf::RenderWindow& window) {
     if (!inBounds(sf::Mouse::getPosition(window))) return;
     float totalHeight = getTotalContentHeight();
+    if (virtualRows) {
+        if (totalHeight > maxHeight) {
+            handleScrolling(event, window);
+        }
+        updateVisibleRows();
+        // A row's callback may change the list
+        auto rows = visibleRows;
+        for (auto& row : rows) {
+            row->handleEvent(event, window);
+        }
+        return;
+    }
     if (totalHeight <= maxHeight) {
         for (auto& component : components) {
             component->handleEvent(event, window);
@@ -91,11 +173,15 @@ void ScrollView::handleEvent(const sf::Event& event, const sf::RenderWindow& win
 
 void ScrollView::draw(sf::RenderWindow& window) {
     window.draw(background);
-    updateComponentPositions();
+    if (virtualRows) {
+        updateVisibleRows();
+    } else {
+        updateComponentPositions();
+    }
     float totalHeight = getTotalContentHeight();
 
     // If content fits within the visible area, draw all components
-    if (totalHeight <= maxHeight) {
+    if (!virtualRows && totalHeight <= maxHeight) {
         for (const auto& component : components) {
             component->draw(window);
         }
@@ -114,12 +200,24 @@ void ScrollView::draw(sf::RenderWindow& window) {
 
     clippingView.setCenter(
         position.x + size.x / 2,
-        position.y + maxHeight / 2 + scrollOffset
+        position.y + maxHeight / 2 + (virtualRows ? 0.f : scrollOffset)
     );
 
     clippingView.setSize(size);
     window.setView(clippingView);
 
+    if (virtualRows) {
+        for (const auto& row : visibleRows) {
+            row->draw(window);
+        }
+        window.setView(originalView);
+        if (totalHeight > maxHeight) {
+            window.draw(scrollBar);
+            window.draw(scrollHandle);
+        }
+        return;
+    }
+
     float currentY = position.y - scrollOffset;
     for (const auto& component : components) {
         sf::Vector2f componentPosition = component->getPosition();
@@ -198,6 +296,9 @@ void ScrollView::updateScrollBar() {
 }
 
 float ScrollView::getTotalContentHeight() const {
+    if (virtualRows) {
+        return static_cast<float>(static_cast<double>(rowCount) * rowHeight);
+    }
     float totalHeight = 0.f;
     for (const auto& component : components) {
         totalHeight += component->getHeight();
@@ -240,6 +341,7 @@ sf::Vector2f ScrollView::getPosition() const {
 }
 
 void ScrollView::setPosition(const sf::Vector2f &newPosition) {
+    sf::Vector2f delta = newPosition - position;
     position = newPosition;
 
     // Update the position of the background
@@ -256,6 +358,12 @@ void ScrollView::setPosition(const sf::Vector2f &newPosition) {
         component->setPosition({originalPos.x, currentY});
         currentY += component->getHeight();
     }
+    for (auto& row : visibleRows) {
+        row->setPosition(row->getPosition() + delta);
+    }
+    for (auto& row : recycledRows) {
+        row->setPosition(row->getPosition() + delta);
+    }
 
     updateScrollBar();  // Ensure the scroll bar is updated after repositioning
 }
@@ -2,12 +2,17 @@
 #define SCROLL_VIEW_HPP
 
 #include <SFML/Graphics.hpp>
+#include <functional>
 #include <vector>
 #include <memory>
 #include "Component.hpp"
 
 class ScrollView : public Component {
 public:
+    // Builds the row for an item. recycled is a row that scrolled out of view, or nullptr; the
+    // factory can rebind and return it, or return a new row.
+    using RowFactory = std::function<std::shared_ptr<Component>(size_t index, std::shared_ptr<Component> recycled)>;
+
     ScrollView(const sf::Vector2f& position, const sf::Vector2f& size, float maxHeight);
 
     // Inherited from Component
@@ -21,6 +26,14 @@ public:
     // Clear all components
     void clearComponents();
 
+    // Virtual list of equally tall rows. Only the rows intersecting the viewport exist, so the
+    // cost does not depend on the number of items. Replaces any added components.
+    void setVirtualRows(size_t count, float rowHeight, RowFactory createRow);
+    // Changes the number of items and rebinds the visible rows
+    void setRowCount(size_t count);
+    // Visits the rows on screen, e.g. to restyle them without rebinding
+    void forEachVisibleRow(const std::function<void(size_t index, Component& row)>& visit);
+
     // Scroll-specific methods
     void scrollUp();
     void scrollDown();
@@ -51,9 +64,19 @@ private:
     sf::RectangleShape scrollHandle;
     bool isScrolling;
 
+    bool virtualRows = false;
+    size_t rowCount = 0;
+    float rowHeight = 0.f;
+    RowFactory createRow;
+    size_t firstRow = 0;
+    std::vector<std::shared_ptr<Component>> visibleRows;
+    std::vector<std::shared_ptr<Component>> recycledRows;
+    bool rowsDirty = false;
+
     // Calculation methods
     void updateScrollBar();
     void updateComponentPositions();
+    void updateVisibleRows();
     float getTotalContentHeight() const;
     void handleScrolling(const sf::Event &event, const sf::RenderWindow &window);
     void setBackgroundColor(const sf::Color& color);
@@ -1,4 +1,5 @@
 #include "Snackbar.hpp"
+#include <algorithm>
 
 Snackbar::Snackbar(const sf::Vector2f& position, const sf::Vector2f& size) {
     // Setup shadow
@@ -14,10 +15,24 @@ Snackbar::Snackbar(const sf::Vector2f& position, const sf::Vector2f& size) {
     messageText.setFont(font);
     messageText.setCharacterSize(static_cast<unsigned int>(size.y * 0.4f));
     messageText.setFillColor(sf::Color::White);
+
+    progressBox.setSize(size);
+    progressBox.setPosition(position);
+    progressBox.setFillColor(sf::Color(50, 50, 50, 230));
+    progressFill.setFillColor(sf::Color(70, 140, 230));
+    progressText.setFont(font);
+    progressText.setCharacterSize(static_cast<unsigned int>(size.y * 0.4f));
+    progressText.setFillColor(sf::Color::White);
 }
 
 void Snackbar::draw(sf::RenderWindow& window) {
     if (!isDisplaying || messageQueue.empty()) {
+        if (showingProgress) {
+            window.draw(shadowBox);
+            window.draw(progressBox);
+            window.draw(progressFill);
+            window.draw(progressText);
+        }
         return;
     }
 
@@ -54,6 +69,29 @@ void Snackbar::update() {
     }
 }
 
+void Snackbar::setProgress(const std::string& label, float progress) {
+    showingProgress = true;
+    progressText.setString(label + " " + std::to_string(static_cast<int>(std::clamp(progress, 0.0f, 1.0f) * 100.0f)) + "%");
+    layoutProgress(progress);
+}
+
+void Snackbar::clearProgress() {
+    showingProgress = false;
+}
+
+void Snackbar::layoutProgress(float progress) {
+    sf::Vector2f position = messageBox.getPosition();
+    sf::Vector2f size = messageBox.getSize();
+    progressBox.setPosition(position);
+
+    progressFill.setPosition(position.x, position.y + size.y - PROGRESS_BAR_HEIGHT);
+    progressFill.setSize({size.x * std::clamp(progress, 0.0f, 1.0f), PROGRESS_BAR_HEIGHT});
+
+    sf::FloatRect textBounds = progressText.getLocalBounds();
+    progressText.setOrigin(textBounds.width / 2, textBounds.height / 2 + textBounds.top);
+    progressText.setPosition(position.x + size.x / 2, position.y + size.y / 2);
+}
+
 void Snackbar::showNextMessage() {
     if (messageQueue.empty()) {
         isDisplaying = false;
@@ -93,6 +131,9 @@ sf::Vector2f Snackbar::getPosition() const {
 void Snackbar::setPosition(const sf::Vector2f& position) {
     messageBox.setPosition(position);
     updateShadowPosition();
+    if (showingProgress) {
+        layoutProgress(progressFill.getSize().x / messageBox.getSize().x);
+    }
 
     if (!messageQueue.empty()) {
         // Update text position
@@ -24,6 +24,10 @@ public:
     void addMessage(const std::string& message, const sf::Color& bgColor = sf::Color(50, 50, 50, 230));
     void update();
 
+    // Long-running task status, shown with a bar whenever no message is on screen
+    void setProgress(const std::string& label, float progress);
+    void clearProgress();
+
     float getHeight() const override;
     sf::Vector2f getPosition() const override;
     void setPosition(const sf::Vector2f& position) override;
@@ -42,12 +46,19 @@ private:
     sf::RectangleShape shadowBox;
     sf::Text messageText;
 
+    sf::RectangleShape progressBox;
+    sf::RectangleShape progressFill;
+    sf::Text progressText;
+    bool showingProgress = false;
+
     const float DISPLAY_DURATION = 2.5f;
     const float SHADOW_OFFSET = 4.0f;
+    const float PROGRESS_BAR_HEIGHT = 4.0f;
     bool isDisplaying = false;
 
     void showNextMessage();
     void updateShadowPosition();  // New helper method
+    void layoutProgress(float progress);
     bool inBounds(const sf::Vector2i& mousePos) const override;
 };
 
@@ -0,0 +1,49 @@
+#include "Thumbnail.hpp"
+#include <algorithm>
+
+Thumbnail::Thumbnail(const sf::Vector2f& position, const sf::Vector2f& size, TextureSource source)
+    : source(std::move(source)) {
+    frame.setPosition(position);
+    frame.setSize(size);
+    frame.setFillColor(sf::Color(30, 30, 30));
+}
+
+void Thumbnail::draw(sf::RenderWindow& window) {
+    window.draw(frame);
+
+    const sf::Texture* texture = source ? source() : nullptr;
+    if (!texture || texture->getSize().x == 0 || texture->getSize().y == 0) return;
+
+    sf::Vector2u textureSize = texture->getSize();
+    sf::Vector2f size = frame.getSize();
+    float scale = std::min(size.x / textureSize.x, size.y / textureSize.y);
+    sprite.setTexture(*texture, true);
+    sprite.setScale(scale, scale);
+    sprite.setPosition(
+        frame.getPosition().x + (size.x - textureSize.x * scale) * 0.5f,
+        frame.getPosition().y + (size.y - textureSize.y * scale) * 0.5f
+    );
+    window.draw(sprite);
+}
+
+void Thumbnail::handleEvent(const sf::Event& event, const sf::RenderWindow& window) {
+    if (event.type == sf::Event::MouseButtonPressed && inBounds(sf::Mouse::getPosition(window))) {
+        if (onClick) onClick();
+    }
+}
+
+bool Thumbnail::inBounds(const sf::Vector2i& mousePos) const {
+    return frame.getGlobalBounds().contains(static_cast<float>(mousePos.x), static_cast<float>(mousePos.y));
+}
+
+float Thumbnail::getHeight() const {
+    return frame.getSize().y;
+}
+
+sf::Vector2f Thumbnail::getPosition() const {
+    return frame.getPosition();
+}
+
+void Thumbnail::setPosition(const sf::Vector2f& position) {
+    frame.setPosition(position);
+}
@@ -0,0 +1,32 @@
+#ifndef THUMBNAIL_HPP
+#define THUMBNAIL_HPP
+
+#include <SFML/Graphics.hpp>
+#include <functional>
+#include "Component.hpp"
+
+// Draws a texture fitted into a frame. The texture is asked for on every draw, so a source that
+// loads in the background is only asked once the thumbnail is actually on screen.
+class Thumbnail : public Component {
+public:
+    using TextureSource = std::function<const sf::Texture*()>;
+
+    Thumbnail(const sf::Vector2f& position, const sf::Vector2f& size, TextureSource source);
+
+    void draw(sf::RenderWindow& window) override;
+    void handleEvent(const sf::Event& event, const sf::RenderWindow& window) override;
+
+    float getHeight() const override;
+    sf::Vector2f getPosition() const override;
+    void setPosition(const sf::Vector2f& position) override;
+
+protected:
+    bool inBounds(const sf::Vector2i& mousePos) const override;
+
+private:
+    sf::RectangleShape frame;
+    sf::Sprite sprite;
+    TextureSource source;
+};
+
+#endif
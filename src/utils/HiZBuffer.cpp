@@ -0,0 +1,193 @@
+#include "HiZBuffer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+constexpr float EMPTY_DEPTH = std::numeric_limits<float>::infinity();
+constexpr int MAX_REFINEMENTS = 2;
+constexpr unsigned int TARGET_TEXEL_SPAN = 4;
+}
+
+void HiZBuffer::resize(unsigned int viewportWidth, unsigned int viewportHeight) {
+    if (viewportWidth == 0 || viewportHeight == 0) {
+        width = height = 0;
+        depths.clear();
+        levels.clear();
+        return;
+    }
+
+    unsigned int newWidth = std::min(BASE_WIDTH, viewportWidth);
+    unsigned int newHeight = std::max(1u, static_cast<unsigned int>(std::lround(
+        static_cast<double>(newWidth) * viewportHeight / viewportWidth)));
+    scaleX = static_cast<float>(newWidth) / viewportWidth;
+    scaleY = static_cast<float>(newHeight) / viewportHeight;
+    if (newWidth == width && newHeight == height) return;
+
+    width = newWidth;
+    height = newHeight;
+    depths.assign(static_cast<size_t>(width) * height, EMPTY_DEPTH);
+
+    levels.clear();
+    unsigned int levelWidth = width;
+    unsigned int levelHeight = height;
+    while (true) {
+        Level level;
+        level.width = levelWidth;
+        level.height = levelHeight;
+        level.nearest.assign(static_cast<size_t>(levelWidth) * levelHeight, EMPTY_DEPTH);
+        level.farthest.assign(static_cast<size_t>(levelWidth) * levelHeight, EMPTY_DEPTH);
+        levels.push_back(std::move(level));
+        if (levelWidth == 1 && levelHeight == 1) break;
+        levelWidth = (levelWidth + 1) / 2;
+        levelHeight = (levelHeight + 1) / 2;
+    }
+}
+
+void HiZBuffer::clear() {
+    std::fill(depths.begin(), depths.end(), EMPTY_DEPTH);
+    empty = true;
+}
+
+void HiZBuffer::rasterizeTriangle(float x1, float y1, float z1,
+                                  float x2, float y2, float z2,
+                                  float x3, float y3, float z3) {
+    if (width == 0 || z1 <= 0.0f || z2 <= 0.0f || z3 <= 0.0f) return;
+
+    x1 *= scaleX; x2 *= scaleX; x3 *= scaleX;
+    y1 *= scaleY; y2 *= scaleY; y3 *= scaleY;
+
+    float area = (x2 - x1) * (y3 - y1) - (x3 - x1) * (y2 - y1);
+    if (std::abs(area) < 1e-6f) return;
+    if (area < 0.0f) {
+        std::swap(x2, x3);
+        std::swap(y2, y3);
+        std::swap(z2, z3);
+        area = -area;
+    }
+
+    // Edge functions and 1/z are both affine in screen space
+    auto edge = [](float ax, float ay, float bx, float by, float px, float py) {
+        return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+    };
+    float w1 = 1.0f / z1, w2 = 1.0f / z2, w3 = 1.0f / z3;
+
+    int minX = std::max(0, static_cast<int>(std::floor(std::min({x1, x2, x3}))));
+    int minY = std::max(0, static_cast<int>(std::floor(std::min({y1, y2, y3}))));
+    int maxX = std::min(static_cast<int>(width) - 1, static_cast<int>(std::ceil(std::max({x1, x2, x3}))) - 1);
+    int maxY = std::min(static_cast<int>(height) - 1, static_cast<int>(std::ceil(std::max({y1, y2, y3}))) - 1);
+
+    for (int y = minY; y <= maxY; ++y) {
+        for (int x = minX; x <= maxX; ++x) {
+            float cx = x + 0.5f, cy = y + 0.5f;
+            if (edge(x2, y2, x3, y3, cx, cy) < 0.0f ||
+                edge(x3, y3, x1, y1, cx, cy) < 0.0f ||
+                edge(x1, y1, x2, y2, cx, cy) < 0.0f) continue;
+
+            // The farthest depth over the texel lies on one of its corners
+            float farthest = 0.0f;
+            for (int corner = 0; corner < 4; ++corner) {
+                float px = static_cast<float>(x + (corner & 1));
+                float py = static_cast<float>(y + (corner >> 1));
+                float inverseDepth = (edge(x2, y2, x3, y3, px, py) * w1 +
+                                      edge(x3, y3, x1, y1, px, py) * w2 +
+                                      edge(x1, y1, x2, y2, px, py) * w3) / area;
+                farthest = std::max(farthest, inverseDepth > 0.0f ? 1.0f / inverseDepth : EMPTY_DEPTH);
+            }
+
+            float& stored = depths[static_cast<size_t>(y) * width + x];
+            if (farthest < stored) {
+                stored = farthest;
+                empty = false;
+            }
+        }
+    }
+}
+
+void HiZBuffer::buildPyramid() {
+    if (levels.empty()) return;
+
+    levels[0].nearest = depths;
+    levels[0].farthest = depths;
+
+    for (size_t i = 1; i < levels.size(); ++i) {
+        const Level& source = levels[i - 1];
+        Level& target = levels[i];
+        for (unsigned int y = 0; y < target.height; ++y) {
+            for (unsigned int x = 0; x < target.width; ++x) {
+                float nearest = EMPTY_DEPTH;
+                float farthest = 0.0f;
+                for (unsigned int dy = 0; dy < 2; ++dy) {
+                    for (unsigned int dx = 0; dx < 2; ++dx) {
+                        unsigned int sx = std::min(x * 2 + dx, source.width - 1);
+                        unsigned int sy = std::min(y * 2 + dy, source.height - 1);
+                        size_t index = static_cast<size_t>(sy) * source.width + sx;
+                        nearest = std::min(nearest, source.nearest[index]);
+                        farthest = std::max(farthest, source.farthest[index]);
+                    }
+                }
+                size_t index = static_cast<size_t>(y) * target.width + x;
+                target.nearest[index] = nearest;
+                target.farthest[index] = farthest;
+            }
+        }
+    }
+}
+
+bool HiZBuffer::isRectOccluded(float minX, float minY, float maxX, float maxY, float nearestDepth) const {
+    if (empty || levels.empty()) return false;
+
+    minX *= scaleX; maxX *= scaleX;
+    minY *= scaleY; maxY *= scaleY;
+    if (maxX < 0.0f || maxY < 0.0f || minX >= width || minY >= height) return false;
+
+    // Grown by a texel because occluder silhouettes are sampled at texel centres
+    int x0 = std::max(0, static_cast<int>(std::floor(minX)) - 1);
+    int y0 = std::max(0, static_cast<int>(std::floor(minY)) - 1);
+    int x1 = std::min(static_cast<int>(width) - 1, static_cast<int>(std::floor(maxX)) + 1);
+    int y1 = std::min(static_cast<int>(height) - 1, static_cast<int>(std::floor(maxY)) + 1);
+
+    unsigned int span = static_cast<unsigned int>(std::max(x1 - x0, y1 - y0) + 1);
+    int levelIndex = 0;
+    while (span > TARGET_TEXEL_SPAN && levelIndex + 1 < static_cast<int>(levels.size())) {
+        span = (span + 1) / 2;
+        levelIndex++;
+    }
+
+    // Start coarse; only descend while the answer is ambiguous
+    for (int refinement = 0; refinement <= MAX_REFINEMENTS && levelIndex >= 0; ++refinement, --levelIndex) {
+        const Level& level = levels[levelIndex];
+        int lx0 = x0 >> levelIndex, lx1 = x1 >> levelIndex;
+        int ly0 = y0 >> levelIndex, ly1 = y1 >> levelIndex;
+
+        float nearest = EMPTY_DEPTH;
+        float farthest = 0.0f;
+        for (int y = ly0; y <= ly1; ++y) {
+            for (int x = lx0; x <= lx1; ++x) {
+                size_t index = static_cast<size_t>(y) * level.width + x;
+                nearest = std::min(nearest, level.nearest[index]);
+                farthest = std::max(farthest, level.farthest[index]);
+            }
+        }
+
+        if (nearestDepth > farthest) return true;
+        if (nearestDepth <= nearest) return false;
+    }
+    return false;
+}
+
+unsigned int HiZBuffer::getWidth() const {
+    return width;
+}
+
+unsigned int HiZBuffer::getHeight() const {
+    return height;
+}
+
+const std::vector<float>& HiZBuffer::getDepths() const {
+    return depths;
+}
+
+bool HiZBuffer::isEmpty() const {
+    return empty;
+}
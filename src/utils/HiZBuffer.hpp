@@ -0,0 +1,48 @@
+#ifndef HIZ_BUFFER_HPP
+#define HIZ_BUFFER_HPP
+
+#include <vector>
+
+// Low-resolution CPU depth buffer for occlusion culling. Depths are view-space
+// distances; each mip level stores the nearest and farthest depth of the texels below it.
+class HiZBuffer {
+public:
+    static constexpr unsigned int BASE_WIDTH = 256;
+
+    void resize(unsigned int viewportWidth, unsigned int viewportHeight);
+    void clear();
+
+    // Vertices are in viewport pixels. Texels whose centre is covered store the farthest
+    // depth the triangle reaches inside them.
+    void rasterizeTriangle(float x1, float y1, float z1,
+                           float x2, float y2, float z2,
+                           float x3, float y3, float z3);
+    void buildPyramid();
+
+    // True when a screen rectangle (viewport pixels) whose nearest depth is nearestDepth lies
+    // entirely behind already rasterized occluders.
+    bool isRectOccluded(float minX, float minY, float maxX, float maxY, float nearestDepth) const;
+
+    unsigned int getWidth() const;
+    unsigned int getHeight() const;
+    const std::vector<float>& getDepths() const;
+    bool isEmpty() const;
+
+private:
+    struct Level {
+        unsigned int width = 0;
+        unsigned int height = 0;
+        std::vector<float> nearest;
+        std::vector<float> farthest;
+    };
+
+    unsigned int width = 0;
+    unsigned int height = 0;
+    float scaleX = 1.0f;
+    float scaleY = 1.0f;
+    bool empty = true;
+    std::vector<float> depths;
+    std::vector<Level> levels;
+};
+
+#endif
@@ -1,64 +1,49 @@
 #include "LanguageManager.hpp"
+#include <iostream>
+#include <stdexcept>
 #include "./files/Config.hpp"
-#include "./files/FileManager.hpp"
-#include "./files/JsonFile.hpp"
 
-LanguageManager::LanguageManager(const std::string& languagePacksFile) {
-    FileManager& fileManager = FileManager::getInstance();
-    auto jsonFile = fileManager.createFile(FileFormat::JSON);
-    jsonFile->read(languagePacksFile);
-
-    auto jsonData = dynamic_cast<JsonFile*>(jsonFile.get())->getData();
-
-    if (!jsonData.is_array()) {
-        throw std::runtime_error("Invalid language packs format");
-    }
-
-    int index = 0;
-    for (const auto& langPack : jsonData) {
-        if (!langPack.contains("language") || !langPack.contains("showName") || !langPack.contains("words")) {
-            throw std::runtime_error("Malformed language pack");
+LanguageManager::LanguageManager() {
+    const auto& packs = getLanguagePacks();
+    std::string language = Config::getInstance().getLanguage();
+    for (size_t i = 0; i < packs.size(); ++i) {
+        if (language == packs[i].language) {
+            selectedIndex = static_cast<int>(i);
         }
-
-        std::string lang = langPack["language"];
-        languageIndexMap[lang] = index;
-        indexLanguageMap[index] = lang;
-        languagePacks.push_back(langPack);
-        index++;
     }
+    if (language != packs[selectedIndex].language) {
+        std::cerr << "Language not found: " << language << ", using " << packs[selectedIndex].language << std::endl;
+    }
+    selectedPack = &packs[selectedIndex];
 }
 
 LanguageManager& LanguageManager::getInstance() {
-    static LanguageManager instance("../src/utils/LanguagePacks.json");
+    static LanguageManager instance;
     return instance;
 }
 
 int LanguageManager::getLanguageIndex() const {
-    std::string currentLanguage = Config::getInstance().getLanguage();
-    if (languageIndexMap.find(currentLanguage) == languageIndexMap.end()) {
-        throw std::runtime_error("Language not found: " + currentLanguage);
-    }
-    return languageIndexMap.at(currentLanguage);
+    return selectedIndex;
 }
 
 void LanguageManager::setLanguageByIndex(int index) {
-    if (indexLanguageMap.find(index) == indexLanguageMap.end()) {
+    const auto& packs = getLanguagePacks();
+    if (index < 0 || static_cast<size_t>(index) >= packs.size()) {
         throw std::out_of_range("Invalid language index");
     }
-    Config::getInstance().updateLanguage(indexLanguageMap.at(index));
+    Config::getInstance().updateLanguage(packs[index].language);
+    selectedIndex = index;
+    selectedPack = &packs[index];
 }
 
-const nlohmann::json& LanguageManager::getSelectedPack() const {
-    int index = getLanguageIndex();
-    return languagePacks.at(index)["words"];
+const LanguagePack& LanguageManager::getSelectedPack() const {
+    return *selectedPack;
 }
 
 std::vector<std::string> LanguageManager::getAllLanguages() const {
     std::vector<std::string> showNames;
-    for (const auto& langPack : languagePacks) {
-        if (langPack.contains("showName")) {
-            showNames.push_back(langPack["showName"].get<std::string>());
-        }
+    for (const auto& pack : getLanguagePacks()) {
+        showNames.push_back(pack.showName);
     }
     return showNames;
 }
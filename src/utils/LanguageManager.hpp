@@ -2,10 +2,11 @@
 #define LANGUAGE_MANAGER_HPP
 
 #include <string>
-#include <unordered_map>
 #include <vector>
-#include <nlohmann/json.hpp>
+#include "LanguageTables.hpp"
 
+// Serves the language tables generated from LanguagePacks.json at build time. Switching
+// language swaps the selected pack; lookups index a table and never allocate.
 class LanguageManager {
 public:
     static LanguageManager& getInstance();
@@ -17,16 +18,15 @@ public:
 
     void setLanguageByIndex(int index);
 
-    const nlohmann::json& getSelectedPack() const;
+    const LanguagePack& getSelectedPack() const;
 
     std::vector<std::string> getAllLanguages() const;
 
 private:
-    LanguageManager(const std::string& languagePacksFile);
+    LanguageManager();
 
-    std::unordered_map<std::string, int> languageIndexMap;
-    std::unordered_map<int, std::string> indexLanguageMap;
-    std::vector<nlohmann::json> languagePacks;
+    int selectedIndex = 0;
+    const LanguagePack* selectedPack;
 };
 
 #endif
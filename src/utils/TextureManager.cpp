@@ -0,0 +1,127 @@
+#include "TextureManager.hpp"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+static const std::string ICONS_FOLDER = "../src/assets/images/icons/";
+// Transparent border around each cell, so smoothing never samples a neighbouring icon
+static constexpr unsigned int ICON_PADDING = 1;
+
+TextureManager& TextureManager::getInstance() {
+    static TextureManager instance;
+    return instance;
+}
+
+TextureManager::TextureManager() {
+    // Size the atlas for every icon on disk up front; icons are decoded the first time they are asked for
+    std::error_code error;
+    for (const auto& entry : fs::directory_iterator(ICONS_FOLDER, error)) {
+        if (entry.path().extension() == ".png") {
+            atlasCells++;
+        }
+    }
+    if (error) {
+        std::cerr << "Failed to list icons: " << error.message() << std::endl;
+    }
+    atlasCells = std::max(atlasCells, 1u);
+
+    atlasColumns = static_cast<unsigned int>(std::ceil(std::sqrt(static_cast<double>(atlasCells))));
+    unsigned int rows = (atlasCells + atlasColumns - 1) / atlasColumns;
+    unsigned int cell = ICON_SIZE + 2 * ICON_PADDING;
+    if (!atlas.create(atlasColumns * cell, rows * cell)) {
+        throw std::runtime_error("Failed to create icon atlas");
+    }
+    atlas.setSmooth(true);
+
+    sf::Image clear;
+    clear.create(atlasColumns * cell, rows * cell, sf::Color::Transparent);
+    atlas.update(clear);
+}
+
+const sf::Texture& TextureManager::getTexture(const std::string& path) {
+    auto it = textures.find(path);
+    if (it != textures.end()) {
+        return *it->second;
+    }
+
+    auto texture = std::make_unique<sf::Texture>();
+    if (!texture->loadFromFile(path)) {
+        throw std::runtime_error("Failed to load texture: " + path);
+    }
+    return *textures.emplace(path, std::move(texture)).first->second;
+}
+
+const IconRegion& TextureManager::getIcon(const std::string& iconName) {
+    auto it = icons.find(iconName);
+    if (it != icons.end()) {
+        return it->second;
+    }
+
+    sf::Image image;
+    if (!image.loadFromFile(ICONS_FOLDER + iconName + ".png")) {
+        throw std::runtime_error("Failed to load icon: " + iconName);
+    }
+    if (usedCells == atlasCells) {
+        throw std::runtime_error("Icon atlas is full: " + iconName);
+    }
+
+    unsigned int cell = ICON_SIZE + 2 * ICON_PADDING;
+    unsigned int x = (usedCells % atlasColumns) * cell + ICON_PADDING;
+    unsigned int y = (usedCells / atlasColumns) * cell + ICON_PADDING;
+    atlas.update(downscale(image, ICON_SIZE), x, y);
+    usedCells++;
+
+    IconRegion region{&atlas, sf::IntRect(x, y, ICON_SIZE, ICON_SIZE)};
+    return icons.emplace(iconName, region).first->second;
+}
+
+void TextureManager::applyIcon(sf::Sprite& sprite, const std::string& iconName, const sf::Vector2f& size) {
+    const IconRegion& region = getIcon(iconName);
+    sprite.setTexture(*region.texture);
+    sprite.setTextureRect(region.rect);
+    sprite.setScale(size.x / region.rect.width, size.y / region.rect.height);
+}
+
+sf::Image TextureManager::downscale(const sf::Image& image, unsigned int size) {
+    sf::Vector2u source = image.getSize();
+    const sf::Uint8* pixels = image.getPixelsPtr();
+    std::vector<sf::Uint8> result(size * size * 4);
+
+    // Box filter weighted by alpha, so transparent pixels don't darken the edges
+    for (unsigned int y = 0; y < size; ++y) {
+        unsigned int y0 = y * source.y / size;
+        unsigned int y1 = std::max(y0 + 1, (y + 1) * source.y / size);
+        for (unsigned int x = 0; x < size; ++x) {
+            unsigned int x0 = x * source.x / size;
+            unsigned int x1 = std::max(x0 + 1, (x + 1) * source.x / size);
+
+            double r = 0, g = 0, b = 0, a = 0;
+            for (unsigned int sy = y0; sy < y1; ++sy) {
+                const sf::Uint8* row = pixels + (static_cast<size_t>(sy) * source.x) * 4;
+                for (unsigned int sx = x0; sx < x1; ++sx) {
+                    const sf::Uint8* pixel = row + sx * 4;
+                    r += pixel[0] * pixel[3];
+                    g += pixel[1] * pixel[3];
+                    b += pixel[2] * pixel[3];
+                    a += pixel[3];
+                }
+            }
+
+            sf::Uint8* out = &result[(static_cast<size_t>(y) * size + x) * 4];
+            if (a > 0) {
+                out[0] = static_cast<sf::Uint8>(r / a + 0.5);
+                out[1] = static_cast<sf::Uint8>(g / a + 0.5);
+                out[2] = static_cast<sf::Uint8>(b / a + 0.5);
+            }
+            out[3] = static_cast<sf::Uint8>(a / ((y1 - y0) * (x1 - x0)) + 0.5);
+        }
+    }
+
+    sf::Image scaled;
+    scaled.create(size, size, result.data());
+    return scaled;
+}
@@ -0,0 +1,49 @@
+#ifndef TEXTURE_MANAGER_HPP
+#define TEXTURE_MANAGER_HPP
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// A region of the icon atlas. Cheap to copy; the texture lives as long as the manager.
+struct IconRegion {
+    const sf::Texture* texture;
+    sf::IntRect rect;
+};
+
+// Loads every texture and icon once. Icons are downscaled into cells of one atlas texture, so
+// any number of buttons can share an icon without decoding or uploading it again.
+class TextureManager {
+public:
+    static TextureManager& getInstance();
+
+    TextureManager(const TextureManager&) = delete;
+    TextureManager& operator=(const TextureManager&) = delete;
+
+    const sf::Texture& getTexture(const std::string& path);
+
+    // iconName is a file name in the icons folder, without ".png"
+    const IconRegion& getIcon(const std::string& iconName);
+
+    // Points sprite at the icon and scales it to size
+    void applyIcon(sf::Sprite& sprite, const std::string& iconName, const sf::Vector2f& size);
+
+    static constexpr unsigned int ICON_SIZE = 128;
+
+private:
+    TextureManager();
+
+    std::unordered_map<std::string, std::unique_ptr<sf::Texture>> textures;
+
+    std::unordered_map<std::string, IconRegion> icons;
+    sf::Texture atlas;
+    unsigned int atlasColumns = 0;
+    unsigned int atlasCells = 0;
+    unsigned int usedCells = 0;
+
+    static sf::Image downscale(const sf::Image& image, unsigned int size);
+};
+
+#endif
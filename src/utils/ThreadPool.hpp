@@ -0,0 +1,93 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Shared pool for background work (mesh processing, file IO). Tasks must not touch UI state.
+class ThreadPool {
+public:
+    static ThreadPool& getInstance();
+
+    explicit ThreadPool(size_t threadCount);
+    ~ThreadPool();
+
+    template <typename F>
+    auto submit(F&& task) -> std::future<decltype(task())> {
+        using Result = decltype(task());
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> future = packaged->get_future();
+        enqueue([packaged]() { (*packaged)(); });
+        return future;
+    }
+
+    // Runs body(i) for every i in [0, count) on the pool and the calling thread, returning when all
+    // are done. The caller works too, so this is safe to use from inside a pool task.
+    template <typename F>
+    void parallelFor(size_t count, F&& body) {
+        if (count == 0) return;
+        if (count == 1 || workers.empty()) {
+            for (size_t i = 0; i < count; ++i) body(i);
+            return;
+        }
+
+        struct Batch {
+            std::atomic<size_t> next{0};
+            size_t completed = 0;
+            std::exception_ptr error;
+            std::mutex mutex;
+            std::condition_variable done;
+        };
+        auto batch = std::make_shared<Batch>();
+        auto run = [batch, count, &body]() {
+            size_t index;
+            while ((index = batch->next.fetch_add(1)) < count) {
+                std::exception_ptr error;
+                try {
+                    body(index);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+                std::lock_guard<std::mutex> lock(batch->mutex);
+                if (error && !batch->error) batch->error = error;
+                if (++batch->completed == count) batch->done.notify_all();
+            }
+        };
+
+        size_t helpers = std::min(workers.size(), count - 1);
+        for (size_t i = 0; i < helpers; ++i) {
+            enqueue(run);
+        }
+        run();
+
+        std::unique_lock<std::mutex> lock(batch->mutex);
+        batch->done.wait(lock, [&]() { return batch->completed == count; });
+        if (batch->error) std::rethrow_exception(batch->error);
+    }
+
+    size_t getThreadCount() const;
+
+private:
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void enqueue(std::function<void()> task);
+    void workerLoop();
+
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping = false;
+};
+
+#endif
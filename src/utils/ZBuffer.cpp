@@ -36,7 +36,7 @@ void ZBuffer::handleVertexHover(const sf::Vector2i& mousePos, Scene& scene, cons
     for (size_t objectIndex = 1; objectIndex < objects.size(); ++objectIndex) {
         auto& object = objects[objectIndex];
 
-        auto modelMatrix = object->getTransformation();
+        const auto& modelMatrix = object->getTransformation();
         auto viewMatrix = camera.getViewMatrix();
         auto projectionMatrix = camera.getProjectionMatrix();
 
@@ -68,7 +68,7 @@ void ZBuffer::handleFaceHover(const sf::Vector2i& mousePos, Scene& scene, const
     for (size_t objectIndex = 1; objectIndex < objects.size(); ++objectIndex) {
         auto& object = objects[objectIndex];
 
-        auto modelMatrix = object->getTransformation();
+        const auto& modelMatrix = object->getTransformation();
         auto viewMatrix = camera.getViewMatrix();
         auto projectionMatrix = camera.getProjectionMatrix();
 
@@ -127,7 +127,7 @@ void ZBuffer::handleObjectHover(const sf::Vector2i& mousePos, Scene& scene, cons
 
     for (size_t i = 1; i < objects.size(); ++i) {
         auto& object = objects[i];
-        auto modelMatrix = object->getTransformation();
+        const auto& modelMatrix = object->getTransformation();
         auto viewMatrix = camera.getViewMatrix();
         auto projectionMatrix = camera.getProjectionMatrix();
 
@@ -181,7 +181,7 @@ void ZBuffer::handleVertexSelection(const sf::Vector2i& mousePos, Scene& scene,
     for (size_t objectIndex = 1; objectIndex < objects.size(); ++objectIndex) {
         auto& object = objects[objectIndex];
 
-        auto modelMatrix = object->getTransformation();
+        const auto& modelMatrix = object->getTransformation();
         auto viewMatrix = camera.getViewMatrix();
         auto projectionMatrix = camera.getProjectionMatrix();
 
@@ -225,7 +225,7 @@ void ZBuffer::handleFaceSelection(const sf::Vector2i& mousePos, Scene& scene, co
     for (size_t objectIndex = 1; objectIndex < objects.size(); ++objectIndex) {
         auto& object = objects[objectIndex];
 
-        auto modelMatrix = object->getTransformation();
+        const auto& modelMatrix = object->getTransformation();
         auto viewMatrix = camera.getViewMatrix();
         auto projectionMatrix = camera.getProjectionMatrix();
 
@@ -303,7 +303,7 @@ void ZBuffer::handleObjectSelection(const sf::Vector2i& mousePos, Scene& scene,
 
     for (size_t i = 1; i < objects.size(); ++i) {
         auto& object = objects[i];
-        auto modelMatrix = object->getTransformation();
+        const auto& modelMatrix = object->getTransformation();
         auto viewMatrix = camera.getViewMatrix();
         auto projectionMatrix = camera.getProjectionMatrix();
 
@@ -0,0 +1,575 @@
+#include "BinaryPrjFile.hpp"
+#include "BufferedWriter.hpp"
+#include "MappedFile.hpp"
+#include "../ThreadPool.hpp"
+#include "../../core/objects/Object3d.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+
+// Values are copied in and out in host byte order; MSVC only targets little-endian machines
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "BinaryPrjFile needs a little-endian host"
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+constexpr char MAGIC[8] = {'3', 'D', 'P', 'R', 'J', 'B', '\0', '\0'};
+constexpr uint64_t BLOB_ALIGNMENT = 16;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t objectCount;
+    uint64_t tableOffset;
+    float cameraPosition[3];
+    float cameraYaw;
+    float cameraPitch;
+    float cameraOrbitCenter[3];
+    uint64_t saveId;
+    uint64_t reserved;
+};
+
+struct ObjectRecord {
+    float position[3];
+    float rotation[3];
+    float scale[3];
+    uint32_t vertexCount;
+    uint32_t faceCount;
+    uint32_t flags;
+    uint64_t vertexOffset;
+    uint64_t indexOffset;
+    uint64_t colorOffset;
+    float boundsMin[3];
+    float boundsMax[3];
+    uint64_t encodedSize;
+};
+
+static_assert(sizeof(FileHeader) == 72, "FileHeader layout must not change");
+static_assert(sizeof(ObjectRecord) == 104, "ObjectRecord layout must not change");
+static_assert(sizeof(Vector3) == 3 * sizeof(float) && std::is_trivially_copyable_v<Vector3>,
+              "Vertex blobs are copied directly into Vector3 storage");
+
+// An object to save: its transform plus either geometry in memory or a section kept from the file
+struct ObjectView {
+    Vector3 position;
+    Vector3 rotation;
+    Vector3 scale;
+    const std::vector<Vector3>* vertices = nullptr;
+    const std::vector<std::array<int, 7>>* faces = nullptr;
+    std::optional<BinaryPrjSection> existing;
+    // Compressed geometry to write instead of the raw blobs
+    const std::vector<char>* encoded = nullptr;
+
+    uint32_t vertexCount() const {
+        return existing ? existing->vertexCount : static_cast<uint32_t>(vertices->size());
+    }
+
+    uint32_t faceCount() const {
+        return existing ? existing->faceCount : static_cast<uint32_t>(faces->size());
+    }
+};
+
+uint64_t alignUp(uint64_t value) {
+    return (value + BLOB_ALIGNMENT - 1) & ~(BLOB_ALIGNMENT - 1);
+}
+
+uint64_t vertexBytes(uint32_t vertexCount) {
+    return static_cast<uint64_t>(vertexCount) * 3 * sizeof(float);
+}
+
+uint64_t indexBytes(uint32_t faceCount) {
+    return static_cast<uint64_t>(faceCount) * 3 * sizeof(int32_t);
+}
+
+uint64_t colorBytes(uint32_t faceCount) {
+    return static_cast<uint64_t>(faceCount) * 4;
+}
+
+uint64_t sectionBytes(const BinaryPrjSection& section) {
+    if (section.encodedSize > 0) {
+        return alignUp(section.encodedSize);
+    }
+    return alignUp(vertexBytes(section.vertexCount)) + alignUp(indexBytes(section.faceCount)) +
+           alignUp(colorBytes(section.faceCount));
+}
+
+void storeVector(float* target, const Vector3& value) {
+    target[0] = value.x;
+    target[1] = value.y;
+    target[2] = value.z;
+}
+
+Vector3 loadVector(const float* source) {
+    return Vector3(source[0], source[1], source[2]);
+}
+
+void checkRange(uint64_t offset, uint64_t length, uint64_t fileSize) {
+    if (offset > fileSize || length > fileSize - offset) {
+        throw std::runtime_error("Project file is truncated or corrupt");
+    }
+}
+
+void checkSection(const BinaryPrjSection& section, uint64_t fileSize) {
+    if (section.encodedSize > 0) {
+        checkRange(section.vertexOffset, section.encodedSize, fileSize);
+        return;
+    }
+    checkRange(section.vertexOffset, vertexBytes(section.vertexCount), fileSize);
+    checkRange(section.indexOffset, indexBytes(section.faceCount), fileSize);
+    checkRange(section.colorOffset, colorBytes(section.faceCount), fileSize);
+}
+
+void computeBounds(const Vector3* vertices, size_t count, BinaryPrjSection& section) {
+    section.boundsMin = section.boundsMax = count > 0 ? vertices[0] : Vector3();
+    for (size_t i = 1; i < count; ++i) {
+        const Vector3& vertex = vertices[i];
+        section.boundsMin = Vector3(std::min(section.boundsMin.x, vertex.x), std::min(section.boundsMin.y, vertex.y),
+                                    std::min(section.boundsMin.z, vertex.z));
+        section.boundsMax = Vector3(std::max(section.boundsMax.x, vertex.x), std::max(section.boundsMax.y, vertex.y),
+                                    std::max(section.boundsMax.z, vertex.z));
+    }
+}
+
+// Copies one object's geometry out of the mapped file, validating its face indices
+void copyGeometry(const char* data, const BinaryPrjSection& section, std::vector<Vector3>& vertices,
+                  std::vector<std::array<int, 7>>& faces) {
+    if (section.encodedSize > 0) {
+        GeometryCodec::decode(data + section.vertexOffset, section.encodedSize, section.vertexCount,
+                              section.faceCount, section.boundsMin, section.boundsMax, vertices, faces);
+        return;
+    }
+
+    vertices.resize(section.vertexCount);
+    std::memcpy(vertices.data(), data + section.vertexOffset, vertexBytes(section.vertexCount));
+
+    const char* indices = data + section.indexOffset;
+    const auto* colors = reinterpret_cast<const uint8_t*>(data + section.colorOffset);
+    faces.resize(section.faceCount);
+    for (uint32_t face = 0; face < section.faceCount; ++face) {
+        int32_t corners[3];
+        std::memcpy(corners, indices + face * sizeof(corners), sizeof(corners));
+        for (int32_t corner : corners) {
+            if (corner < 0 || static_cast<uint32_t>(corner) >= section.vertexCount) {
+                throw std::runtime_error("Project file has an out-of-range face index");
+            }
+        }
+        const uint8_t* color = colors + face * 4;
+        faces[face] = {corners[0], corners[1], corners[2], color[0], color[1], color[2], color[3]};
+    }
+}
+
+// Only the released layout is read; files from development builds before it are rejected
+void checkVersion(const FileHeader& header, const std::string& filename) {
+    if (header.version > BinaryPrjFile::VERSION) {
+        throw std::runtime_error("Project file was written by a newer version: " + filename);
+    }
+    if (header.version < BinaryPrjFile::VERSION) {
+        throw std::runtime_error("Unsupported project file version: " + filename);
+    }
+}
+
+// Reads the header and object table, and each object's geometry too when withGeometry is set
+ProjectData parseProject(const MappedFile& file, const std::string& filename, bool withGeometry,
+                         std::vector<BinaryPrjSection>* sections) {
+    const char* data = file.data();
+    uint64_t fileSize = file.size();
+
+    checkRange(0, sizeof(FileHeader), fileSize);
+    FileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Not a binary project file: " + filename);
+    }
+    checkVersion(header, filename);
+    checkRange(header.tableOffset, static_cast<uint64_t>(header.objectCount) * sizeof(ObjectRecord), fileSize);
+
+    ProjectData project;
+    project.saveId = header.saveId;
+    project.camera.position = loadVector(header.cameraPosition);
+    project.camera.yaw = header.cameraYaw;
+    project.camera.pitch = header.cameraPitch;
+    project.camera.orbitCenter = loadVector(header.cameraOrbitCenter);
+
+    project.objects.resize(header.objectCount);
+    std::vector<BinaryPrjSection> records(header.objectCount);
+    for (uint32_t i = 0; i < header.objectCount; ++i) {
+        ObjectRecord record;
+        std::memcpy(&record, data + header.tableOffset + i * sizeof(ObjectRecord), sizeof(record));
+
+        BinaryPrjSection& section = records[i];
+        section = {record.vertexCount, record.faceCount,
+                   record.vertexOffset, record.indexOffset, record.colorOffset,
+                   loadVector(record.boundsMin), loadVector(record.boundsMax), record.encodedSize};
+        checkSection(section, fileSize);
+
+        ProjectObject& object = project.objects[i];
+        object.position = loadVector(record.position);
+        object.rotation = loadVector(record.rotation);
+        object.scale = loadVector(record.scale);
+    }
+
+    // Compressed objects cost more to unpack than to copy, so they are spread over the pool
+    if (withGeometry) {
+        ThreadPool::getInstance().parallelFor(records.size(), [&](size_t i) {
+            copyGeometry(data, records[i], project.objects[i].vertices, project.objects[i].faces);
+        });
+    }
+    if (sections) {
+        *sections = std::move(records);
+    }
+    return project;
+}
+
+FileHeader makeHeader(uint64_t saveId, const ProjectCamera& camera, size_t objectCount, uint64_t tableOffset) {
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.saveId = saveId;
+    header.version = BinaryPrjFile::VERSION;
+    header.objectCount = static_cast<uint32_t>(objectCount);
+    header.tableOffset = tableOffset;
+    storeVector(header.cameraPosition, camera.position);
+    header.cameraYaw = camera.yaw;
+    header.cameraPitch = camera.pitch;
+    storeVector(header.cameraOrbitCenter, camera.orbitCenter);
+    return header;
+}
+
+FileHeader readHeader(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    FileHeader header{};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Not a binary project file: " + filename);
+    }
+    checkVersion(header, filename);
+    return header;
+}
+
+// Places the blobs of every object that needs writing one after another from offset, which is
+// left at the end of the last blob. With keepExisting, objects carrying a section keep it as is.
+std::vector<BinaryPrjSection> layoutSections(const std::vector<ObjectView>& objects, bool keepExisting,
+                                             uint64_t& offset) {
+    std::vector<BinaryPrjSection> sections(objects.size());
+    for (size_t i = 0; i < objects.size(); ++i) {
+        const ObjectView& object = objects[i];
+        if (keepExisting && object.existing) {
+            sections[i] = *object.existing;
+            continue;
+        }
+
+        BinaryPrjSection& section = sections[i];
+        if (object.existing) {
+            section.boundsMin = object.existing->boundsMin;
+            section.boundsMax = object.existing->boundsMax;
+            section.encodedSize = object.existing->encodedSize;
+        } else {
+            computeBounds(object.vertices->data(), object.vertices->size(), section);
+            section.encodedSize = object.encoded ? object.encoded->size() : 0;
+        }
+        section.vertexCount = object.vertexCount();
+        section.faceCount = object.faceCount();
+        section.vertexOffset = alignUp(offset);
+        if (section.encodedSize > 0) {
+            section.indexOffset = section.colorOffset = section.vertexOffset;
+            offset = section.vertexOffset + section.encodedSize;
+            continue;
+        }
+        section.indexOffset = alignUp(section.vertexOffset + vertexBytes(section.vertexCount));
+        section.colorOffset = alignUp(section.indexOffset + indexBytes(section.faceCount));
+        offset = section.colorOffset + colorBytes(section.faceCount);
+    }
+    return sections;
+}
+
+std::vector<ObjectRecord> makeRecords(const std::vector<ObjectView>& objects,
+                                      const std::vector<BinaryPrjSection>& sections) {
+    std::vector<ObjectRecord> records(objects.size());
+    for (size_t i = 0; i < objects.size(); ++i) {
+        ObjectRecord& record = records[i];
+        storeVector(record.position, objects[i].position);
+        storeVector(record.rotation, objects[i].rotation);
+        storeVector(record.scale, objects[i].scale);
+        record.vertexCount = sections[i].vertexCount;
+        record.faceCount = sections[i].faceCount;
+        record.vertexOffset = sections[i].vertexOffset;
+        record.indexOffset = sections[i].indexOffset;
+        record.colorOffset = sections[i].colorOffset;
+        storeVector(record.boundsMin, sections[i].boundsMin);
+        storeVector(record.boundsMax, sections[i].boundsMax);
+        record.encodedSize = sections[i].encodedSize;
+    }
+    return records;
+}
+
+// Compresses the geometry of every object that is written from memory, filling in its encoded
+// stream from the returned storage
+std::vector<std::vector<char>> encodeViews(std::vector<ObjectView>& objects, const GeometryEncoding& encoding) {
+    std::vector<std::vector<char>> encoded(objects.size());
+    if (!encoding.compressed) {
+        return encoded;
+    }
+    ThreadPool::getInstance().parallelFor(objects.size(), [&](size_t i) {
+        ObjectView& object = objects[i];
+        if (object.existing) {
+            return;
+        }
+        BinaryPrjSection bounds;
+        computeBounds(object.vertices->data(), object.vertices->size(), bounds);
+        encoded[i] = GeometryCodec::encode(*object.vertices, *object.faces, bounds.boundsMin, bounds.boundsMax,
+                                           encoding.positionBits);
+        object.encoded = &encoded[i];
+    });
+    return encoded;
+}
+
+// Tracks the absolute file offset of a BufferedWriter so blobs can be padded into place
+class BlobWriter {
+public:
+    BlobWriter(BufferedWriter& writer, uint64_t offset) : writer(writer), written(offset) {}
+
+    void write(const void* bytes, size_t length) {
+        writer.write(std::string_view(static_cast<const char*>(bytes), length));
+        written += length;
+    }
+
+    void padTo(uint64_t target) {
+        while (written < target) {
+            writer.write('\0');
+            ++written;
+        }
+    }
+
+    uint64_t getOffset() const {
+        return written;
+    }
+
+private:
+    BufferedWriter& writer;
+    uint64_t written;
+};
+
+// Writes one object's blobs at its section, from memory or copied from the old file in source
+void writeBlobs(BlobWriter& writer, const ObjectView& object, const BinaryPrjSection& section, const char* source) {
+    if (object.existing) {
+        if (!source) {
+            throw std::logic_error("Kept sections need the previous project file to copy from");
+        }
+        writer.padTo(section.vertexOffset);
+        if (section.encodedSize > 0) {
+            writer.write(source + object.existing->vertexOffset, section.encodedSize);
+            return;
+        }
+        writer.write(source + object.existing->vertexOffset, vertexBytes(section.vertexCount));
+        writer.padTo(section.indexOffset);
+        writer.write(source + object.existing->indexOffset, indexBytes(section.faceCount));
+        writer.padTo(section.colorOffset);
+        writer.write(source + object.existing->colorOffset, colorBytes(section.faceCount));
+        return;
+    }
+
+    writer.padTo(section.vertexOffset);
+    if (object.encoded) {
+        writer.write(object.encoded->data(), object.encoded->size());
+        return;
+    }
+    writer.write(object.vertices->data(), vertexBytes(section.vertexCount));
+
+    writer.padTo(section.indexOffset);
+    for (const auto& face : *object.faces) {
+        int32_t corners[3] = {face[0], face[1], face[2]};
+        writer.write(corners, sizeof(corners));
+    }
+
+    writer.padTo(section.colorOffset);
+    for (const auto& face : *object.faces) {
+        uint8_t color[4] = {
+            static_cast<uint8_t>(face[3]), static_cast<uint8_t>(face[4]),
+            static_cast<uint8_t>(face[5]), static_cast<uint8_t>(face[6])
+        };
+        writer.write(color, sizeof(color));
+    }
+}
+
+// Writes a complete, compact file to a temporary path and returns it. Kept sections are copied
+// from source, the mapped previous file.
+std::string writeTemporary(const std::string& filename, uint64_t saveId, const ProjectCamera& camera,
+                           const std::vector<ObjectView>& objects, const char* source,
+                           const BinaryPrjFile::ProgressCallback& onProgress,
+                           std::vector<BinaryPrjSection>& sections) {
+    uint64_t offset = sizeof(FileHeader);
+    sections = layoutSections(objects, false, offset);
+    uint64_t tableOffset = alignUp(offset);
+    uint64_t fileSize = tableOffset + objects.size() * sizeof(ObjectRecord);
+    FileHeader header = makeHeader(saveId, camera, objects.size(), tableOffset);
+    std::vector<ObjectRecord> records = makeRecords(objects, sections);
+
+    std::string tempFilename = filename + ".tmp";
+    try {
+        BufferedWriter output(tempFilename);
+        BlobWriter writer(output, 0);
+        writer.write(&header, sizeof(header));
+        for (size_t i = 0; i < objects.size(); ++i) {
+            writeBlobs(writer, objects[i], sections[i], source);
+            if (onProgress) {
+                onProgress(static_cast<float>(static_cast<double>(writer.getOffset()) / static_cast<double>(fileSize)));
+            }
+        }
+        writer.padTo(tableOffset);
+        writer.write(records.data(), records.size() * sizeof(ObjectRecord));
+        // Otherwise the rename can reach the disk before the data and a power loss truncates the project
+        output.sync();
+        output.close();
+    } catch (...) {
+        std::error_code error;
+        fs::remove(tempFilename, error);
+        throw;
+    }
+    return tempFilename;
+}
+
+void replaceWith(const std::string& tempFilename, const std::string& filename) {
+    try {
+        fs::rename(tempFilename, filename);
+    } catch (...) {
+        std::error_code error;
+        fs::remove(tempFilename, error);
+        throw;
+    }
+}
+
+std::vector<BinaryPrjSection> writeViews(const std::string& filename, uint64_t saveId, const ProjectCamera& camera,
+                                         const std::vector<ObjectView>& objects,
+                                         const BinaryPrjFile::ProgressCallback& onProgress) {
+    std::vector<BinaryPrjSection> sections;
+    replaceWith(writeTemporary(filename, saveId, camera, objects, nullptr, onProgress, sections), filename);
+    return sections;
+}
+}
+
+bool BinaryPrjFile::isBinary(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    char magic[sizeof(MAGIC)] = {};
+    return file.read(magic, sizeof(magic)) && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+ProjectData BinaryPrjFile::read(const std::string& filename, std::vector<BinaryPrjSection>* sections) {
+    MappedFile file(filename);
+    return parseProject(file, filename, true, sections);
+}
+
+ProjectData BinaryPrjFile::readHeaders(const std::string& filename, std::vector<BinaryPrjSection>& sections) {
+    MappedFile file(filename);
+    return parseProject(file, filename, false, &sections);
+}
+
+void BinaryPrjFile::readGeometry(const std::string& filename, const BinaryPrjSection& section,
+                                 std::vector<Vector3>& vertices, std::vector<std::array<int, 7>>& faces) {
+    MappedFile file(filename);
+    checkSection(section, file.size());
+    copyGeometry(file.data(), section, vertices, faces);
+}
+
+std::vector<BinaryPrjSection> BinaryPrjFile::write(const std::string& filename, const ProjectCamera& camera,
+                                                   const std::vector<std::shared_ptr<Object3d>>& objects,
+                                                   const ProgressCallback& onProgress) {
+    std::vector<ObjectView> views;
+    views.reserve(objects.size());
+    for (const auto& object : objects) {
+        views.push_back({object->getPosition(), object->getRotation(), object->getScale(),
+                         &object->getVertices(), &object->getFaces(), std::nullopt});
+    }
+    return writeViews(filename, 0, camera, views, onProgress);
+}
+
+std::vector<BinaryPrjSection> BinaryPrjFile::write(const std::string& filename, const ProjectData& project,
+                                                   const ProgressCallback& onProgress,
+                                                   const GeometryEncoding& encoding) {
+    std::vector<ObjectView> views;
+    views.reserve(project.objects.size());
+    for (const auto& object : project.objects) {
+        views.push_back({object.position, object.rotation, object.scale, &object.vertices, &object.faces,
+                         std::nullopt});
+    }
+    std::vector<std::vector<char>> encoded = encodeViews(views, encoding);
+    return writeViews(filename, project.saveId, project.camera, views, onProgress);
+}
+
+std::vector<BinaryPrjSection> BinaryPrjFile::update(const std::string& filename, const ProjectData& project,
+                                                    const SectionReuse& reuse, const ProgressCallback& onProgress,
+                                                    const GeometryEncoding& encoding) {
+    if (reuse.size() != project.objects.size()) {
+        throw std::invalid_argument("Section reuse list must match the project objects");
+    }
+
+    std::vector<ObjectView> views;
+    views.reserve(project.objects.size());
+    for (size_t i = 0; i < project.objects.size(); ++i) {
+        const ProjectObject& object = project.objects[i];
+        views.push_back({object.position, object.rotation, object.scale, &object.vertices, &object.faces, reuse[i]});
+    }
+
+    readHeader(filename);
+    uint64_t fileSize = fs::file_size(filename);
+    for (const auto& object : views) {
+        if (object.existing) {
+            checkSection(*object.existing, fileSize);
+        }
+    }
+    std::vector<std::vector<char>> encoded = encodeViews(views, encoding);
+
+    uint64_t offset = fileSize;
+    std::vector<BinaryPrjSection> sections = layoutSections(views, true, offset);
+    uint64_t liveBytes = sizeof(FileHeader) + views.size() * sizeof(ObjectRecord);
+    for (const auto& section : sections) {
+        liveBytes += sectionBytes(section);
+    }
+    uint64_t tableOffset = alignUp(offset);
+    uint64_t newSize = tableOffset + views.size() * sizeof(ObjectRecord);
+
+    uint64_t deadBytes = newSize > liveBytes ? newSize - liveBytes : 0;
+    if (static_cast<double>(deadBytes) > static_cast<double>(liveBytes) * COMPACTION_RATIO) {
+        std::string tempFilename;
+        {
+            MappedFile source(filename);
+            tempFilename = writeTemporary(filename, project.saveId, project.camera, views, source.data(), onProgress,
+                                          sections);
+        }
+        replaceWith(tempFilename, filename);
+        return sections;
+    }
+
+    std::vector<ObjectRecord> records = makeRecords(views, sections);
+    {
+        BufferedWriter output(filename, BufferedWriter::Mode::Append);
+        BlobWriter writer(output, fileSize);
+        for (size_t i = 0; i < views.size(); ++i) {
+            if (!views[i].existing) {
+                writeBlobs(writer, views[i], sections[i], nullptr);
+                if (onProgress) {
+                    onProgress(static_cast<float>(static_cast<double>(writer.getOffset() - fileSize) /
+                                                  static_cast<double>(newSize - fileSize)));
+                }
+            }
+        }
+        writer.padTo(tableOffset);
+        writer.write(records.data(), records.size() * sizeof(ObjectRecord));
+        output.sync();
+        output.close();
+    }
+
+    // The old header still describes a complete project until this single write lands
+    FileHeader header = makeHeader(project.saveId, project.camera, views.size(), tableOffset);
+    std::fstream file(filename, std::ios::in | std::ios::out | std::ios::binary);
+    if (!file.write(reinterpret_cast<const char*>(&header), sizeof(header)) || !file.flush()) {
+        throw std::runtime_error("Could not update project header: " + filename);
+    }
+    if (onProgress) {
+        onProgress(1.0f);
+    }
+    return sections;
+}
@@ -0,0 +1,73 @@
+#ifndef BINARY_PRJ_FILE_HPP
+#define BINARY_PRJ_FILE_HPP
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include "GeometryCodec.hpp"
+#include "ProjectData.hpp"
+
+class Object3d;
+
+// Where one object's vertex, index and colour blobs live inside a binary project file, plus the
+// local bounds of its vertices so the object can be placed without reading them
+struct BinaryPrjSection {
+    uint32_t vertexCount = 0;
+    uint32_t faceCount = 0;
+    uint64_t vertexOffset = 0;
+    uint64_t indexOffset = 0;
+    uint64_t colorOffset = 0;
+    Vector3 boundsMin;
+    Vector3 boundsMax;
+    // Non-zero when the geometry is a single GeometryCodec stream of this size at vertexOffset
+    uint64_t encodedSize = 0;
+};
+
+// Binary project container: a header, per-object vertex, index and colour blobs aligned to
+// 16 bytes and an object table pointing at them. Reading maps the file and copies each blob in
+// one go. Values are copied in the host's byte order, so the format is little-endian and only
+// little-endian hosts are supported. Full writes go to a temporary file that is synced to disk
+// and then replaces the target, so an interrupted save never leaves a truncated project.
+class BinaryPrjFile {
+public:
+    // The first released layout; files with any other version are rejected
+    static constexpr uint32_t VERSION = 3;
+    // update() compacts once unreferenced bytes exceed this share of the referenced ones
+    static constexpr double COMPACTION_RATIO = 0.5;
+
+    // Receives the written fraction of the file, from 0 to 1
+    using ProgressCallback = std::function<void(float)>;
+    // Per object, a section already in the file to keep instead of writing its geometry again
+    using SectionReuse = std::vector<std::optional<BinaryPrjSection>>;
+
+    static bool isBinary(const std::string& filename);
+
+    static ProjectData read(const std::string& filename, std::vector<BinaryPrjSection>* sections = nullptr);
+    // Reads the camera and object transforms only, leaving every object's geometry empty
+    static ProjectData readHeaders(const std::string& filename, std::vector<BinaryPrjSection>& sections);
+    // Reads one object's geometry from a section returned by readHeaders or a save
+    static void readGeometry(const std::string& filename, const BinaryPrjSection& section,
+                             std::vector<Vector3>& vertices, std::vector<std::array<int, 7>>& faces);
+
+    // Each write returns the sections of the objects in the order they were given
+    static std::vector<BinaryPrjSection> write(const std::string& filename, const ProjectCamera& camera,
+                                               const std::vector<std::shared_ptr<Object3d>>& objects,
+                                               const ProgressCallback& onProgress = {});
+    static std::vector<BinaryPrjSection> write(const std::string& filename, const ProjectData& project,
+                                               const ProgressCallback& onProgress = {},
+                                               const GeometryEncoding& encoding = {});
+
+    // Appends the objects without a reusable section plus a new object table, then points the
+    // header at it; objects with one only need their transform. Falls back to a compacting
+    // rewrite, copying kept sections from the old file, when too much of the file is unreferenced.
+    // encoding applies to the geometry written; kept sections stay as they were stored.
+    static std::vector<BinaryPrjSection> update(const std::string& filename, const ProjectData& project,
+                                                const SectionReuse& reuse,
+                                                const ProgressCallback& onProgress = {},
+                                                const GeometryEncoding& encoding = {});
+};
+
+#endif
@@ -0,0 +1,107 @@
+#include "BufferedWriter.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr size_t MAX_NUMBER_LENGTH = 32;
+}
+
+BufferedWriter::BufferedWriter(const std::string& filename, Mode mode, size_t bufferSize)
+    : filename(filename), buffer(std::max<size_t>(bufferSize, MAX_NUMBER_LENGTH)) {
+    file = std::fopen(filename.c_str(), mode == Mode::Append ? "ab" : "wb");
+    if (!file) {
+        throw std::runtime_error("Could not open file for writing: " + filename);
+    }
+}
+
+BufferedWriter::~BufferedWriter() {
+    try {
+        close();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+    }
+}
+
+void BufferedWriter::reserve(size_t bytes) {
+    if (buffer.size() - used < bytes) {
+        flush();
+    }
+}
+
+void BufferedWriter::write(std::string_view text) {
+    if (text.size() > buffer.size()) {
+        flush();
+        if (std::fwrite(text.data(), 1, text.size(), file) != text.size()) {
+            throw std::runtime_error("Could not write to file: " + filename);
+        }
+        return;
+    }
+    reserve(text.size());
+    std::memcpy(buffer.data() + used, text.data(), text.size());
+    used += text.size();
+}
+
+void BufferedWriter::write(char character) {
+    reserve(1);
+    buffer[used++] = character;
+}
+
+void BufferedWriter::write(long long value) {
+    reserve(MAX_NUMBER_LENGTH);
+    auto result = std::to_chars(buffer.data() + used, buffer.data() + buffer.size(), value);
+    used = static_cast<size_t>(result.ptr - buffer.data());
+}
+
+void BufferedWriter::write(float value) {
+    reserve(MAX_NUMBER_LENGTH);
+    auto result = std::to_chars(buffer.data() + used, buffer.data() + buffer.size(), value);
+    used = static_cast<size_t>(result.ptr - buffer.data());
+}
+
+void BufferedWriter::flush() {
+    if (!file || used == 0) return;
+    if (std::fwrite(buffer.data(), 1, used, file) != used) {
+        throw std::runtime_error("Could not write to file: " + filename);
+    }
+    used = 0;
+}
+
+void BufferedWriter::sync() {
+    if (!file) return;
+    flush();
+#ifdef _WIN32
+    bool failed = std::fflush(file) != 0 || _commit(_fileno(file)) != 0;
+#else
+    bool failed = std::fflush(file) != 0 || fsync(fileno(file)) != 0;
+#endif
+    if (failed) {
+        throw std::runtime_error("Could not sync file: " + filename);
+    }
+}
+
+void BufferedWriter::close() {
+    if (!file) return;
+    // The handle is released even when the last write fails, so it neither leaks nor gets
+    // flushed again by the destructor
+    try {
+        flush();
+    } catch (...) {
+        std::fclose(file);
+        file = nullptr;
+        throw;
+    }
+    bool failed = std::fclose(file) != 0;
+    file = nullptr;
+    if (failed) {
+        throw std::runtime_error("Could not finish writing file: " + filename);
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef BUFFERED_WRITER_HPP
+#define BUFFERED_WRITER_HPP
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Sequential file writer with a large user-space buffer and std::to_chars number formatting.
+class BufferedWriter {
+public:
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+
+    enum class Mode { Truncate, Append };
+
+    explicit BufferedWriter(const std::string& filename, Mode mode = Mode::Truncate,
+                            size_t bufferSize = DEFAULT_BUFFER_SIZE);
+    ~BufferedWriter();
+
+    void write(std::string_view text);
+    void write(char character);
+    void write(long long value);
+    void write(float value);
+
+    void flush();
+    // Flushes and waits until the data is on disk
+    void sync();
+    // Flushes and closes; errors are thrown here rather than lost in the destructor
+    void close();
+
+private:
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    void reserve(size_t bytes);
+
+    std::FILE* file = nullptr;
+    std::string filename;
+    std::vector<char> buffer;
+    size_t used = 0;
+};
+
+#endif
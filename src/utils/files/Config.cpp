@@ -1,4 +1,5 @@
 #include "Config.hpp"
+#include "GeometryCodec.hpp"
 #include <iostream>
 #include <cmath>
 #include <cpptoml.h>  // Assuming you use the cpptoml library
@@ -30,10 +31,15 @@ Config::Config() {
         std::string sensitivityStr = configTable->get_as<std::string>("sensitivity").value_or("0.7");
         sensitivity = std::stof(sensitivityStr);
         language = configTable->get_as<std::string>("language").value_or("en");
+        compressProjects = configTable->get_as<bool>("compressProjects").value_or(false);
+        positionBits = static_cast<int>(configTable->get_as<int64_t>("positionBits").value_or(16));
 
         if (projectsPath.empty()) throw std::runtime_error("Missing 'projectsPath' in config.toml");
         if (sensitivity == 0.0) throw std::runtime_error("Missing or invalid 'sensitivity' in config.toml");
         if (language.empty()) throw std::runtime_error("Missing 'language' in config.toml");
+        if (positionBits < GeometryCodec::MIN_POSITION_BITS || positionBits > GeometryCodec::MAX_POSITION_BITS) {
+            throw std::runtime_error("'positionBits' in config.toml must be between 8 and 24");
+        }
 
     } catch (const std::exception& e) {
         std::cerr << "Error initializing Config: " << e.what() << std::endl;
@@ -57,6 +63,10 @@ std::string Config::getFormattedSensitivity() const {
 
 std::string Config::getLanguage() const { return language; }
 
+bool Config::getCompressProjects() const { return compressProjects; }
+
+int Config::getPositionBits() const { return positionBits; }
+
 void Config::updateProjectsPath(const std::string& newPath) {
     projectsPath = newPath;
     updateConfigFile();
@@ -85,6 +95,8 @@ void Config::updateConfigFile() {
     configTable->insert("inertia", inertia);
     configTable->insert("sensitivity", getFormattedSensitivity());
     configTable->insert("language", language);
+    configTable->insert("compressProjects", compressProjects);
+    configTable->insert("positionBits", static_cast<int64_t>(positionBits));
 
     auto tomlFile = fileManager.createFile(FileFormat::TOML, &configTable);
     tomlFile->write("config.toml");
@@ -98,6 +110,8 @@ void Config::createDefaultConfig(const std::string& filename) {
     configTable->insert("inertia", true);
     configTable->insert("sensitivity", "2.0");
     configTable->insert("language", "en");
+    configTable->insert("compressProjects", false);
+    configTable->insert("positionBits", static_cast<int64_t>(16));
 
     auto tomlFile = fileManager.createFile(FileFormat::TOML, &configTable);
     tomlFile->write(filename);
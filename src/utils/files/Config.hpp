@@ -21,6 +21,8 @@ public:
     float getSensitivity() const;
     std::string getFormattedSensitivity() const;
     std::string getLanguage() const;
+    bool getCompressProjects() const;
+    int getPositionBits() const;
 
     // Update methods
     void updateProjectsPath(const std::string& newPath);
@@ -39,6 +41,8 @@ private:
     bool inertia;
     float sensitivity;
     std::string language;
+    bool compressProjects;
+    int positionBits;
 };
 
 #endif // CONFIG_HPP
@@ -0,0 +1,159 @@
+#include "DirectoryWatcher.hpp"
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/vfs.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+constexpr auto POLL_INTERVAL = std::chrono::seconds(2);
+// How often a blocked watcher checks whether it should stop
+constexpr int STOP_CHECK_MILLISECONDS = 250;
+
+#ifdef __linux__
+// inotify only sees changes made through this machine, so shared folders are polled instead
+static bool isNetworkFilesystem(const std::string& directory) {
+    struct statfs info;
+    if (statfs(directory.c_str(), &info) != 0) return false;
+    switch (static_cast<unsigned long>(info.f_type)) {
+        case 0x6969:      // NFS
+        case 0x517B:      // SMB
+        case 0xFF534D42:  // CIFS
+        case 0xFE534D42:  // SMB2
+        case 0x65735546:  // FUSE
+            return true;
+        default:
+            return false;
+    }
+}
+#endif
+
+DirectoryWatcher::DirectoryWatcher(const std::string& directory) : directory(directory) {
+#ifdef __linux__
+    if (!isNetworkFilesystem(directory)) {
+        inotifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        uint32_t mask = IN_CREATE | IN_DELETE | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF;
+        if (inotifyDescriptor >= 0 && inotify_add_watch(inotifyDescriptor, directory.c_str(), mask) < 0) {
+            close(inotifyDescriptor);
+            inotifyDescriptor = -1;
+        }
+        if (inotifyDescriptor < 0) {
+            std::cerr << "Cannot watch " << directory << ", polling it instead" << std::endl;
+        }
+    }
+#endif
+    thread = std::thread([this]() { run(); });
+}
+
+DirectoryWatcher::~DirectoryWatcher() {
+    stopping = true;
+    thread.join();
+#ifdef __linux__
+    if (inotifyDescriptor >= 0) {
+        close(inotifyDescriptor);
+    }
+#endif
+}
+
+const std::string& DirectoryWatcher::getDirectory() const {
+    return directory;
+}
+
+std::vector<std::string> DirectoryWatcher::takeChanges() {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<std::string> names(changes.begin(), changes.end());
+    changes.clear();
+    return names;
+}
+
+bool DirectoryWatcher::takeOverflow() {
+    std::lock_guard<std::mutex> lock(mutex);
+    bool result = overflowed;
+    overflowed = false;
+    return result;
+}
+
+void DirectoryWatcher::addChange(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    changes.insert(name);
+}
+
+void DirectoryWatcher::run() {
+#ifdef __linux__
+    if (inotifyDescriptor >= 0) {
+        watchEvents();
+        return;
+    }
+#endif
+    pollDirectory();
+}
+
+void DirectoryWatcher::watchEvents() {
+#ifdef __linux__
+    alignas(inotify_event) char buffer[16 * 1024];
+    pollfd descriptor{inotifyDescriptor, POLLIN, 0};
+    while (!stopping) {
+        if (poll(&descriptor, 1, STOP_CHECK_MILLISECONDS) <= 0) continue;
+
+        ssize_t length;
+        while ((length = read(inotifyDescriptor, buffer, sizeof(buffer))) > 0) {
+            for (char* position = buffer; position < buffer + length;) {
+                const auto* event = reinterpret_cast<const inotify_event*>(position);
+                if (event->mask & (IN_Q_OVERFLOW | IN_DELETE_SELF | IN_MOVE_SELF)) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    overflowed = true;
+                } else if (event->len > 0) {
+                    addChange(event->name);
+                }
+                position += sizeof(inotify_event) + event->len;
+            }
+        }
+    }
+#endif
+}
+
+void DirectoryWatcher::pollDirectory() {
+    auto previous = listDirectory();
+    auto nextPoll = std::chrono::steady_clock::now() + POLL_INTERVAL;
+    while (!stopping) {
+        if (std::chrono::steady_clock::now() < nextPoll) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(STOP_CHECK_MILLISECONDS));
+            continue;
+        }
+
+        auto current = listDirectory();
+        for (const auto& [name, state] : current) {
+            auto found = previous.find(name);
+            if (found == previous.end() || found->second.modified != state.modified || found->second.size != state.size) {
+                addChange(name);
+            }
+        }
+        for (const auto& [name, state] : previous) {
+            if (current.find(name) == current.end()) {
+                addChange(name);
+            }
+        }
+        previous = std::move(current);
+        nextPoll = std::chrono::steady_clock::now() + POLL_INTERVAL;
+    }
+}
+
+std::unordered_map<std::string, DirectoryWatcher::FileState> DirectoryWatcher::listDirectory() const {
+    std::unordered_map<std::string, FileState> files;
+    std::error_code error;
+    for (const auto& entry : fs::directory_iterator(directory, error)) {
+        std::error_code entryError;
+        if (!entry.is_regular_file(entryError)) continue;
+        FileState state;
+        state.modified = entry.last_write_time(entryError).time_since_epoch().count();
+        state.size = entry.file_size(entryError);
+        files[entry.path().filename().string()] = state;
+    }
+    return files;
+}
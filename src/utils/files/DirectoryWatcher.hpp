@@ -0,0 +1,53 @@
+#ifndef DIRECTORY_WATCHER_HPP
+#define DIRECTORY_WATCHER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Reports files created, changed or removed directly inside a directory. Uses inotify on Linux
+// and otherwise, or when inotify is unavailable, compares directory listings every few seconds.
+// Runs on its own thread, since it blocks waiting for events.
+class DirectoryWatcher {
+public:
+    explicit DirectoryWatcher(const std::string& directory);
+    ~DirectoryWatcher();
+
+    const std::string& getDirectory() const;
+    // Names of files that changed since the last call
+    std::vector<std::string> takeChanges();
+    // True once when events may have been lost, so the whole directory should be read again
+    bool takeOverflow();
+
+private:
+    DirectoryWatcher(const DirectoryWatcher&) = delete;
+    DirectoryWatcher& operator=(const DirectoryWatcher&) = delete;
+
+    struct FileState {
+        int64_t modified = 0;
+        uintmax_t size = 0;
+    };
+
+    void run();
+    void watchEvents();
+    void pollDirectory();
+    std::unordered_map<std::string, FileState> listDirectory() const;
+    void addChange(const std::string& name);
+
+    std::string directory;
+    std::atomic<bool> stopping{false};
+    std::mutex mutex;
+    std::set<std::string> changes;
+    bool overflowed = false;
+#ifdef __linux__
+    int inotifyDescriptor = -1;
+#endif
+    std::thread thread;
+};
+
+#endif
@@ -1,13 +1,16 @@
 #include "FileManager.hpp"
-#include "ObjFile.hpp"
+#include "GlbExporter.hpp"
+#include "ObjExporter.hpp"
 #include "../LanguageManager.hpp"
 #include "../../core/ui/Snackbar.hpp"
-#include <shobjidl.h>
 #include <filesystem>
 #include <iostream>
 #include <stdexcept>
 #include <codecvt>
+#ifdef _WIN32
+#include <shobjidl.h>
 #include <comdef.h>
+#endif
 
 namespace fs = std::filesystem;
 
@@ -22,6 +25,8 @@ std::unique_ptr<FileType> FileManager::createFile(FileFormat format) {
             return std::make_unique<JsonFile>();
         case FileFormat::TOML:
             return std::make_unique<TomlFile>();
+        case FileFormat::STL:
+            return std::make_unique<StlFile>();
         default:
             throw std::runtime_error("Unsupported file format");
     }
@@ -38,15 +43,20 @@ std::unique_ptr<FileType> FileManager::createFile(FileFormat format, const void*
                 static_cast<const std::shared_ptr<cpptoml::table>*>(data);
             return std::make_unique<TomlFile>(*tomlTable);
         }
+        case FileFormat::STL: {
+            const auto* objects = static_cast<const std::vector<std::shared_ptr<Object3d>>*>(data);
+            return std::make_unique<StlFile>(*objects);
+        }
         default:
-            auto languagePack = LanguageManager::getInstance().getSelectedPack();
-            Snackbar::getInstance().addMessage(languagePack["unsupported_file_format"]);
+            const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+            Snackbar::getInstance().addMessage(languagePack[TextKey::UnsupportedFileFormat]);
     }
 }
 
 std::string FileManager::selectFolder() {
     std::string folderPath = "";
 
+#ifdef _WIN32
     HRESULT hr = CoInitializeEx(nullptr, COINIT_APARTMENTTHREADED | COINIT_DISABLE_OLE1DDE);
     if (SUCCEEDED(hr)) {
         IFileDialog *pFileDialog = nullptr;
@@ -77,10 +87,13 @@ std::string FileManager::selectFolder() {
         }
         CoUninitialize();
     }
+#else
+    std::cerr << "Folder dialogs are only available on Windows" << std::endl;
+#endif
 
     if (folderPath.empty()) {
-        auto languagePack = LanguageManager::getInstance().getSelectedPack();
-        Snackbar::getInstance().addMessage(languagePack["no_folder_selected"]);
+        const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+        Snackbar::getInstance().addMessage(languagePack[TextKey::NoFolderSelected]);
     }
     return folderPath;
 }
@@ -88,6 +101,7 @@ std::string FileManager::selectFolder() {
 std::string FileManager::selectFile() {
     std::string filePath = "";
 
+#ifdef _WIN32
     HRESULT hr = CoInitializeEx(nullptr, COINIT_APARTMENTTHREADED | COINIT_DISABLE_OLE1DDE);
     if (SUCCEEDED(hr)) {
         IFileDialog* pFileDialog = nullptr;
@@ -114,6 +128,9 @@ std::string FileManager::selectFile() {
         }
         CoUninitialize();
     }
+#else
+    std::cerr << "File dialogs are only available on Windows" << std::endl;
+#endif
 
     if (filePath.empty()) {
         std::cout << "No file selected or an error occurred." << std::endl;
@@ -164,13 +181,14 @@ std::vector<FileInfo> FileManager::getFolderFiles(const std::string& folderPath)
 std::string FileManager::saveAs() {
     std::string projectsPath = Config::getInstance().getProjectsPath();
 
+    std::string filePath;
+
+#ifdef _WIN32
     HRESULT hr = CoInitializeEx(nullptr, COINIT_APARTMENTTHREADED | COINIT_DISABLE_OLE1DDE);
     if (FAILED(hr)) {
         throw std::runtime_error("Failed to initialize COM.");
     }
 
-    std::string filePath;
-
     IFileSaveDialog* pFileSave;
     hr = CoCreateInstance(CLSID_FileSaveDialog, nullptr, CLSCTX_ALL, IID_IFileSaveDialog, reinterpret_cast<void**>(&pFileSave));
 
@@ -210,6 +228,9 @@ std::string FileManager::saveAs() {
     }
 
     CoUninitialize();
+#else
+    std::cerr << "File dialogs are only available on Windows" << std::endl;
+#endif
 
     if (filePath.empty()) {
         throw std::runtime_error("No file selected or operation canceled.");
@@ -245,24 +266,38 @@ bool FileManager::createCopy(const std::string& sourceFilePath, const std::strin
 }
 
 std::string FileManager::getExportObjPath() {
+    return getExportPath(L"OBJ Files (*.obj)", L"obj", L"Export as OBJ");
+}
+
+std::string FileManager::getExportStlPath() {
+    return getExportPath(L"STL Files (*.stl)", L"stl", L"Export as STL");
+}
+
+std::string FileManager::getExportGlbPath() {
+    return getExportPath(L"glTF Binary Files (*.glb)", L"glb", L"Export as GLB");
+}
+
+std::string FileManager::getExportPath(const std::wstring& description, const std::wstring& extension, const std::wstring& title) {
+    std::string filePath;
+
+#ifdef _WIN32
     HRESULT hr = CoInitializeEx(nullptr, COINIT_APARTMENTTHREADED | COINIT_DISABLE_OLE1DDE);
     if (FAILED(hr)) {
         throw std::runtime_error("Failed to initialize COM.");
     }
 
-    std::string filePath;
-
     IFileSaveDialog* pFileSave;
     hr = CoCreateInstance(CLSID_FileSaveDialog, nullptr, CLSCTX_ALL,
                          IID_IFileSaveDialog, reinterpret_cast<void**>(&pFileSave));
 
     if (SUCCEEDED(hr)) {
+        std::wstring pattern = L"*." + extension;
         COMDLG_FILTERSPEC fileTypes[] = {
-            {L"OBJ Files (*.obj)", L"*.obj"}
+            {description.c_str(), pattern.c_str()}
         };
         pFileSave->SetFileTypes(ARRAYSIZE(fileTypes), fileTypes);
-        pFileSave->SetDefaultExtension(L"obj");
-        pFileSave->SetTitle(L"Export as OBJ");
+        pFileSave->SetDefaultExtension(extension.c_str());
+        pFileSave->SetTitle(title.c_str());
 
         hr = pFileSave->Show(nullptr);
         if (SUCCEEDED(hr)) {
@@ -275,8 +310,10 @@ std::string FileManager::getExportObjPath() {
                     std::wstring wFilePath(pszFilePath);
                     filePath = std::string(wFilePath.begin(), wFilePath.end());
 
-                    if (filePath.substr(filePath.length() - 4) != ".obj") {
-                        filePath += ".obj";
+                    std::string suffix = "." + std::string(extension.begin(), extension.end());
+                    if (filePath.length() < suffix.length() ||
+                        filePath.compare(filePath.length() - suffix.length(), suffix.length(), suffix) != 0) {
+                        filePath += suffix;
                     }
 
                     CoTaskMemFree(pszFilePath);
@@ -288,51 +325,50 @@ std::string FileManager::getExportObjPath() {
     }
 
     CoUninitialize();
+#else
+    std::cerr << "File dialogs are only available on Windows" << std::endl;
+#endif
 
     if (filePath.empty()) {
-        auto languagePack = LanguageManager::getInstance().getSelectedPack();
-        Snackbar::getInstance().addMessage(languagePack["no_file_selected"]);
+        const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+        Snackbar::getInstance().addMessage(languagePack[TextKey::NoFileSelected]);
     }
 
     return filePath;
 }
 
-bool FileManager::exportToObj(const std::string& objPath,
-                            const std::vector<std::string>& vertices,
-                            const std::vector<std::string>& faces,
-                            const nlohmann::json& projectData) {
+bool FileManager::exportToObj(const std::string& objPath, const std::vector<std::shared_ptr<Object3d>>& objects) {
     try {
-        // Create materials map from project data
-        std::unordered_map<std::string, RgbaColor> materials;
-        if (projectData.contains("materials")) {
-            for (const auto& [name, color] : projectData["materials"].items()) {
-                materials[name] = RgbaColor{
-                    color["r"].get<float>(),
-                    color["g"].get<float>(),
-                    color["b"].get<float>(),
-                    color["a"].get<float>()
-                };
-            }
-        }
-
-        // Create MTL file with the same base name as the OBJ file
-        std::string mtlPath = objPath.substr(0, objPath.length() - 4) + ".mtl";
-        MtlFile mtlFile;
-        mtlFile.setMaterials(materials);
-        mtlFile.write(mtlPath);
-
-        // Create OBJ file
-        ObjFile objFile;
-        objFile.setVertices(vertices);
-        objFile.setFaces(faces);
-        objFile.write(objPath, fs::path(mtlPath).filename().string());
-
+        ObjExporter::write(objPath, objects);
         return true;
     } catch (const std::exception& e) {
-        auto languagePack = LanguageManager::getInstance().getSelectedPack();
-        Snackbar::getInstance().addMessage(languagePack["error_exporting"]);
+        const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+        Snackbar::getInstance().addMessage(languagePack[TextKey::ErrorExporting]);
         std::cerr << "Error exporting to OBJ: " << e.what() << std::endl;
         return false;
     }
 }
 
+bool FileManager::exportToStl(const std::string& stlPath, const std::vector<std::shared_ptr<Object3d>>& objects) {
+    try {
+        createFile(FileFormat::STL, &objects)->write(stlPath);
+        return true;
+    } catch (const std::exception& e) {
+        const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+        Snackbar::getInstance().addMessage(languagePack[TextKey::ErrorExporting]);
+        std::cerr << "Error exporting to STL: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool FileManager::exportToGlb(const std::string& glbPath, const std::vector<std::shared_ptr<Object3d>>& objects) {
+    try {
+        GlbExporter::write(glbPath, objects);
+        return true;
+    } catch (const std::exception& e) {
+        const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+        Snackbar::getInstance().addMessage(languagePack[TextKey::ErrorExporting]);
+        std::cerr << "Error exporting to GLB: " << e.what() << std::endl;
+        return false;
+    }
+}
@@ -7,8 +7,10 @@
 #include <sstream>
 #include <iomanip>
 #include <filesystem>
+#ifdef _WIN32
 #include <windows.h>
 #include <shobjidl.h>
+#endif
 #include <codecvt>
 #include <ctime>
 #include <stdexcept>
@@ -20,12 +22,16 @@
 #include "./TomlFile.hpp"
 #include "Config.hpp"
 #include "MtlFile.hpp"
+#include "StlFile.hpp"
+
+class Object3d;
 
 enum class FileFormat {
     JSON,
     TOML,
     OBJ,
-    PRJ
+    PRJ,
+    STL
 };
 
 struct FileInfo {
@@ -49,11 +55,13 @@ public:
     std::string saveAs();
     bool deleteFile(const std::string& filePath);
     bool createCopy(const std::string& sourceFilePath, const std::string& destinationFolderPath);
+    std::string getExportPath(const std::wstring& description, const std::wstring& extension, const std::wstring& title);
     std::string getExportObjPath();
-    bool exportToObj(const std::string& objPath,
-                     const std::vector<std::string>& vertices,
-                     const std::vector<std::string>& faces,
-                     const nlohmann::json& projectData);
+    bool exportToObj(const std::string& objPath, const std::vector<std::shared_ptr<Object3d>>& objects);
+    std::string getExportStlPath();
+    std::string getExportGlbPath();
+    bool exportToStl(const std::string& stlPath, const std::vector<std::shared_ptr<Object3d>>& objects);
+    bool exportToGlb(const std::string& glbPath, const std::vector<std::shared_ptr<Object3d>>& objects);
 
 private:
     FileManager() = default;
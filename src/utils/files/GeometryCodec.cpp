@@ -0,0 +1,404 @@
+#include "GeometryCodec.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+constexpr size_t BLOCK_SIZE = 64 * 1024;
+constexpr size_t BLOCK_HEADER_SIZE = 2 * sizeof(uint32_t);
+constexpr size_t MIN_MATCH = 4;
+constexpr size_t MAX_OFFSET = 65535;
+constexpr int HASH_BITS = 14;
+// Matches are not searched for in the last bytes of a block, which always end as literals
+constexpr size_t TAIL_LITERALS = 8;
+
+uint32_t load32(const uint8_t* bytes) {
+    uint32_t value;
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+uint32_t hash4(uint32_t value) {
+    return (value * 2654435761u) >> (32 - HASH_BITS);
+}
+
+uint32_t zigzag(int64_t value) {
+    return static_cast<uint32_t>((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+int64_t unzigzag(uint32_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+void putVarint(std::vector<uint8_t>& out, uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+void putLength(std::vector<char>& out, size_t length) {
+    while (length >= 255) {
+        out.push_back(static_cast<char>(255));
+        length -= 255;
+    }
+    out.push_back(static_cast<char>(length));
+}
+
+// Appends one sequence: literals, then a match of length at offset unless length is 0
+void putSequence(std::vector<char>& out, const uint8_t* literals, size_t literalCount, size_t offset, size_t length) {
+    size_t matchExtra = length > 0 ? length - MIN_MATCH : 0;
+    out.push_back(static_cast<char>((std::min<size_t>(literalCount, 15) << 4) | std::min<size_t>(matchExtra, 15)));
+    if (literalCount >= 15) {
+        putLength(out, literalCount - 15);
+    }
+    out.insert(out.end(), literals, literals + literalCount);
+    if (length > 0) {
+        out.push_back(static_cast<char>(offset & 0xFF));
+        out.push_back(static_cast<char>(offset >> 8));
+        if (matchExtra >= 15) {
+            putLength(out, matchExtra - 15);
+        }
+    }
+}
+
+// LZ77 with a single-entry hash table over 4-byte sequences and 16-bit offsets
+void compressBlock(const uint8_t* source, size_t size, std::vector<char>& out) {
+    std::vector<uint32_t> table(size_t(1) << HASH_BITS, 0);
+    size_t anchor = 0;
+    size_t position = 0;
+    size_t limit = size > TAIL_LITERALS ? size - TAIL_LITERALS : 0;
+    while (position < limit) {
+        uint32_t sequence = load32(source + position);
+        uint32_t& slot = table[hash4(sequence)];
+        size_t candidate = slot;
+        slot = static_cast<uint32_t>(position);
+        if (candidate < position && position - candidate <= MAX_OFFSET && load32(source + candidate) == sequence) {
+            size_t length = MIN_MATCH;
+            while (position + length < size && source[candidate + length] == source[position + length]) {
+                ++length;
+            }
+            putSequence(out, source + anchor, position - anchor, position - candidate, length);
+            position += length;
+            anchor = position;
+        } else {
+            // Step faster through data that keeps failing to match
+            position += 1 + ((position - anchor) >> 6);
+        }
+    }
+    putSequence(out, source + anchor, size - anchor, 0, 0);
+}
+
+size_t readLength(const uint8_t* input, size_t size, size_t& position) {
+    size_t length = 0;
+    uint8_t byte;
+    do {
+        if (position >= size) {
+            throw std::runtime_error("Geometry stream is truncated");
+        }
+        byte = input[position++];
+        length += byte;
+    } while (byte == 255);
+    return length;
+}
+
+void decompressBlock(const uint8_t* input, size_t size, uint8_t* output, size_t outputSize) {
+    size_t in = 0;
+    size_t out = 0;
+    while (true) {
+        if (in >= size) {
+            throw std::runtime_error("Geometry stream is truncated");
+        }
+        uint8_t token = input[in++];
+        size_t literalCount = token >> 4;
+        if (literalCount == 15) {
+            literalCount += readLength(input, size, in);
+        }
+        if (literalCount > size - in || literalCount > outputSize - out) {
+            throw std::runtime_error("Geometry stream is corrupt");
+        }
+        std::memcpy(output + out, input + in, literalCount);
+        in += literalCount;
+        out += literalCount;
+        if (in == size) {
+            break;
+        }
+
+        if (size - in < 2) {
+            throw std::runtime_error("Geometry stream is truncated");
+        }
+        size_t offset = input[in] | (static_cast<size_t>(input[in + 1]) << 8);
+        in += 2;
+        size_t length = token & 15;
+        if (length == 15) {
+            length += readLength(input, size, in);
+        }
+        length += MIN_MATCH;
+        if (offset == 0 || offset > out || length > outputSize - out) {
+            throw std::runtime_error("Geometry stream is corrupt");
+        }
+        const uint8_t* match = output + out - offset;
+        if (offset >= length) {
+            std::memcpy(output + out, match, length);
+        } else {
+            // Overlapping matches repeat the last offset bytes
+            for (size_t i = 0; i < length; ++i) {
+                output[out + i] = match[i];
+            }
+        }
+        out += length;
+    }
+    if (out != outputSize) {
+        throw std::runtime_error("Geometry stream is corrupt");
+    }
+}
+
+// Reads varints across blocks, unpacking each block only when the previous one runs out
+class BlockReader {
+public:
+    BlockReader(const char* data, size_t size) : data(data), size(size) {}
+
+    uint32_t readVarint() {
+        if (static_cast<size_t>(blockEnd - position) >= 5) {
+            uint32_t value = 0;
+            for (int shift = 0; shift < 35; shift += 7) {
+                uint8_t byte = *position++;
+                value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) {
+                    return value;
+                }
+            }
+            throw std::runtime_error("Geometry stream has an invalid varint");
+        }
+
+        uint32_t value = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            uint8_t byte = readByte();
+            value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+        throw std::runtime_error("Geometry stream has an invalid varint");
+    }
+
+    bool atEnd() const {
+        return position == blockEnd && offset == size;
+    }
+
+private:
+    uint8_t readByte() {
+        if (position == blockEnd) {
+            nextBlock();
+        }
+        return *position++;
+    }
+
+    void nextBlock() {
+        if (size - offset < BLOCK_HEADER_SIZE) {
+            throw std::runtime_error("Geometry stream is truncated");
+        }
+        uint32_t rawSize;
+        uint32_t packedSize;
+        std::memcpy(&rawSize, data + offset, sizeof(rawSize));
+        std::memcpy(&packedSize, data + offset + sizeof(rawSize), sizeof(packedSize));
+        offset += BLOCK_HEADER_SIZE;
+        if (rawSize == 0 || rawSize > BLOCK_SIZE || packedSize > size - offset) {
+            throw std::runtime_error("Geometry stream is corrupt");
+        }
+
+        const auto* packed = reinterpret_cast<const uint8_t*>(data + offset);
+        offset += packedSize;
+        if (packedSize == rawSize) {
+            position = packed;
+        } else {
+            scratch.resize(rawSize);
+            decompressBlock(packed, packedSize, scratch.data(), rawSize);
+            position = scratch.data();
+        }
+        blockEnd = position + rawSize;
+    }
+
+    const char* data;
+    size_t size;
+    size_t offset = 0;
+    const uint8_t* position = nullptr;
+    const uint8_t* blockEnd = nullptr;
+    std::vector<uint8_t> scratch;
+};
+
+void getAxes(const Vector3& value, double axes[3]) {
+    axes[0] = value.x;
+    axes[1] = value.y;
+    axes[2] = value.z;
+}
+}
+
+std::vector<char> GeometryCodec::encode(const std::vector<Vector3>& vertices,
+                                        const std::vector<std::array<int, 7>>& faces,
+                                        const Vector3& boundsMin, const Vector3& boundsMax, int positionBits) {
+    positionBits = std::clamp(positionBits, MIN_POSITION_BITS, MAX_POSITION_BITS);
+    std::vector<uint8_t> raw;
+    raw.reserve(vertices.size() * 6 + faces.size() * 5);
+    putVarint(raw, static_cast<uint32_t>(positionBits));
+
+    double levels = static_cast<double>((uint32_t(1) << positionBits) - 1);
+    double min[3];
+    double max[3];
+    getAxes(boundsMin, min);
+    getAxes(boundsMax, max);
+    double scale[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        double extent = max[axis] - min[axis];
+        scale[axis] = extent > 0.0 ? levels / extent : 0.0;
+    }
+
+    int64_t previous[3] = {0, 0, 0};
+    for (const auto& vertex : vertices) {
+        double value[3];
+        getAxes(vertex, value);
+        for (int axis = 0; axis < 3; ++axis) {
+            double level = std::clamp(std::round((value[axis] - min[axis]) * scale[axis]), 0.0, levels);
+            // NaN fails both clamp comparisons, so it is stored as the minimum
+            int64_t quantized = level == level ? static_cast<int64_t>(level) : 0;
+            putVarint(raw, zigzag(quantized - previous[axis]));
+            previous[axis] = quantized;
+        }
+    }
+
+    int64_t previousCorner = 0;
+    for (const auto& face : faces) {
+        putVarint(raw, zigzag(static_cast<int64_t>(face[0]) - previousCorner));
+        putVarint(raw, zigzag(static_cast<int64_t>(face[1]) - face[0]));
+        putVarint(raw, zigzag(static_cast<int64_t>(face[2]) - face[0]));
+        previousCorner = face[0];
+    }
+
+    // Colours are stored as bytes, as in uncompressed sections
+    auto packColor = [](const std::array<int, 7>& face) {
+        return static_cast<uint32_t>(face[3] & 0xFF) | (static_cast<uint32_t>(face[4] & 0xFF) << 8) |
+               (static_cast<uint32_t>(face[5] & 0xFF) << 16) | (static_cast<uint32_t>(face[6] & 0xFF) << 24);
+    };
+    std::vector<uint32_t> palette;
+    std::unordered_map<uint32_t, uint32_t> paletteIndices;
+    std::vector<uint32_t> runs;
+    for (size_t face = 0; face < faces.size();) {
+        uint32_t color = packColor(faces[face]);
+        size_t end = face + 1;
+        while (end < faces.size() && packColor(faces[end]) == color) {
+            ++end;
+        }
+        auto inserted = paletteIndices.emplace(color, static_cast<uint32_t>(palette.size()));
+        if (inserted.second) {
+            palette.push_back(color);
+        }
+        runs.push_back(static_cast<uint32_t>(end - face));
+        runs.push_back(inserted.first->second);
+        face = end;
+    }
+    putVarint(raw, static_cast<uint32_t>(palette.size()));
+    for (uint32_t color : palette) {
+        putVarint(raw, color);
+    }
+    for (uint32_t value : runs) {
+        putVarint(raw, value);
+    }
+
+    std::vector<char> encoded;
+    encoded.reserve(raw.size() / 2 + BLOCK_HEADER_SIZE);
+    for (size_t start = 0; start < raw.size(); start += BLOCK_SIZE) {
+        uint32_t rawSize = static_cast<uint32_t>(std::min(BLOCK_SIZE, raw.size() - start));
+        size_t headerAt = encoded.size();
+        encoded.resize(headerAt + BLOCK_HEADER_SIZE);
+        compressBlock(raw.data() + start, rawSize, encoded);
+
+        // Blocks that do not shrink are stored as they are
+        uint32_t packedSize = static_cast<uint32_t>(encoded.size() - headerAt - BLOCK_HEADER_SIZE);
+        if (packedSize >= rawSize) {
+            encoded.resize(headerAt + BLOCK_HEADER_SIZE);
+            encoded.insert(encoded.end(), raw.data() + start, raw.data() + start + rawSize);
+            packedSize = rawSize;
+        }
+        std::memcpy(encoded.data() + headerAt, &rawSize, sizeof(rawSize));
+        std::memcpy(encoded.data() + headerAt + sizeof(rawSize), &packedSize, sizeof(packedSize));
+    }
+    return encoded;
+}
+
+void GeometryCodec::decode(const char* data, size_t size, uint32_t vertexCount, uint32_t faceCount,
+                           const Vector3& boundsMin, const Vector3& boundsMax,
+                           std::vector<Vector3>& vertices, std::vector<std::array<int, 7>>& faces) {
+    BlockReader reader(data, size);
+    uint32_t positionBits = reader.readVarint();
+    if (positionBits < MIN_POSITION_BITS || positionBits > MAX_POSITION_BITS) {
+        throw std::runtime_error("Geometry stream has an invalid position precision");
+    }
+
+    double levels = static_cast<double>((uint32_t(1) << positionBits) - 1);
+    double min[3];
+    double max[3];
+    getAxes(boundsMin, min);
+    getAxes(boundsMax, max);
+    double step[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        step[axis] = (max[axis] - min[axis]) / levels;
+    }
+
+    vertices.resize(vertexCount);
+    int64_t previous[3] = {0, 0, 0};
+    for (auto& vertex : vertices) {
+        float value[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            previous[axis] += unzigzag(reader.readVarint());
+            value[axis] = static_cast<float>(min[axis] + static_cast<double>(previous[axis]) * step[axis]);
+        }
+        vertex = Vector3(value[0], value[1], value[2]);
+    }
+
+    faces.resize(faceCount);
+    int64_t previousCorner = 0;
+    for (auto& face : faces) {
+        int64_t first = previousCorner + unzigzag(reader.readVarint());
+        int64_t second = first + unzigzag(reader.readVarint());
+        int64_t third = first + unzigzag(reader.readVarint());
+        for (int64_t corner : {first, second, third}) {
+            if (corner < 0 || corner >= vertexCount) {
+                throw std::runtime_error("Geometry stream has an out-of-range face index");
+            }
+        }
+        face[0] = static_cast<int>(first);
+        face[1] = static_cast<int>(second);
+        face[2] = static_cast<int>(third);
+        previousCorner = first;
+    }
+
+    uint32_t paletteSize = reader.readVarint();
+    if (paletteSize > faceCount) {
+        throw std::runtime_error("Geometry stream is corrupt");
+    }
+    std::vector<uint32_t> palette(paletteSize);
+    for (auto& color : palette) {
+        color = reader.readVarint();
+    }
+    for (uint32_t face = 0; face < faceCount;) {
+        uint32_t run = reader.readVarint();
+        uint32_t index = reader.readVarint();
+        if (run == 0 || run > faceCount - face || index >= paletteSize) {
+            throw std::runtime_error("Geometry stream is corrupt");
+        }
+        uint32_t color = palette[index];
+        for (uint32_t end = face + run; face < end; ++face) {
+            faces[face][3] = static_cast<int>(color & 0xFF);
+            faces[face][4] = static_cast<int>((color >> 8) & 0xFF);
+            faces[face][5] = static_cast<int>((color >> 16) & 0xFF);
+            faces[face][6] = static_cast<int>(color >> 24);
+        }
+    }
+
+    if (!reader.atEnd()) {
+        throw std::runtime_error("Geometry stream has trailing data");
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef GEOMETRY_CODEC_HPP
+#define GEOMETRY_CODEC_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../math/Vector3.hpp"
+
+// How object geometry is stored in a binary project
+struct GeometryEncoding {
+    bool compressed = false;
+    // Bits per quantized position component
+    int positionBits = 16;
+};
+
+// Compressed geometry stream. Positions are quantized to the object's bounds and delta coded,
+// face indices are delta coded against the previous face and colours are run-length coded
+// against a palette, all as varints. The result is split into 64 KB blocks, each packed with a
+// small LZ77 coder, so decoding only ever holds one block besides the output.
+// Vertex and face order are kept since edits and the journal refer to them by index.
+// Each varint depends on the length of the one before it, so decoding runs at a few hundred MB/s
+// of geometry per thread. Compressed projects only load faster from storage slower than the
+// break-even geometry_codec_benchmark reports, which is why compression is off by default.
+class GeometryCodec {
+public:
+    static constexpr int MIN_POSITION_BITS = 8;
+    static constexpr int MAX_POSITION_BITS = 24;
+
+    static std::vector<char> encode(const std::vector<Vector3>& vertices, const std::vector<std::array<int, 7>>& faces,
+                                    const Vector3& boundsMin, const Vector3& boundsMax, int positionBits);
+
+    // Decodes a stream into storage sized for vertexCount and faceCount. Throws on corrupt data.
+    static void decode(const char* data, size_t size, uint32_t vertexCount, uint32_t faceCount,
+                       const Vector3& boundsMin, const Vector3& boundsMax,
+                       std::vector<Vector3>& vertices, std::vector<std::array<int, 7>>& faces);
+};
+
+#endif
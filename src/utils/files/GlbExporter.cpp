@@ -0,0 +1,360 @@
+#include "GlbExporter.hpp"
+#include "BufferedWriter.hpp"
+#include "../ThreadPool.hpp"
+#include "../../core/objects/Object3d.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+constexpr uint32_t GLB_MAGIC = 0x46546C67;  // "glTF"
+constexpr uint32_t GLB_VERSION = 2;
+constexpr uint32_t CHUNK_JSON = 0x4E4F534A;
+constexpr uint32_t CHUNK_BIN = 0x004E4942;
+
+constexpr int COMPONENT_UNSIGNED_BYTE = 5121;
+constexpr int COMPONENT_UNSIGNED_SHORT = 5123;
+constexpr int COMPONENT_UNSIGNED_INT = 5125;
+constexpr int COMPONENT_FLOAT = 5126;
+constexpr int TARGET_ARRAY_BUFFER = 34962;
+constexpr int TARGET_ELEMENT_ARRAY_BUFFER = 34963;
+
+uint32_t packColor(const std::array<int, 7>& face) {
+    return (static_cast<uint32_t>(face[3] & 0xFF) << 24) | (static_cast<uint32_t>(face[4] & 0xFF) << 16) |
+           (static_cast<uint32_t>(face[5] & 0xFF) << 8) | static_cast<uint32_t>(face[6] & 0xFF);
+}
+
+// glTF colours are linear while the editor's are sRGB
+float toLinear(uint32_t channel) {
+    float value = static_cast<float>(channel) / 255.0f;
+    return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+const std::array<uint8_t, 256>& linearBytes() {
+    static const std::array<uint8_t, 256> table = []() {
+        std::array<uint8_t, 256> values{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            values[i] = static_cast<uint8_t>(toLinear(i) * 255.0f + 0.5f);
+        }
+        return values;
+    }();
+    return table;
+}
+
+uint64_t align4(uint64_t value) {
+    return (value + 3) & ~uint64_t(3);
+}
+
+uint64_t hashMesh(const Object3d& object) {
+    uint64_t hash = 0;
+    auto mix = [&hash](const void* data, size_t size) {
+        const auto* bytes = static_cast<const char*>(data);
+        for (size_t i = 0; i + 8 <= size; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, bytes + i, sizeof(word));
+            hash = (hash ^ word) * 0x9E3779B97F4A7C15ull;
+            hash ^= hash >> 32;
+        }
+        hash ^= size;
+    };
+    const auto& vertices = object.getVertices();
+    const auto& faces = object.getFaces();
+    mix(vertices.data(), vertices.size() * sizeof(Vector3));
+    mix(faces.data(), faces.size() * sizeof(faces[0]));
+    return hash;
+}
+
+bool sameGeometry(const Object3d& a, const Object3d& b) {
+    const auto& verticesA = a.getVertices();
+    const auto& verticesB = b.getVertices();
+    return verticesA.size() == verticesB.size() && a.getFaces() == b.getFaces() &&
+           std::memcmp(verticesA.data(), verticesB.data(), verticesA.size() * sizeof(Vector3)) == 0;
+}
+
+// Gives each (vertex, colour) pair used by a face its own output vertex, in order of first use.
+// Calls addVertex(source vertex, colour) for each output vertex and addCorner(index) per face corner.
+// The colours seen at a vertex are chained per vertex, as only a handful of faces meet at each.
+template <typename AddVertex, typename AddCorner>
+uint32_t splitByColor(const Object3d& object, AddVertex&& addVertex, AddCorner&& addCorner) {
+    struct Split {
+        uint32_t color;
+        uint32_t index;
+        int next;
+    };
+    const auto& faces = object.getFaces();
+    std::vector<int> firstSplit(object.getVertices().size(), -1);
+    std::vector<Split> splits;
+    splits.reserve(faces.size() * 2);
+    uint32_t count = 0;
+    for (const auto& face : faces) {
+        uint32_t color = packColor(face);
+        for (int k = 0; k < 3; ++k) {
+            int vertex = face[k];
+            int split = firstSplit[vertex];
+            while (split >= 0 && splits[split].color != color) {
+                split = splits[split].next;
+            }
+            if (split < 0) {
+                split = static_cast<int>(splits.size());
+                splits.push_back({color, count++, firstSplit[vertex]});
+                firstSplit[vertex] = split;
+                addVertex(vertex, color);
+            }
+            addCorner(splits[split].index);
+        }
+    }
+    return count;
+}
+
+struct MeshLayout {
+    const Object3d* object = nullptr;
+    bool vertexColors = false;
+    uint32_t color = 0;
+    bool translucent = false;
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+    Vector3 min;
+    Vector3 max;
+    uint64_t positionOffset = 0;
+    uint64_t colorOffset = 0;
+    uint64_t indexOffset = 0;
+    uint64_t end = 0;
+
+    bool shortIndices() const {
+        return vertexCount <= std::numeric_limits<uint16_t>::max();
+    }
+};
+
+void includeBounds(MeshLayout& layout, const Vector3& vertex, bool first) {
+    if (first) {
+        layout.min = vertex;
+        layout.max = vertex;
+        return;
+    }
+    layout.min = Vector3(std::min(layout.min.x, vertex.x), std::min(layout.min.y, vertex.y), std::min(layout.min.z, vertex.z));
+    layout.max = Vector3(std::max(layout.max.x, vertex.x), std::max(layout.max.y, vertex.y), std::max(layout.max.z, vertex.z));
+}
+
+// Counts the vertices the mesh is written with and their bounds
+void measureMesh(MeshLayout& layout) {
+    const Object3d& object = *layout.object;
+    const auto& vertices = object.getVertices();
+    const auto& faces = object.getFaces();
+    layout.indexCount = static_cast<uint32_t>(faces.size() * 3);
+    layout.color = packColor(faces[0]);
+    for (const auto& face : faces) {
+        uint32_t color = packColor(face);
+        layout.vertexColors = layout.vertexColors || color != layout.color;
+        layout.translucent = layout.translucent || (color & 0xFF) != 0xFF;
+    }
+
+    if (!layout.vertexColors) {
+        layout.vertexCount = static_cast<uint32_t>(vertices.size());
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            includeBounds(layout, vertices[i], i == 0);
+        }
+        return;
+    }
+    bool first = true;
+    layout.vertexCount = splitByColor(object, [&](int vertex, uint32_t) {
+        includeBounds(layout, vertices[vertex], first);
+        first = false;
+    }, [](uint32_t) {});
+}
+
+template <typename T>
+void writeValue(BufferedWriter& writer, const T& value) {
+    writer.write(std::string_view(reinterpret_cast<const char*>(&value), sizeof(T)));
+}
+
+void writePadding(BufferedWriter& writer, uint64_t written) {
+    for (uint64_t i = written; i < align4(written); ++i) writer.write('\0');
+}
+
+void writeMesh(BufferedWriter& writer, const MeshLayout& layout) {
+    const Object3d& object = *layout.object;
+    const auto& vertices = object.getVertices();
+    const auto& faces = object.getFaces();
+    bool shortIndices = layout.shortIndices();
+    auto writeIndex = [&writer, shortIndices](uint32_t index) {
+        if (shortIndices) {
+            writeValue(writer, static_cast<uint16_t>(index));
+        } else {
+            writeValue(writer, index);
+        }
+    };
+
+    if (!layout.vertexColors) {
+        writer.write(std::string_view(reinterpret_cast<const char*>(vertices.data()), vertices.size() * sizeof(Vector3)));
+        for (const auto& face : faces) {
+            for (int k = 0; k < 3; ++k) writeIndex(static_cast<uint32_t>(face[k]));
+        }
+        writePadding(writer, layout.indexCount * (shortIndices ? 2ull : 4ull));
+        return;
+    }
+
+    std::vector<std::pair<int, uint32_t>> sources;
+    std::vector<uint32_t> indices;
+    sources.reserve(layout.vertexCount);
+    indices.reserve(layout.indexCount);
+    splitByColor(object, [&sources](int vertex, uint32_t color) { sources.emplace_back(vertex, color); },
+                 [&indices](uint32_t index) { indices.push_back(index); });
+
+    const auto& linear = linearBytes();
+    for (const auto& [vertex, color] : sources) {
+        writeValue(writer, vertices[vertex]);
+    }
+    for (const auto& [vertex, color] : sources) {
+        std::array<uint8_t, 4> rgba = {linear[(color >> 24) & 0xFF], linear[(color >> 16) & 0xFF],
+                                       linear[(color >> 8) & 0xFF], static_cast<uint8_t>(color & 0xFF)};
+        writeValue(writer, rgba);
+    }
+    for (uint32_t index : indices) writeIndex(index);
+    writePadding(writer, layout.indexCount * (shortIndices ? 2ull : 4ull));
+}
+}
+
+void GlbExporter::write(const std::string& glbPath, const std::vector<std::shared_ptr<Object3d>>& objects) {
+    // Objects with the same geometry share a mesh
+    std::vector<uint64_t> hashes(objects.size());
+    ThreadPool::getInstance().parallelFor(objects.size(), [&](size_t i) { hashes[i] = hashMesh(*objects[i]); });
+    std::vector<int> meshOf(objects.size(), -1);
+    std::vector<MeshLayout> meshes;
+    std::unordered_map<uint64_t, std::vector<int>> meshesByHash;
+    for (size_t i = 0; i < objects.size(); ++i) {
+        if (objects[i]->getFaces().empty()) continue;
+        auto& candidates = meshesByHash[hashes[i]];
+        for (int mesh : candidates) {
+            if (sameGeometry(*meshes[mesh].object, *objects[i])) {
+                meshOf[i] = mesh;
+                break;
+            }
+        }
+        if (meshOf[i] < 0) {
+            meshOf[i] = static_cast<int>(meshes.size());
+            candidates.push_back(meshOf[i]);
+            meshes.emplace_back().object = objects[i].get();
+        }
+    }
+    ThreadPool::getInstance().parallelFor(meshes.size(), [&](size_t i) { measureMesh(meshes[i]); });
+
+    nlohmann::json json;
+    json["asset"] = {{"version", "2.0"}, {"generator", "3D editor"}};
+    json["scene"] = 0;
+    json["scenes"] = nlohmann::json::array({{{"nodes", nlohmann::json::array()}}});
+    json["nodes"] = nlohmann::json::array();
+    for (size_t i = 0; i < objects.size(); ++i) {
+        Vector3 position = objects[i]->getPosition();
+        Quaternion orientation = objects[i]->getOrientation();
+        Vector3 scale = objects[i]->getScale();
+        nlohmann::json node = {
+            {"name", "object_" + std::to_string(i + 1)},
+            {"translation", {position.x, position.y, position.z}},
+            {"rotation", {orientation.x, orientation.y, orientation.z, orientation.w}},
+            {"scale", {scale.x, scale.y, scale.z}}
+        };
+        if (meshOf[i] >= 0) {
+            node["mesh"] = meshOf[i];
+        }
+        json["nodes"].push_back(node);
+        json["scenes"][0]["nodes"].push_back(i);
+    }
+
+    nlohmann::json accessors = nlohmann::json::array();
+    nlohmann::json bufferViews = nlohmann::json::array();
+    nlohmann::json jsonMeshes = nlohmann::json::array();
+    nlohmann::json materials = nlohmann::json::array();
+    std::map<std::pair<uint32_t, bool>, int> materialIndices;
+    uint64_t offset = 0;
+    auto addView = [&](uint64_t byteOffset, uint64_t byteLength, int target) {
+        bufferViews.push_back({{"buffer", 0}, {"byteOffset", byteOffset}, {"byteLength", byteLength}, {"target", target}});
+        return static_cast<int>(bufferViews.size() - 1);
+    };
+    for (auto& mesh : meshes) {
+        uint64_t indexSize = mesh.shortIndices() ? 2 : 4;
+        mesh.positionOffset = offset;
+        mesh.colorOffset = mesh.positionOffset + static_cast<uint64_t>(mesh.vertexCount) * sizeof(Vector3);
+        mesh.indexOffset = mesh.colorOffset + (mesh.vertexColors ? static_cast<uint64_t>(mesh.vertexCount) * 4 : 0);
+        mesh.end = align4(mesh.indexOffset + mesh.indexCount * indexSize);
+        offset = mesh.end;
+
+        nlohmann::json attributes;
+        attributes["POSITION"] = accessors.size();
+        accessors.push_back({
+            {"bufferView", addView(mesh.positionOffset, mesh.colorOffset - mesh.positionOffset, TARGET_ARRAY_BUFFER)},
+            {"componentType", COMPONENT_FLOAT}, {"count", mesh.vertexCount}, {"type", "VEC3"},
+            {"min", {mesh.min.x, mesh.min.y, mesh.min.z}}, {"max", {mesh.max.x, mesh.max.y, mesh.max.z}}
+        });
+        if (mesh.vertexColors) {
+            attributes["COLOR_0"] = accessors.size();
+            accessors.push_back({
+                {"bufferView", addView(mesh.colorOffset, mesh.indexOffset - mesh.colorOffset, TARGET_ARRAY_BUFFER)},
+                {"componentType", COMPONENT_UNSIGNED_BYTE}, {"normalized", true}, {"count", mesh.vertexCount},
+                {"type", "VEC4"}
+            });
+        }
+        size_t indicesAccessor = accessors.size();
+        accessors.push_back({
+            {"bufferView", addView(mesh.indexOffset, mesh.indexCount * indexSize, TARGET_ELEMENT_ARRAY_BUFFER)},
+            {"componentType", mesh.shortIndices() ? COMPONENT_UNSIGNED_SHORT : COMPONENT_UNSIGNED_INT},
+            {"count", mesh.indexCount}, {"type", "SCALAR"}
+        });
+
+        // Vertex colours multiply a white material; a single colour goes into the material
+        uint32_t materialColor = mesh.vertexColors ? 0xFFFFFFFFu : mesh.color;
+        auto [found, inserted] = materialIndices.try_emplace({materialColor, mesh.translucent}, static_cast<int>(materials.size()));
+        if (inserted) {
+            nlohmann::json material = {
+                {"pbrMetallicRoughness", {
+                    {"baseColorFactor", {toLinear((materialColor >> 24) & 0xFF), toLinear((materialColor >> 16) & 0xFF),
+                                         toLinear((materialColor >> 8) & 0xFF), (materialColor & 0xFF) / 255.0f}},
+                    {"metallicFactor", 0.0f}
+                }}
+            };
+            if (mesh.translucent) {
+                material["alphaMode"] = "BLEND";
+            }
+            materials.push_back(material);
+        }
+        jsonMeshes.push_back({{"primitives", {{{"attributes", attributes}, {"indices", indicesAccessor},
+                                                {"material", found->second}}}}});
+    }
+    if (!meshes.empty()) {
+        json["meshes"] = jsonMeshes;
+        json["materials"] = materials;
+        json["accessors"] = accessors;
+        json["bufferViews"] = bufferViews;
+        json["buffers"] = {{{"byteLength", offset}}};
+    }
+
+    std::string text = json.dump();
+    text.resize(align4(text.size()), ' ');
+    uint64_t totalLength = 12 + 8 + text.size() + (offset > 0 ? 8 + offset : 0);
+    if (totalLength > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("Scene is too large for a GLB file");
+    }
+
+    BufferedWriter writer(glbPath);
+    writeValue(writer, GLB_MAGIC);
+    writeValue(writer, GLB_VERSION);
+    writeValue(writer, static_cast<uint32_t>(totalLength));
+    writeValue(writer, static_cast<uint32_t>(text.size()));
+    writeValue(writer, CHUNK_JSON);
+    writer.write(text);
+
+    if (offset > 0) {
+        writeValue(writer, static_cast<uint32_t>(offset));
+        writeValue(writer, CHUNK_BIN);
+        for (const auto& mesh : meshes) {
+            writeMesh(writer, mesh);
+        }
+    }
+    writer.close();
+}
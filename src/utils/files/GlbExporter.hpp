@@ -0,0 +1,19 @@
+#ifndef GLB_EXPORTER_HPP
+#define GLB_EXPORTER_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class Object3d;
+
+// Writes objects to a binary glTF (.glb) with a single buffer. Each object becomes a node with
+// its position, orientation and scale; objects with identical geometry, such as copies, share
+// one mesh and its buffer views. Faces of one colour use a material colour; otherwise vertices
+// are split where faces of different colours meet and coloured through COLOR_0.
+class GlbExporter {
+public:
+    static void write(const std::string& glbPath, const std::vector<std::shared_ptr<Object3d>>& objects);
+};
+
+#endif
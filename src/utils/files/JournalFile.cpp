@@ -0,0 +1,471 @@
+#include "JournalFile.hpp"
+#include "MappedFile.hpp"
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <type_traits>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+enum RecordType : uint8_t {
+    BASE = 1,
+    ADD_OBJECT,
+    DELETE_OBJECT,
+    TRANSFORM,
+    MOVED_VERTICES,
+    FACE_COLORS,
+    GEOMETRY
+};
+
+constexpr size_t RECORD_HEADER_SIZE = sizeof(uint8_t) + sizeof(uint32_t);
+constexpr size_t CHECKSUM_SIZE = sizeof(uint32_t);
+
+static_assert(sizeof(Vector3) == 3 * sizeof(float) && std::is_trivially_copyable_v<Vector3>,
+              "Vertices are copied directly into Vector3 storage");
+static_assert(sizeof(std::array<int, 7>) == 7 * sizeof(int32_t), "Faces are stored as seven 32-bit values");
+
+uint32_t checksum(const char* data, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; ++i) {
+        hash = (hash ^ static_cast<uint8_t>(data[i])) * 16777619u;
+    }
+    return hash;
+}
+
+struct Record {
+    uint8_t type;
+    const char* payload;
+    size_t size;
+    size_t offset;
+};
+
+// Splits a journal into records, stopping at the first one that is truncated or corrupt
+std::vector<Record> readRecords(const char* data, size_t size) {
+    std::vector<Record> records;
+    size_t offset = 0;
+    while (size - offset >= RECORD_HEADER_SIZE + CHECKSUM_SIZE) {
+        uint32_t payloadSize;
+        std::memcpy(&payloadSize, data + offset + sizeof(uint8_t), sizeof(payloadSize));
+        if (payloadSize > size - offset - RECORD_HEADER_SIZE - CHECKSUM_SIZE) {
+            break;
+        }
+
+        size_t checkedLength = RECORD_HEADER_SIZE + payloadSize;
+        uint32_t storedChecksum;
+        std::memcpy(&storedChecksum, data + offset + checkedLength, sizeof(storedChecksum));
+        if (storedChecksum != checksum(data + offset, checkedLength)) {
+            break;
+        }
+
+        records.push_back({static_cast<uint8_t>(data[offset]), data + offset + RECORD_HEADER_SIZE, payloadSize, offset});
+        offset += checkedLength + CHECKSUM_SIZE;
+    }
+    return records;
+}
+
+// Reads a record payload front to back, failing instead of running past its end
+class PayloadReader {
+public:
+    explicit PayloadReader(const Record& record) : data(record.payload), size(record.size) {}
+
+    bool getBytes(void* target, size_t length) {
+        if (size - offset < length) {
+            return false;
+        }
+        std::memcpy(target, data + offset, length);
+        offset += length;
+        return true;
+    }
+
+    template <typename T>
+    bool get(T& value) {
+        return getBytes(&value, sizeof(value));
+    }
+
+    bool getVector(Vector3& vector) {
+        return get(vector.x) && get(vector.y) && get(vector.z);
+    }
+
+    bool getTransform(JournalFile::Transform& transform) {
+        return getVector(transform.position) && getVector(transform.rotation) && getVector(transform.scale);
+    }
+
+    bool getMesh(std::vector<Vector3>& vertices, std::vector<std::array<int, 7>>& faces) {
+        uint32_t vertexCount;
+        uint32_t faceCount;
+        if (!get(vertexCount) || !get(faceCount) ||
+            static_cast<uint64_t>(vertexCount) * sizeof(Vector3) +
+            static_cast<uint64_t>(faceCount) * sizeof(std::array<int, 7>) > size - offset) {
+            return false;
+        }
+
+        vertices.resize(vertexCount);
+        faces.resize(faceCount);
+        getBytes(vertices.data(), vertexCount * sizeof(Vector3));
+        getBytes(faces.data(), faceCount * sizeof(std::array<int, 7>));
+        for (const auto& face : faces) {
+            for (int corner = 0; corner < 3; ++corner) {
+                if (face[corner] < 0 || static_cast<uint32_t>(face[corner]) >= vertexCount) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    const char* data;
+    size_t size;
+    size_t offset = 0;
+};
+
+void applyTransform(ProjectObject& object, const JournalFile::Transform& transform) {
+    object.position = transform.position;
+    object.rotation = transform.rotation;
+    object.scale = transform.scale;
+}
+
+// Applies one record to the objects keyed by journal id; returns whether it was an edit
+bool applyRecord(const Record& record, std::map<uint32_t, ProjectObject>& objects) {
+    PayloadReader reader(record);
+    uint32_t id = 0;
+    if (record.type != BASE && !reader.get(id)) {
+        return false;
+    }
+    auto found = objects.find(id);
+
+    switch (record.type) {
+        case BASE: {
+            // A later save that never completed renumbered the objects in its saved order
+            uint64_t saveId;
+            uint32_t count;
+            if (!reader.get(saveId) || !reader.get(count)) {
+                return false;
+            }
+            std::map<uint32_t, ProjectObject> renumbered;
+            for (uint32_t i = 0; i < count; ++i) {
+                uint32_t previousId;
+                if (!reader.get(previousId)) {
+                    break;
+                }
+                auto previous = objects.find(previousId);
+                if (previous != objects.end()) {
+                    renumbered.emplace(i, std::move(previous->second));
+                }
+            }
+            objects = std::move(renumbered);
+            return false;
+        }
+        case ADD_OBJECT: {
+            ProjectObject object;
+            JournalFile::Transform transform;
+            if (!reader.getTransform(transform) || !reader.getMesh(object.vertices, object.faces)) {
+                return false;
+            }
+            applyTransform(object, transform);
+            objects[id] = std::move(object);
+            return true;
+        }
+        case DELETE_OBJECT:
+            return objects.erase(id) > 0;
+        case TRANSFORM: {
+            JournalFile::Transform transform;
+            if (found == objects.end() || !reader.getTransform(transform)) {
+                return false;
+            }
+            applyTransform(found->second, transform);
+            return true;
+        }
+        case MOVED_VERTICES: {
+            uint32_t count;
+            if (found == objects.end() || !reader.get(count)) {
+                return false;
+            }
+            auto& vertices = found->second.vertices;
+            for (uint32_t i = 0; i < count; ++i) {
+                uint32_t index;
+                Vector3 vertex;
+                if (!reader.get(index) || !reader.getVector(vertex)) {
+                    return false;
+                }
+                if (index < vertices.size()) {
+                    vertices[index] = vertex;
+                }
+            }
+            return true;
+        }
+        case FACE_COLORS: {
+            uint32_t count;
+            if (found == objects.end() || !reader.get(count)) {
+                return false;
+            }
+            auto& faces = found->second.faces;
+            for (uint32_t i = 0; i < count; ++i) {
+                uint32_t index;
+                uint8_t color[4];
+                if (!reader.get(index) || !reader.getBytes(color, sizeof(color))) {
+                    return false;
+                }
+                if (index < faces.size()) {
+                    for (int channel = 0; channel < 4; ++channel) {
+                        faces[index][3 + channel] = color[channel];
+                    }
+                }
+            }
+            return true;
+        }
+        case GEOMETRY: {
+            std::vector<Vector3> vertices;
+            std::vector<std::array<int, 7>> faces;
+            if (found == objects.end() || !reader.getMesh(vertices, faces)) {
+                return false;
+            }
+            found->second.vertices = std::move(vertices);
+            found->second.faces = std::move(faces);
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+}
+
+JournalFile::JournalFile(const std::string& filename) : filename(filename) {
+    open();
+}
+
+JournalFile::~JournalFile() {
+    try {
+        flush();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+    }
+    if (file) {
+        std::fclose(file);
+    }
+}
+
+void JournalFile::open() {
+    file = std::fopen(filename.c_str(), "ab");
+    if (!file) {
+        throw std::runtime_error("Could not open journal: " + filename);
+    }
+}
+
+void JournalFile::beginRecord(uint8_t type) {
+    recordStart = buffer.size();
+    buffer.push_back(static_cast<char>(type));
+    buffer.resize(buffer.size() + sizeof(uint32_t));
+}
+
+void JournalFile::put(const void* bytes, size_t length) {
+    const char* begin = static_cast<const char*>(bytes);
+    buffer.insert(buffer.end(), begin, begin + length);
+}
+
+void JournalFile::putTransform(const Transform& transform) {
+    for (const Vector3* vector : {&transform.position, &transform.rotation, &transform.scale}) {
+        put(vector->x);
+        put(vector->y);
+        put(vector->z);
+    }
+}
+
+void JournalFile::putMesh(const std::vector<Vector3>& vertices, const std::vector<std::array<int, 7>>& faces) {
+    put(static_cast<uint32_t>(vertices.size()));
+    put(static_cast<uint32_t>(faces.size()));
+    put(vertices.data(), vertices.size() * sizeof(Vector3));
+    put(faces.data(), faces.size() * sizeof(std::array<int, 7>));
+}
+
+void JournalFile::endRecord() {
+    uint32_t payloadSize = static_cast<uint32_t>(buffer.size() - recordStart - RECORD_HEADER_SIZE);
+    std::memcpy(buffer.data() + recordStart + sizeof(uint8_t), &payloadSize, sizeof(payloadSize));
+    put(checksum(buffer.data() + recordStart, buffer.size() - recordStart));
+}
+
+void JournalFile::writeBase(uint64_t saveId, const std::vector<uint32_t>& previousIds) {
+    beginRecord(BASE);
+    put(saveId);
+    put(static_cast<uint32_t>(previousIds.size()));
+    put(previousIds.data(), previousIds.size() * sizeof(uint32_t));
+    endRecord();
+}
+
+void JournalFile::writeAddObject(uint32_t id, const Transform& transform, const std::vector<Vector3>& vertices,
+                                 const std::vector<std::array<int, 7>>& faces) {
+    beginRecord(ADD_OBJECT);
+    put(id);
+    putTransform(transform);
+    putMesh(vertices, faces);
+    endRecord();
+}
+
+void JournalFile::writeDeleteObject(uint32_t id) {
+    beginRecord(DELETE_OBJECT);
+    put(id);
+    endRecord();
+}
+
+void JournalFile::writeTransform(uint32_t id, const Transform& transform) {
+    beginRecord(TRANSFORM);
+    put(id);
+    putTransform(transform);
+    endRecord();
+}
+
+void JournalFile::writeMovedVertices(uint32_t id, const std::vector<int>& indices, const std::vector<Vector3>& vertices) {
+    beginRecord(MOVED_VERTICES);
+    put(id);
+    put(static_cast<uint32_t>(indices.size()));
+    for (int index : indices) {
+        put(static_cast<uint32_t>(index));
+        put(vertices[index].x);
+        put(vertices[index].y);
+        put(vertices[index].z);
+    }
+    endRecord();
+}
+
+void JournalFile::writeFaceColors(uint32_t id, const std::vector<int>& indices,
+                                  const std::vector<std::array<int, 7>>& faces) {
+    beginRecord(FACE_COLORS);
+    put(id);
+    put(static_cast<uint32_t>(indices.size()));
+    for (int index : indices) {
+        put(static_cast<uint32_t>(index));
+        for (int channel = 3; channel < 7; ++channel) {
+            put(static_cast<uint8_t>(faces[index][channel]));
+        }
+    }
+    endRecord();
+}
+
+void JournalFile::writeGeometry(uint32_t id, const std::vector<Vector3>& vertices,
+                                const std::vector<std::array<int, 7>>& faces) {
+    beginRecord(GEOMETRY);
+    put(id);
+    putMesh(vertices, faces);
+    endRecord();
+}
+
+void JournalFile::flush() {
+    if (buffer.empty()) {
+        return;
+    }
+    bool failed = std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size() || std::fflush(file) != 0;
+    buffer.clear();
+    if (failed) {
+        throw std::runtime_error("Could not write journal: " + filename);
+    }
+}
+
+void JournalFile::sync() {
+    flush();
+#ifdef _WIN32
+    bool failed = _commit(_fileno(file)) != 0;
+#else
+    bool failed = fsync(fileno(file)) != 0;
+#endif
+    if (failed) {
+        throw std::runtime_error("Could not sync journal: " + filename);
+    }
+}
+
+void JournalFile::dropBefore(uint64_t saveId) {
+    flush();
+    std::fclose(file);
+    file = nullptr;
+
+    std::string tempFilename = filename + ".tmp";
+    bool replaced = false;
+    try {
+        MappedFile mapped(filename);
+        std::vector<Record> records = readRecords(mapped.data(), mapped.size());
+        size_t keepFrom = 0;
+        for (const auto& record : records) {
+            PayloadReader reader(record);
+            uint64_t baseSaveId;
+            if (record.type == BASE && reader.get(baseSaveId) && baseSaveId == saveId) {
+                keepFrom = record.offset;
+            }
+        }
+
+        if (keepFrom > 0) {
+            std::FILE* output = std::fopen(tempFilename.c_str(), "wb");
+            if (!output) {
+                throw std::runtime_error("Could not open journal: " + tempFilename);
+            }
+            size_t length = mapped.size() - keepFrom;
+            bool failed = std::fwrite(mapped.data() + keepFrom, 1, length, output) != length;
+            failed = std::fclose(output) != 0 || failed;
+            if (failed) {
+                throw std::runtime_error("Could not write journal: " + tempFilename);
+            }
+            replaced = true;
+        }
+    } catch (...) {
+        std::error_code error;
+        fs::remove(tempFilename, error);
+        open();
+        throw;
+    }
+
+    if (replaced) {
+        fs::rename(tempFilename, filename);
+    }
+    open();
+}
+
+size_t JournalFile::replay(const std::string& filename, ProjectData& project, std::vector<uint32_t>& ids) {
+    ids.clear();
+    std::error_code error;
+    if (!fs::exists(filename, error) || fs::file_size(filename, error) == 0) {
+        return 0;
+    }
+
+    MappedFile mapped(filename);
+    std::vector<Record> records = readRecords(mapped.data(), mapped.size());
+
+    // Start from the last segment recorded against the save that was loaded
+    size_t start = records.size();
+    for (size_t i = 0; i < records.size(); ++i) {
+        PayloadReader reader(records[i]);
+        uint64_t baseSaveId;
+        if (records[i].type == BASE && reader.get(baseSaveId) && baseSaveId == project.saveId) {
+            start = i;
+        }
+    }
+    if (start == records.size()) {
+        return 0;
+    }
+
+    std::map<uint32_t, ProjectObject> objects;
+    for (size_t i = 0; i < project.objects.size(); ++i) {
+        objects.emplace(static_cast<uint32_t>(i), std::move(project.objects[i]));
+    }
+
+    size_t applied = 0;
+    for (size_t i = start + 1; i < records.size(); ++i) {
+        if (applyRecord(records[i], objects)) {
+            ++applied;
+        }
+    }
+
+    project.objects.clear();
+    project.objects.reserve(objects.size());
+    for (auto& [id, object] : objects) {
+        ids.push_back(id);
+        project.objects.push_back(std::move(object));
+    }
+    return applied;
+}
@@ -0,0 +1,70 @@
+#ifndef JOURNAL_FILE_HPP
+#define JOURNAL_FILE_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "ProjectData.hpp"
+
+// Append-only log of edits made on top of a saved project. Each record is a type byte, payload
+// size, payload and FNV-1a checksum, so a record torn by a crash is detected and ignored.
+// Objects are referred to by journal ids; a base record starts a segment against one save,
+// where ids are the object indices in that save.
+class JournalFile {
+public:
+    struct Transform {
+        Vector3 position;
+        Vector3 rotation;
+        Vector3 scale;
+    };
+
+    // Opens for appending, creating the file if needed
+    explicit JournalFile(const std::string& filename);
+    ~JournalFile();
+
+    // previousIds[i] is the id, in the preceding segment, of the object saved at index i
+    void writeBase(uint64_t saveId, const std::vector<uint32_t>& previousIds);
+    void writeAddObject(uint32_t id, const Transform& transform, const std::vector<Vector3>& vertices,
+                        const std::vector<std::array<int, 7>>& faces);
+    void writeDeleteObject(uint32_t id);
+    void writeTransform(uint32_t id, const Transform& transform);
+    void writeMovedVertices(uint32_t id, const std::vector<int>& indices, const std::vector<Vector3>& vertices);
+    void writeFaceColors(uint32_t id, const std::vector<int>& indices, const std::vector<std::array<int, 7>>& faces);
+    void writeGeometry(uint32_t id, const std::vector<Vector3>& vertices, const std::vector<std::array<int, 7>>& faces);
+
+    // Hands buffered records to the OS, which is enough to survive the app crashing
+    void flush();
+    // Also forces them to disk, to survive the machine going down
+    void sync();
+    // Removes every segment older than the last one recorded against saveId
+    void dropBefore(uint64_t saveId);
+
+    // Applies the journal on top of project, starting from the last segment recorded against
+    // project.saveId. ids receives the journal id of every resulting object. Returns the number
+    // of edits applied, 0 when the journal does not belong to this save.
+    static size_t replay(const std::string& filename, ProjectData& project, std::vector<uint32_t>& ids);
+
+private:
+    JournalFile(const JournalFile&) = delete;
+    JournalFile& operator=(const JournalFile&) = delete;
+
+    void open();
+    void beginRecord(uint8_t type);
+    void put(const void* bytes, size_t length);
+    template <typename T>
+    void put(const T& value) {
+        put(&value, sizeof(value));
+    }
+    void putTransform(const Transform& transform);
+    void putMesh(const std::vector<Vector3>& vertices, const std::vector<std::array<int, 7>>& faces);
+    void endRecord();
+
+    std::string filename;
+    std::FILE* file = nullptr;
+    std::vector<char> buffer;
+    size_t recordStart = 0;
+};
+
+#endif
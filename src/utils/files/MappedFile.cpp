@@ -0,0 +1,116 @@
+#include "MappedFile.hpp"
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string& filename) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Could not open file: " + filename);
+    }
+    fileHandle = file;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        close();
+        throw std::runtime_error("Could not read file size: " + filename);
+    }
+    mappedSize = static_cast<size_t>(fileSize.QuadPart);
+    if (mappedSize == 0) return;
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        close();
+        throw std::runtime_error("Could not map file: " + filename);
+    }
+    mappingHandle = mapping;
+
+    mappedData = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (mappedData == nullptr) {
+        close();
+        throw std::runtime_error("Could not map file: " + filename);
+    }
+#else
+    fileDescriptor = ::open(filename.c_str(), O_RDONLY);
+    if (fileDescriptor < 0) {
+        throw std::runtime_error("Could not open file: " + filename);
+    }
+
+    struct stat fileStat {};
+    if (::fstat(fileDescriptor, &fileStat) != 0) {
+        close();
+        throw std::runtime_error("Could not read file size: " + filename);
+    }
+    mappedSize = static_cast<size_t>(fileStat.st_size);
+    if (mappedSize == 0) return;
+
+    void* mapping = ::mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    if (mapping == MAP_FAILED) {
+        close();
+        throw std::runtime_error("Could not map file: " + filename);
+    }
+    ::madvise(mapping, mappedSize, MADV_SEQUENTIAL);
+    mappedData = static_cast<const char*>(mapping);
+#endif
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        std::swap(mappedData, other.mappedData);
+        std::swap(mappedSize, other.mappedSize);
+#ifdef _WIN32
+        std::swap(fileHandle, other.fileHandle);
+        std::swap(mappingHandle, other.mappingHandle);
+#else
+        std::swap(fileDescriptor, other.fileDescriptor);
+#endif
+    }
+    return *this;
+}
+
+void MappedFile::close() {
+#ifdef _WIN32
+    if (mappedData) UnmapViewOfFile(mappedData);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle) CloseHandle(fileHandle);
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    if (mappedData) ::munmap(const_cast<char*>(mappedData), mappedSize);
+    if (fileDescriptor >= 0) ::close(fileDescriptor);
+    fileDescriptor = -1;
+#endif
+    mappedData = nullptr;
+    mappedSize = 0;
+}
+
+const char* MappedFile::data() const {
+    return mappedData;
+}
+
+size_t MappedFile::size() const {
+    return mappedSize;
+}
+
+std::string_view MappedFile::view() const {
+    return mappedData ? std::string_view(mappedData, mappedSize) : std::string_view();
+}
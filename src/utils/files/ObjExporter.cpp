@@ -0,0 +1,100 @@
+#include "ObjExporter.hpp"
+#include "BufferedWriter.hpp"
+#include "MtlFile.hpp"
+#include "../../core/objects/Object3d.hpp"
+#include "../math/Vector4.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace {
+uint32_t packColor(const std::array<int, 7>& face) {
+    return (static_cast<uint32_t>(face[3] & 0xFF) << 24) | (static_cast<uint32_t>(face[4] & 0xFF) << 16) |
+           (static_cast<uint32_t>(face[5] & 0xFF) << 8) | static_cast<uint32_t>(face[6] & 0xFF);
+}
+
+std::string materialName(uint32_t color) {
+    char name[16];
+    std::snprintf(name, sizeof(name), "color_%08x", color);
+    return name;
+}
+}
+
+void ObjExporter::write(const std::string& objPath, const std::vector<std::shared_ptr<Object3d>>& objects) {
+    fs::path mtlPath = fs::path(objPath).replace_extension(".mtl");
+
+    std::unordered_map<uint32_t, std::string> palette;
+    BufferedWriter writer(objPath);
+    writer.write("mtllib ");
+    writer.write(mtlPath.filename().string());
+    writer.write('\n');
+
+    long long vertexOffset = 1;
+    int objectNumber = 1;
+    for (const auto& object : objects) {
+        const Matrix4& transform = object->getTransformation();
+        const auto& vertices = object->getVertices();
+        const auto& faces = object->getFaces();
+
+        writer.write("o object_");
+        writer.write(static_cast<long long>(objectNumber++));
+        writer.write('\n');
+
+        for (const auto& vertex : vertices) {
+            Vector4 world = transform * Vector4(vertex, 1.0f);
+            writer.write("v ");
+            writer.write(world.x);
+            writer.write(' ');
+            writer.write(world.y);
+            writer.write(' ');
+            writer.write(world.z);
+            writer.write('\n');
+        }
+
+        // A mirroring scale turns faces inside out unless the winding is flipped too
+        Vector3 scale = object->getScale();
+        bool mirrored = scale.x * scale.y * scale.z < 0.0f;
+
+        bool hasColor = false;
+        uint32_t currentColor = 0;
+        for (const auto& face : faces) {
+            uint32_t color = packColor(face);
+            if (!hasColor || color != currentColor) {
+                auto it = palette.find(color);
+                if (it == palette.end()) {
+                    it = palette.emplace(color, materialName(color)).first;
+                }
+                writer.write("usemtl ");
+                writer.write(it->second);
+                writer.write('\n');
+                currentColor = color;
+                hasColor = true;
+            }
+
+            writer.write('f');
+            for (int corner : {0, mirrored ? 2 : 1, mirrored ? 1 : 2}) {
+                writer.write(' ');
+                writer.write(face[corner] + vertexOffset);
+            }
+            writer.write('\n');
+        }
+
+        vertexOffset += static_cast<long long>(vertices.size());
+    }
+    writer.close();
+
+    std::unordered_map<std::string, RgbaColor> materials;
+    for (const auto& [color, name] : palette) {
+        materials[name] = RgbaColor{
+            ((color >> 24) & 0xFF) / 255.0f,
+            ((color >> 16) & 0xFF) / 255.0f,
+            ((color >> 8) & 0xFF) / 255.0f,
+            (color & 0xFF) / 255.0f
+        };
+    }
+    MtlFile mtlFile;
+    mtlFile.setMaterials(materials);
+    mtlFile.write(mtlPath.string());
+}
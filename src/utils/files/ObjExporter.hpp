@@ -0,0 +1,17 @@
+#ifndef OBJ_EXPORTER_HPP
+#define OBJ_EXPORTER_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class Object3d;
+
+// Streams objects to a Wavefront OBJ in world space. Face colours are collapsed into a palette
+// written as a .mtl next to the OBJ.
+class ObjExporter {
+public:
+    static void write(const std::string& objPath, const std::vector<std::shared_ptr<Object3d>>& objects);
+};
+
+#endif
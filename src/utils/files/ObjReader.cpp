@@ -0,0 +1,278 @@
+#include "ObjReader.hpp"
+#include "MappedFile.hpp"
+#include "MtlFile.hpp"
+#include "../ThreadPool.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace {
+constexpr std::array<int, 4> DEFAULT_FACE_COLOR = {128, 128, 128, 255};
+constexpr size_t MIN_CHUNK_SIZE = 4 * 1024 * 1024;
+constexpr size_t CHUNKS_PER_THREAD = 4;
+
+struct Chunk {
+    std::string_view text;
+    size_t lineCount = 0;
+    size_t vertexCount = 0;
+    size_t firstLine = 0;
+    size_t firstVertex = 0;
+
+    std::vector<std::array<int, 7>> faces;
+    std::vector<ObjMaterialRange> materialRanges;
+    std::vector<ObjGroupRange> groupRanges;
+    std::string mtlFilename;
+};
+
+class LineParser {
+public:
+    LineParser(const char* begin, const char* end, size_t lineNumber)
+        : current(begin), end(end), lineNumber(lineNumber) {}
+
+    void skipSpaces() {
+        while (current < end && (*current == ' ' || *current == '\t' || *current == '\r')) ++current;
+    }
+
+    bool atEnd() {
+        skipSpaces();
+        return current >= end;
+    }
+
+    std::string_view word() {
+        skipSpaces();
+        const char* start = current;
+        while (current < end && *current != ' ' && *current != '\t' && *current != '\r') ++current;
+        return std::string_view(start, static_cast<size_t>(current - start));
+    }
+
+    float number() {
+        skipSpaces();
+        if (current < end && *current == '+') ++current;
+        float value = 0.0f;
+        auto [next, error] = std::from_chars(current, end, value);
+        if (error != std::errc()) fail("expected a number");
+        current = next;
+        return value;
+    }
+
+    // Resolves a 1-based or negative (relative) OBJ index against the vertices read so far
+    int vertexIndex(size_t vertexCount) {
+        long long value = 0;
+        auto [next, error] = std::from_chars(current, end, value);
+        if (error != std::errc()) fail("expected a vertex index");
+        current = next;
+
+        long long resolved = value > 0 ? value - 1 : static_cast<long long>(vertexCount) + value;
+        if (value == 0 || resolved < 0 || resolved >= static_cast<long long>(vertexCount)) {
+            fail("vertex index " + std::to_string(value) + " is out of range");
+        }
+
+        // Texture and normal references are not used by the editor
+        while (current < end && *current == '/') {
+            ++current;
+            if (current < end && (*current == '-' || (*current >= '0' && *current <= '9'))) {
+                long long ignored = 0;
+                auto [skipped, skipError] = std::from_chars(current, end, ignored);
+                if (skipError != std::errc()) fail("malformed face reference");
+                current = skipped;
+            }
+        }
+        return static_cast<int>(resolved);
+    }
+
+    [[noreturn]] void fail(const std::string& message) const {
+        throw std::runtime_error("OBJ line " + std::to_string(lineNumber) + ": " + message);
+    }
+
+private:
+    const char* current;
+    const char* end;
+    size_t lineNumber;
+};
+}
+
+namespace {
+template <typename LineHandler>
+void forEachLine(std::string_view text, LineHandler&& handler) {
+    const char* cursor = text.data();
+    const char* textEnd = text.data() + text.size();
+    while (cursor < textEnd) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(cursor, '\n', static_cast<size_t>(textEnd - cursor)));
+        if (!lineEnd) lineEnd = textEnd;
+        handler(cursor, lineEnd);
+        cursor = lineEnd + 1;
+    }
+}
+
+// Splits at line boundaries so no line straddles two chunks
+std::vector<Chunk> splitIntoChunks(std::string_view text, size_t chunkCount) {
+    std::vector<Chunk> chunks;
+    size_t begin = 0;
+    for (size_t i = 1; i <= chunkCount && begin < text.size(); ++i) {
+        size_t end = i == chunkCount ? text.size() : std::max(begin, text.size() * i / chunkCount);
+        if (end < text.size()) {
+            size_t newline = text.find('\n', end);
+            end = newline == std::string_view::npos ? text.size() : newline + 1;
+        }
+        if (end <= begin) continue;
+
+        Chunk chunk;
+        chunk.text = text.substr(begin, end - begin);
+        chunks.push_back(std::move(chunk));
+        begin = end;
+    }
+    return chunks;
+}
+
+// First pass: vertex and line counts, so every chunk knows its global vertex and line offsets
+void countChunk(Chunk& chunk) {
+    forEachLine(chunk.text, [&chunk](const char* begin, const char* end) {
+        chunk.lineCount++;
+        while (begin < end && (*begin == ' ' || *begin == '\t' || *begin == '\r')) ++begin;
+        if (end - begin >= 2 && begin[0] == 'v' && (begin[1] == ' ' || begin[1] == '\t')) {
+            chunk.vertexCount++;
+        }
+    });
+}
+
+// Second pass: vertices go straight into the shared array, faces into the chunk
+void parseChunk(Chunk& chunk, Vector3* vertices) {
+    std::vector<int> polygon;
+    std::string_view currentMaterial;
+    size_t vertexCount = chunk.firstVertex;
+    size_t lineNumber = chunk.firstLine;
+
+    forEachLine(chunk.text, [&](const char* begin, const char* end) {
+        LineParser line(begin, end, ++lineNumber);
+
+        std::string_view keyword = line.word();
+        if (keyword.empty() || keyword[0] == '#') return;
+
+        if (keyword == "v") {
+            float x = line.number();
+            float y = line.number();
+            float z = line.number();
+            vertices[vertexCount++] = Vector3(x, y, z);
+        } else if (keyword == "f") {
+            polygon.clear();
+            while (!line.atEnd()) {
+                polygon.push_back(line.vertexIndex(vertexCount));
+            }
+            if (polygon.size() < 3) line.fail("a face needs at least three vertices");
+
+            for (size_t i = 1; i + 1 < polygon.size(); ++i) {
+                chunk.faces.push_back({polygon[0], polygon[i], polygon[i + 1],
+                                       DEFAULT_FACE_COLOR[0], DEFAULT_FACE_COLOR[1],
+                                       DEFAULT_FACE_COLOR[2], DEFAULT_FACE_COLOR[3]});
+            }
+        } else if (keyword == "usemtl") {
+            std::string_view material = line.word();
+            if (material != currentMaterial) {
+                currentMaterial = material;
+                chunk.materialRanges.push_back({chunk.faces.size(), std::string(material)});
+            }
+        } else if (keyword == "o" || keyword == "g") {
+            chunk.groupRanges.push_back({chunk.faces.size(), std::string(line.word())});
+        } else if (keyword == "mtllib") {
+            if (chunk.mtlFilename.empty()) chunk.mtlFilename = std::string(line.word());
+        }
+    });
+}
+}
+
+ObjMesh ObjReader::read(const std::string& filename) {
+    MappedFile file(filename);
+    ObjMesh mesh = parse(file.view());
+    applyMaterials(mesh, filename);
+    return mesh;
+}
+
+ObjMesh ObjReader::parse(std::string_view text) {
+    ThreadPool& pool = ThreadPool::getInstance();
+    size_t chunkCount = std::clamp<size_t>(text.size() / MIN_CHUNK_SIZE, 1,
+                                           (pool.getThreadCount() + 1) * CHUNKS_PER_THREAD);
+    std::vector<Chunk> chunks = splitIntoChunks(text, chunkCount);
+
+    pool.parallelFor(chunks.size(), [&chunks](size_t i) { countChunk(chunks[i]); });
+
+    size_t totalVertices = 0;
+    size_t totalLines = 0;
+    for (auto& chunk : chunks) {
+        chunk.firstVertex = totalVertices;
+        chunk.firstLine = totalLines;
+        totalVertices += chunk.vertexCount;
+        totalLines += chunk.lineCount;
+    }
+
+    ObjMesh mesh;
+    mesh.vertices.resize(totalVertices);
+    Vector3* vertices = mesh.vertices.data();
+    pool.parallelFor(chunks.size(), [&chunks, vertices](size_t i) { parseChunk(chunks[i], vertices); });
+
+    std::vector<size_t> firstFaces(chunks.size());
+    size_t totalFaces = 0;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        firstFaces[i] = totalFaces;
+        totalFaces += chunks[i].faces.size();
+    }
+
+    mesh.faces.resize(totalFaces);
+    pool.parallelFor(chunks.size(), [&](size_t i) {
+        std::copy(chunks[i].faces.begin(), chunks[i].faces.end(), mesh.faces.begin() + firstFaces[i]);
+        std::vector<std::array<int, 7>>().swap(chunks[i].faces);
+    });
+
+    // A range carries over a chunk boundary unless the next chunk switches to something else
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        for (auto& range : chunks[i].materialRanges) {
+            if (!mesh.materialRanges.empty() && mesh.materialRanges.back().material == range.material) continue;
+            mesh.materialRanges.push_back({range.firstFace + firstFaces[i], std::move(range.material)});
+        }
+        for (auto& range : chunks[i].groupRanges) {
+            mesh.groupRanges.push_back({range.firstFace + firstFaces[i], std::move(range.name)});
+        }
+        if (mesh.mtlFilename.empty()) {
+            mesh.mtlFilename = std::move(chunks[i].mtlFilename);
+        }
+    }
+
+    return mesh;
+}
+
+void ObjReader::applyMaterials(ObjMesh& mesh, const std::string& objFilename) {
+    if (mesh.mtlFilename.empty() || mesh.materialRanges.empty()) return;
+
+    fs::path mtlPath = fs::path(objFilename).parent_path() / mesh.mtlFilename;
+    if (!fs::exists(mtlPath)) {
+        std::cerr << "Material library not found: " << mtlPath.string() << std::endl;
+        return;
+    }
+
+    MtlFile mtlFile;
+    mtlFile.read(mtlPath.string());
+    const auto& materials = mtlFile.getMaterials();
+
+    for (size_t i = 0; i < mesh.materialRanges.size(); ++i) {
+        auto it = materials.find(mesh.materialRanges[i].material);
+        if (it == materials.end()) continue;
+
+        const RgbaColor& color = it->second;
+        std::array<int, 4> rgba = {
+            static_cast<int>(color.r * 255.0f + 0.5f),
+            static_cast<int>(color.g * 255.0f + 0.5f),
+            static_cast<int>(color.b * 255.0f + 0.5f),
+            static_cast<int>(color.a * 255.0f + 0.5f)
+        };
+
+        size_t firstFace = mesh.materialRanges[i].firstFace;
+        size_t lastFace = i + 1 < mesh.materialRanges.size() ? mesh.materialRanges[i + 1].firstFace : mesh.faces.size();
+        for (size_t face = firstFace; face < lastFace; ++face) {
+            std::copy(rgba.begin(), rgba.end(), mesh.faces[face].begin() + 3);
+        }
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef OBJ_READER_HPP
+#define OBJ_READER_HPP
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../math/Vector3.hpp"
+
+struct ObjMaterialRange {
+    size_t firstFace;
+    std::string material;
+};
+
+struct ObjGroupRange {
+    size_t firstFace;
+    std::string name;
+};
+
+struct ObjMesh {
+    std::vector<Vector3> vertices;
+    std::vector<std::array<int, 7>> faces;
+    std::vector<ObjMaterialRange> materialRanges;
+    std::vector<ObjGroupRange> groupRanges;
+    std::string mtlFilename;
+};
+
+// Wavefront OBJ reader that parses straight from a memory-mapped file. Supports v/vt/vn face
+// references, negative (relative) indices and polygons, which are fan-triangulated.
+// Large files are split at line boundaries and parsed on the thread pool. Malformed input
+// throws std::runtime_error naming the offending line.
+class ObjReader {
+public:
+    static ObjMesh read(const std::string& filename);
+    static ObjMesh parse(std::string_view text);
+
+    // Colours faces from the material library referenced by the mesh, when it can be found
+    static void applyMaterials(ObjMesh& mesh, const std::string& objFilename);
+};
+
+#endif
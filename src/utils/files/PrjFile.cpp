@@ -1,7 +1,238 @@
 #include "PrjFile.hpp"
+#include "MappedFile.hpp"
+#include "../../core/objects/Object3d.hpp"
 #include <fstream>
 #include <stdexcept>
 #include <iostream>
+#include <string_view>
+
+namespace {
+struct ObjectSize {
+    size_t vertices = 0;
+    size_t faces = 0;
+};
+
+// Counts the vertex and face arrays of every object with a plain bracket scan, far cheaper
+// than a second full parse. Malformed input is left for the SAX pass to report.
+std::vector<ObjectSize> countObjectSizes(const char* data, size_t size) {
+    std::vector<ObjectSize> sizes;
+    std::vector<std::string_view> openers;
+    std::string_view lastString;
+    std::string_view key;
+
+    for (size_t i = 0; i < size; ++i) {
+        switch (data[i]) {
+            case '"': {
+                size_t start = ++i;
+                while (i < size && data[i] != '"') {
+                    i += data[i] == '\\' ? 2 : 1;
+                }
+                lastString = std::string_view(data + start, std::min(i, size) - start);
+                break;
+            }
+            case ':':
+                key = lastString;
+                break;
+            case ',':
+                key = {};
+                break;
+            case '{':
+                if (openers.size() == 2 && openers[1] == "objects") {
+                    sizes.emplace_back();
+                }
+                openers.push_back(key);
+                key = {};
+                break;
+            case '[':
+                if (openers.size() == 4 && openers[1] == "objects" && !sizes.empty()) {
+                    if (openers[3] == "vertices") {
+                        ++sizes.back().vertices;
+                    } else if (openers[3] == "faces") {
+                        ++sizes.back().faces;
+                    }
+                }
+                openers.push_back(key);
+                key = {};
+                break;
+            case ']':
+            case '}':
+                if (!openers.empty()) {
+                    openers.pop_back();
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return sizes;
+}
+
+// Follows the project layout through nlohmann's SAX events, writing values straight into
+// storage reserved from the counted sizes
+class ProjectSaxHandler : public nlohmann::json_sax<nlohmann::json> {
+public:
+    ProjectSaxHandler(const std::vector<ObjectSize>& sizes, ProjectData& project) : sizes(sizes), project(project) {}
+
+    bool null() override { return skipValue(); }
+    bool boolean(bool) override { return skipValue(); }
+    bool number_integer(number_integer_t value) override { return number(value); }
+    bool number_unsigned(number_unsigned_t value) override { return number(value); }
+    bool number_float(number_float_t value, const string_t&) override { return number(value); }
+    bool string(string_t&) override { return skipValue(); }
+    bool binary(binary_t&) override { return skipValue(); }
+
+    bool key(string_t& value) override {
+        currentKey = value;
+        return true;
+    }
+
+    bool start_object(std::size_t) override {
+        Scope scope = Scope::Skip;
+        if (frames.empty()) {
+            scope = Scope::Root;
+        } else if (parent() == Scope::Root && currentKey == "camera") {
+            scope = Scope::Camera;
+        } else if (parent() == Scope::Objects) {
+            scope = Scope::Object;
+            beginObject();
+        }
+        frames.push_back({scope, 0});
+        return true;
+    }
+
+    bool end_object() override {
+        frames.pop_back();
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        Scope scope = Scope::Skip;
+        Scope outer = frames.empty() ? Scope::Skip : parent();
+        if (outer == Scope::Root && currentKey == "objects") {
+            scope = Scope::Objects;
+        } else if (outer == Scope::Camera && (currentKey == "position" || currentKey == "orbitCenter")) {
+            scope = Scope::Vector;
+            vectorTarget = currentKey == "position" ? &project.camera.position : &project.camera.orbitCenter;
+        } else if (outer == Scope::Object && currentKey == "vertices") {
+            scope = Scope::VertexList;
+        } else if (outer == Scope::Object && currentKey == "faces") {
+            scope = Scope::FaceList;
+        } else if (outer == Scope::Object &&
+                   (currentKey == "position" || currentKey == "rotation" || currentKey == "scale")) {
+            scope = Scope::Vector;
+            ProjectObject& object = project.objects.back();
+            vectorTarget = currentKey == "position" ? &object.position
+                         : currentKey == "rotation" ? &object.rotation
+                         : &object.scale;
+        } else if (outer == Scope::VertexList) {
+            scope = Scope::Vertex;
+            project.objects.back().vertices.emplace_back();
+        } else if (outer == Scope::FaceList) {
+            scope = Scope::Face;
+            project.objects.back().faces.emplace_back();
+        }
+        frames.push_back({scope, 0});
+        return true;
+    }
+
+    bool end_array() override {
+        const Frame& frame = frames.back();
+        if ((frame.scope == Scope::Vector || frame.scope == Scope::Vertex) && frame.count != 3) {
+            throw std::runtime_error("Project file has a vector without exactly 3 components");
+        }
+        if (frame.scope == Scope::Face && frame.count != 7) {
+            throw std::runtime_error("Project file has a face without exactly 7 values");
+        }
+        frames.pop_back();
+        return true;
+    }
+
+    bool parse_error(std::size_t position, const std::string&, const nlohmann::detail::exception& ex) override {
+        throw std::runtime_error("Invalid project JSON at byte " + std::to_string(position) + ": " + ex.what());
+    }
+
+private:
+    enum class Scope { Root, Camera, Objects, Object, Vector, VertexList, Vertex, FaceList, Face, Skip };
+
+    struct Frame {
+        Scope scope;
+        int count;
+    };
+
+    Scope parent() const {
+        return frames.back().scope;
+    }
+
+    void beginObject() {
+        size_t index = project.objects.size();
+        ProjectObject& object = project.objects.emplace_back();
+        if (index < sizes.size()) {
+            object.vertices.reserve(sizes[index].vertices);
+            object.faces.reserve(sizes[index].faces);
+        }
+    }
+
+    static void setComponent(Vector3& vector, int component, float value) {
+        if (component == 0) {
+            vector.x = value;
+        } else if (component == 1) {
+            vector.y = value;
+        } else {
+            vector.z = value;
+        }
+    }
+
+    template <typename T>
+    bool number(T value) {
+        if (frames.empty()) {
+            return true;
+        }
+        Frame& frame = frames.back();
+        int component = frame.count++;
+
+        switch (frame.scope) {
+            case Scope::Vector:
+                if (component < 3) {
+                    setComponent(*vectorTarget, component, static_cast<float>(value));
+                }
+                break;
+            case Scope::Vertex:
+                if (component < 3) {
+                    setComponent(project.objects.back().vertices.back(), component, static_cast<float>(value));
+                }
+                break;
+            case Scope::Face:
+                if (component < 7) {
+                    project.objects.back().faces.back()[component] = static_cast<int>(value);
+                }
+                break;
+            case Scope::Camera:
+                if (currentKey == "yaw") {
+                    project.camera.yaw = static_cast<float>(value);
+                } else if (currentKey == "pitch") {
+                    project.camera.pitch = static_cast<float>(value);
+                }
+                break;
+            default:
+                break;
+        }
+        return true;
+    }
+
+    bool skipValue() {
+        if (!frames.empty()) {
+            ++frames.back().count;
+        }
+        return true;
+    }
+
+    const std::vector<ObjectSize>& sizes;
+    ProjectData& project;
+    std::vector<Frame> frames;
+    std::string currentKey;
+    Vector3* vectorTarget = nullptr;
+};
+}
 
 void PrjFile::read(const std::string& filename) {
     try {
@@ -47,6 +278,73 @@ void PrjFile::addObject(const nlohmann::json& object) {
     projectData["objects"].push_back(object);
 }
 
+void PrjFile::addObject(const Object3d& object) {
+    nlohmann::json objJson;
+    objJson["position"] = {object.getPosition().x, object.getPosition().y, object.getPosition().z};
+    objJson["rotation"] = {object.getRotation().x, object.getRotation().y, object.getRotation().z};
+    objJson["scale"] = {object.getScale().x, object.getScale().y, object.getScale().z};
+    objJson["vertices"] = nlohmann::json::array();
+    for (const auto& vertex : object.getVertices()) {
+        objJson["vertices"].push_back({vertex.x, vertex.y, vertex.z});
+    }
+    objJson["faces"] = nlohmann::json::array();
+    for (const auto& face : object.getFaces()) {
+        objJson["faces"].push_back({face[0], face[1], face[2], face[3], face[4], face[5], face[6]});
+    }
+
+    projectData["objects"].push_back(std::move(objJson));
+}
+
+ProjectData PrjFile::toProjectData() const {
+    auto toVector = [](const nlohmann::json& value) {
+        return Vector3(value[0].get<float>(), value[1].get<float>(), value[2].get<float>());
+    };
+
+    ProjectData project;
+    const auto& camera = projectData.at("camera");
+    project.camera.position = toVector(camera.at("position"));
+    project.camera.yaw = camera.at("yaw").get<float>();
+    project.camera.pitch = camera.at("pitch").get<float>();
+    project.camera.orbitCenter = toVector(camera.at("orbitCenter"));
+
+    for (const auto& objJson : projectData.at("objects")) {
+        ProjectObject object;
+        object.position = toVector(objJson.at("position"));
+        object.rotation = toVector(objJson.at("rotation"));
+        object.scale = toVector(objJson.at("scale"));
+
+        object.vertices.reserve(objJson.at("vertices").size());
+        for (const auto& vertex : objJson.at("vertices")) {
+            object.vertices.push_back(toVector(vertex));
+        }
+        object.faces.reserve(objJson.at("faces").size());
+        for (const auto& face : objJson.at("faces")) {
+            object.faces.push_back({face[0].get<int>(), face[1].get<int>(), face[2].get<int>(), face[3].get<int>(),
+                                    face[4].get<int>(), face[5].get<int>(), face[6].get<int>()});
+        }
+        project.objects.push_back(std::move(object));
+    }
+    return project;
+}
+
+ProjectData PrjFile::load(const std::string& filename) {
+    try {
+        MappedFile file(filename);
+        const char* begin = file.data();
+        const char* end = begin + file.size();
+
+        std::vector<ObjectSize> sizes = countObjectSizes(begin, file.size());
+        ProjectData project;
+        project.objects.reserve(sizes.size());
+        ProjectSaxHandler loader(sizes, project);
+        nlohmann::json::sax_parse(begin, end, &loader);
+        return project;
+    } catch (const std::exception& e) {
+        std::cerr << "Error reading project file: " << e.what() << std::endl;
+        throw;
+    }
+}
+
 const nlohmann::json& PrjFile::getCamera() const {
     return projectData["camera"];
 }
@@ -4,6 +4,9 @@
 #include "JsonFile.hpp"
 #include <nlohmann/json.hpp>
 #include "../math/Vector3.hpp"
+#include "ProjectData.hpp"
+
+class Object3d;
 
 class PrjFile : public FileType {
 public:
@@ -15,6 +18,12 @@ public:
 
     void setCamera(Vector3 position, float yaw, float pitch, Vector3 orbitCenter);
     void addObject(const nlohmann::json& object);
+    void addObject(const Object3d& object);
+
+    ProjectData toProjectData() const;
+
+    // Streams a project straight into mesh storage without building a DOM
+    static ProjectData load(const std::string& filename);
 
     const nlohmann::json& getCamera() const;
     const std::vector<nlohmann::json>& getObjects() const;
@@ -0,0 +1,32 @@
+#ifndef PROJECT_DATA_HPP
+#define PROJECT_DATA_HPP
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "../math/Vector3.hpp"
+
+struct ProjectCamera {
+    Vector3 position{-1.5f, 2.0f, -15.0f};
+    float yaw = -2.0f;
+    float pitch = -5.0f;
+    Vector3 orbitCenter;
+};
+
+struct ProjectObject {
+    Vector3 position;
+    Vector3 rotation;
+    Vector3 scale{1.0f, 1.0f, 1.0f};
+    std::vector<Vector3> vertices;
+    std::vector<std::array<int, 7>> faces;
+};
+
+// Format-independent project contents, filled by the JSON and binary project readers
+struct ProjectData {
+    // Identifies the save an edit journal was recorded against; 0 when unknown
+    uint64_t saveId = 0;
+    ProjectCamera camera;
+    std::vector<ProjectObject> objects;
+};
+
+#endif
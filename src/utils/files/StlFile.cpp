@@ -0,0 +1,317 @@
+#include "StlFile.hpp"
+#include "BufferedWriter.hpp"
+#include "MappedFile.hpp"
+#include "../../core/objects/Object3d.hpp"
+#include "../math/Vector4.hpp"
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+constexpr size_t HEADER_SIZE = 80;
+constexpr size_t FACET_SIZE = 50;
+constexpr std::array<int, 4> DEFAULT_FACE_COLOR = {128, 128, 128, 255};
+constexpr char EXPORT_HEADER[] = "3D editor binary STL export";
+// Set on facets whose attribute carries a colour (VisCAM/SolidView); Magics clears it instead
+constexpr uint16_t COLOR_FLAG = 0x8000;
+
+int expandChannel(uint16_t value) {
+    value &= 0x1F;
+    return (value << 3) | (value >> 2);
+}
+
+// Merges vertices with identical coordinates. STL repeats every shared corner bit for bit, so an
+// exact hash of the float bits is enough and much cheaper than a tolerance grid.
+class ExactWelder {
+public:
+    explicit ExactWelder(size_t expectedVertices) {
+        size_t capacity = 1024;
+        while (capacity < expectedVertices * 2) capacity <<= 1;
+        slots.assign(capacity, -1);
+        vertices.reserve(expectedVertices);
+    }
+
+    int add(const float* position) {
+        // Adding zero turns -0 into +0 so both weld together
+        Vector3 vertex(position[0] + 0.0f, position[1] + 0.0f, position[2] + 0.0f);
+        if ((vertices.size() + 1) * 2 > slots.size()) {
+            grow();
+        }
+        size_t mask = slots.size() - 1;
+        for (size_t slot = hash(vertex) & mask;; slot = (slot + 1) & mask) {
+            int index = slots[slot];
+            if (index < 0) {
+                index = static_cast<int>(vertices.size());
+                slots[slot] = index;
+                vertices.push_back(vertex);
+                return index;
+            }
+            if (sameBits(vertices[index], vertex)) {
+                return index;
+            }
+        }
+    }
+
+    std::vector<Vector3> releaseVertices() {
+        return std::move(vertices);
+    }
+
+private:
+    static uint64_t hash(const Vector3& vertex) {
+        uint32_t bits[3];
+        std::memcpy(bits, &vertex, sizeof(bits));
+        uint64_t value = (static_cast<uint64_t>(bits[0]) | (static_cast<uint64_t>(bits[1]) << 32)) * 0x9E3779B97F4A7C15ull;
+        value ^= static_cast<uint64_t>(bits[2]) * 0xC2B2AE3D27D4EB4Full;
+        return value ^ (value >> 29);
+    }
+
+    static bool sameBits(const Vector3& a, const Vector3& b) {
+        return std::memcmp(&a, &b, sizeof(Vector3)) == 0;
+    }
+
+    void grow() {
+        std::vector<int> grown(slots.size() * 2, -1);
+        size_t mask = grown.size() - 1;
+        for (size_t index = 0; index < vertices.size(); ++index) {
+            size_t slot = hash(vertices[index]) & mask;
+            while (grown[slot] >= 0) slot = (slot + 1) & mask;
+            grown[slot] = static_cast<int>(index);
+        }
+        slots = std::move(grown);
+    }
+
+    std::vector<int> slots;
+    std::vector<Vector3> vertices;
+};
+
+class AsciiParser {
+public:
+    explicit AsciiParser(std::string_view text) : current(text.data()), end(text.data() + text.size()) {}
+
+    std::string_view word() {
+        skipSpaces();
+        const char* start = current;
+        while (current < end && !isSpace(*current)) ++current;
+        return std::string_view(start, static_cast<size_t>(current - start));
+    }
+
+    float number() {
+        skipSpaces();
+        if (current < end && *current == '+') ++current;
+        float value = 0.0f;
+        auto [next, error] = std::from_chars(current, end, value);
+        if (error != std::errc()) fail("expected a number");
+        current = next;
+        return value;
+    }
+
+    void skipLine() {
+        while (current < end && *current != '\n') ++current;
+    }
+
+    [[noreturn]] void fail(const std::string& message) const {
+        throw std::runtime_error("STL line " + std::to_string(lineNumber) + ": " + message);
+    }
+
+private:
+    static bool isSpace(char character) {
+        return character == ' ' || character == '\t' || character == '\r' || character == '\n';
+    }
+
+    void skipSpaces() {
+        while (current < end && isSpace(*current)) {
+            if (*current == '\n') lineNumber++;
+            ++current;
+        }
+    }
+
+    const char* current;
+    const char* end;
+    size_t lineNumber = 1;
+};
+
+void writeFacets(BufferedWriter& writer, const std::vector<Vector3>& vertices,
+                 const std::vector<std::array<int, 7>>& faces, const Matrix4* transform, bool mirrored) {
+    char facet[FACET_SIZE];
+    for (const auto& face : faces) {
+        float corners[3][3];
+        int order[3] = {face[0], mirrored ? face[2] : face[1], mirrored ? face[1] : face[2]};
+        for (int k = 0; k < 3; ++k) {
+            Vector3 vertex = vertices[order[k]];
+            if (transform) {
+                Vector4 world = *transform * Vector4(vertex, 1.0f);
+                vertex = Vector3(world.x, world.y, world.z);
+            }
+            corners[k][0] = vertex.x;
+            corners[k][1] = vertex.y;
+            corners[k][2] = vertex.z;
+        }
+
+        Vector3 a(corners[0][0], corners[0][1], corners[0][2]);
+        Vector3 normal = (Vector3(corners[1][0], corners[1][1], corners[1][2]) - a)
+            .cross(Vector3(corners[2][0], corners[2][1], corners[2][2]) - a);
+        float length = normal.length();
+        float normalValues[3] = {0.0f, 0.0f, 0.0f};
+        if (length > 0.0f) {
+            normalValues[0] = normal.x / length;
+            normalValues[1] = normal.y / length;
+            normalValues[2] = normal.z / length;
+        }
+
+        uint16_t attribute = COLOR_FLAG |
+            static_cast<uint16_t>(((face[3] & 0xFF) >> 3) << 10) |
+            static_cast<uint16_t>(((face[4] & 0xFF) >> 3) << 5) |
+            static_cast<uint16_t>((face[5] & 0xFF) >> 3);
+
+        std::memcpy(facet, normalValues, sizeof(normalValues));
+        std::memcpy(facet + 12, corners, sizeof(corners));
+        std::memcpy(facet + 48, &attribute, sizeof(attribute));
+        writer.write(std::string_view(facet, sizeof(facet)));
+    }
+}
+}
+
+StlFile::StlFile(std::vector<std::shared_ptr<Object3d>> objects) : objects(std::move(objects)) {}
+
+const std::vector<Vector3>& StlFile::getVertices() const {
+    return vertices;
+}
+
+const std::vector<std::array<int, 7>>& StlFile::getFaces() const {
+    return faces;
+}
+
+std::vector<Vector3> StlFile::releaseVertices() {
+    return std::move(vertices);
+}
+
+std::vector<std::array<int, 7>> StlFile::releaseFaces() {
+    return std::move(faces);
+}
+
+bool StlFile::isBinary(std::string_view data) {
+    if (data.size() < HEADER_SIZE + 4) return false;
+    uint32_t facetCount;
+    std::memcpy(&facetCount, data.data() + HEADER_SIZE, sizeof(facetCount));
+    return data.size() == HEADER_SIZE + 4 + static_cast<uint64_t>(facetCount) * FACET_SIZE;
+}
+
+void StlFile::read(const std::string& filename) {
+    MappedFile file(filename);
+    vertices.clear();
+    faces.clear();
+    // Some exporters start binary headers with "solid" too, so the size check comes first
+    if (isBinary(file.view())) {
+        readBinary(file.view());
+    } else if (file.view().substr(0, 5) == "solid") {
+        readAscii(file.view());
+    } else {
+        throw std::runtime_error("Not an STL file: " + filename);
+    }
+}
+
+void StlFile::readBinary(std::string_view data) {
+    uint32_t facetCount;
+    std::memcpy(&facetCount, data.data() + HEADER_SIZE, sizeof(facetCount));
+    if (facetCount > static_cast<uint32_t>(std::numeric_limits<int>::max() / 3)) {
+        throw std::runtime_error("STL has too many facets: " + std::to_string(facetCount));
+    }
+
+    // Magics stores a default colour in the header and marks facets with their own by clearing the flag
+    std::string_view header = data.substr(0, HEADER_SIZE);
+    size_t colorField = header.find("COLOR=");
+    bool magics = colorField != std::string_view::npos && colorField + 10 <= HEADER_SIZE;
+    std::array<int, 4> defaultColor = DEFAULT_FACE_COLOR;
+    if (magics) {
+        for (int k = 0; k < 4; ++k) {
+            defaultColor[k] = static_cast<uint8_t>(header[colorField + 6 + k]);
+        }
+    }
+
+    // Closed meshes have about half as many vertices as facets
+    ExactWelder welder(facetCount / 2);
+    faces.resize(facetCount);
+    const char* facet = data.data() + HEADER_SIZE + 4;
+    for (uint32_t i = 0; i < facetCount; ++i, facet += FACET_SIZE) {
+        float corners[9];
+        uint16_t attribute;
+        std::memcpy(corners, facet + 12, sizeof(corners));
+        std::memcpy(&attribute, facet + 48, sizeof(attribute));
+
+        std::array<int, 4> color = defaultColor;
+        if (magics && !(attribute & COLOR_FLAG)) {
+            color = {expandChannel(attribute), expandChannel(attribute >> 5), expandChannel(attribute >> 10), 255};
+        } else if (!magics && (attribute & COLOR_FLAG)) {
+            color = {expandChannel(attribute >> 10), expandChannel(attribute >> 5), expandChannel(attribute), 255};
+        }
+
+        faces[i] = {welder.add(corners), welder.add(corners + 3), welder.add(corners + 6),
+                    color[0], color[1], color[2], color[3]};
+    }
+    vertices = welder.releaseVertices();
+}
+
+void StlFile::readAscii(std::string_view data) {
+    ExactWelder welder(data.size() / 256);
+    AsciiParser parser(data);
+    std::vector<int> facetCorners;
+    for (std::string_view word = parser.word(); !word.empty(); word = parser.word()) {
+        if (word == "solid" || word == "endsolid") {
+            // Names run to the end of the line
+            parser.skipLine();
+        } else if (word == "facet") {
+            facetCorners.clear();
+        } else if (word == "vertex") {
+            float corner[3] = {parser.number(), parser.number(), parser.number()};
+            facetCorners.push_back(welder.add(corner));
+        } else if (word == "endfacet") {
+            if (facetCorners.size() < 3) parser.fail("facet has fewer than 3 vertices");
+            // Polygons are fan-triangulated, as in OBJ import
+            for (size_t k = 1; k + 1 < facetCorners.size(); ++k) {
+                faces.push_back({facetCorners[0], facetCorners[k], facetCorners[k + 1],
+                                 DEFAULT_FACE_COLOR[0], DEFAULT_FACE_COLOR[1], DEFAULT_FACE_COLOR[2], DEFAULT_FACE_COLOR[3]});
+            }
+        } else if (word == "normal") {
+            parser.number();
+            parser.number();
+            parser.number();
+        } else if (word != "outer" && word != "loop" && word != "endloop") {
+            parser.fail("unexpected '" + std::string(word) + "'");
+        }
+    }
+    vertices = welder.releaseVertices();
+}
+
+void StlFile::write(const std::string& filename) {
+    uint64_t facetCount = 0;
+    for (const auto& object : objects) {
+        facetCount += object->getFaces().size();
+    }
+    if (objects.empty()) {
+        facetCount = faces.size();
+    }
+    if (facetCount > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("Too many faces for STL: " + std::to_string(facetCount));
+    }
+
+    BufferedWriter writer(filename);
+    char header[HEADER_SIZE] = {};
+    std::memcpy(header, EXPORT_HEADER, sizeof(EXPORT_HEADER) - 1);
+    writer.write(std::string_view(header, sizeof(header)));
+    uint32_t count = static_cast<uint32_t>(facetCount);
+    writer.write(std::string_view(reinterpret_cast<const char*>(&count), sizeof(count)));
+
+    if (objects.empty()) {
+        writeFacets(writer, vertices, faces, nullptr, false);
+    }
+    for (const auto& object : objects) {
+        // A mirroring scale turns faces inside out unless the winding is flipped too
+        Vector3 scale = object->getScale();
+        writeFacets(writer, object->getVertices(), object->getFaces(), &object->getTransformation(),
+                    scale.x * scale.y * scale.z < 0.0f);
+    }
+    writer.close();
+}
@@ -0,0 +1,45 @@
+#ifndef STL_FILE_HPP
+#define STL_FILE_HPP
+
+#include <array>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "FileType.hpp"
+#include "../math/Vector3.hpp"
+
+class Object3d;
+
+// Stereolithography mesh, binary or ASCII. Binary files are read straight from a memory mapping
+// and vertices shared between facets are welded as they are read. Facet colours follow the
+// VisCAM/SolidView attribute convention, or Materialise Magics' when the header declares a
+// COLOR. Writing produces binary STL in world space, streamed from the objects' own buffers.
+class StlFile : public FileType {
+public:
+    StlFile() = default;
+    // Prepares the objects for write()
+    explicit StlFile(std::vector<std::shared_ptr<Object3d>> objects);
+
+    void read(const std::string& filename) override;
+    // Writes the objects given to the constructor, or else the mesh last read
+    void write(const std::string& filename) override;
+
+    const std::vector<Vector3>& getVertices() const;
+    const std::vector<std::array<int, 7>>& getFaces() const;
+    std::vector<Vector3> releaseVertices();
+    std::vector<std::array<int, 7>> releaseFaces();
+
+    // Binary files carry a facet count that must match their size; ASCII ones start with "solid"
+    static bool isBinary(std::string_view data);
+
+private:
+    void readBinary(std::string_view data);
+    void readAscii(std::string_view data);
+
+    std::vector<std::shared_ptr<Object3d>> objects;
+    std::vector<Vector3> vertices;
+    std::vector<std::array<int, 7>> faces;
+};
+
+#endif
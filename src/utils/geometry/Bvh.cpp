@@ -0,0 +1,257 @@
+#include "Bvh.hpp"
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace {
+    constexpr float RAY_T_EPSILON = 1e-6f;
+    constexpr float RAY_EDGE_EPSILON = 1e-5f;
+
+    // Ray directions used for parity tests; deliberately not aligned with any axis
+    const Vector3 RAY_DIRECTIONS[] = {
+        Vector3(0.5773f, 0.5774f, 0.5773f),
+        Vector3(-0.3714f, 0.7428f, 0.5571f),
+        Vector3(0.8017f, -0.2673f, 0.5345f),
+        Vector3(-0.4082f, -0.4082f, 0.8165f),
+        Vector3(0.2357f, 0.9428f, -0.2357f),
+    };
+
+    inline Vector3 sub(const Vector3& a, const Vector3& b) {
+        return Vector3(a.x - b.x, a.y - b.y, a.z - b.z);
+    }
+
+    inline Vector3 cross(const Vector3& a, const Vector3& b) {
+        return Vector3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+    }
+
+    inline float dot(const Vector3& a, const Vector3& b) {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    inline float axis(const Vector3& v, int index) {
+        return index == 0 ? v.x : (index == 1 ? v.y : v.z);
+    }
+
+    // Descend into the larger box first so both trees shrink at a similar rate
+    inline float boxSize(const Aabb& box) {
+        return (box.max.x - box.min.x) + (box.max.y - box.min.y) + (box.max.z - box.min.z);
+    }
+
+    bool rayHitsBox(const Aabb& box, const Vector3& origin, const Vector3& inverseDirection) {
+        float tMin = 0.0f;
+        float tMax = std::numeric_limits<float>::max();
+        for (int i = 0; i < 3; ++i) {
+            float t1 = (axis(box.min, i) - axis(origin, i)) * axis(inverseDirection, i);
+            float t2 = (axis(box.max, i) - axis(origin, i)) * axis(inverseDirection, i);
+            tMin = std::max(tMin, std::min(t1, t2));
+            tMax = std::min(tMax, std::max(t1, t2));
+        }
+        return tMin <= tMax;
+    }
+}
+
+Aabb Aabb::empty() {
+    const float inf = std::numeric_limits<float>::max();
+    return Aabb{Vector3(inf, inf, inf), Vector3(-inf, -inf, -inf)};
+}
+
+Aabb Aabb::ofTriangle(const MeshTriangle& triangle) {
+    Aabb box = empty();
+    box.expand(triangle.v1);
+    box.expand(triangle.v2);
+    box.expand(triangle.v3);
+    return box;
+}
+
+void Aabb::expand(const Vector3& point) {
+    min.x = std::min(min.x, point.x);
+    min.y = std::min(min.y, point.y);
+    min.z = std::min(min.z, point.z);
+    max.x = std::max(max.x, point.x);
+    max.y = std::max(max.y, point.y);
+    max.z = std::max(max.z, point.z);
+}
+
+void Aabb::expand(const Aabb& other) {
+    expand(other.min);
+    expand(other.max);
+}
+
+bool Aabb::overlaps(const Aabb& other) const {
+    return min.x <= other.max.x && max.x >= other.min.x &&
+           min.y <= other.max.y && max.y >= other.min.y &&
+           min.z <= other.max.z && max.z >= other.min.z;
+}
+
+Vector3 Aabb::center() const {
+    return Vector3((min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f, (min.z + max.z) * 0.5f);
+}
+
+TriangleBvh::TriangleBvh(const std::vector<MeshTriangle>& triangles) : triangles(triangles) {
+    triangleBounds.reserve(triangles.size());
+    centroids.reserve(triangles.size());
+    order.resize(triangles.size());
+    for (size_t i = 0; i < triangles.size(); ++i) {
+        triangleBounds.push_back(Aabb::ofTriangle(triangles[i]));
+        centroids.push_back(triangleBounds.back().center());
+        order[i] = static_cast<int>(i);
+    }
+
+    nodes.reserve(triangles.empty() ? 1 : 2 * (triangles.size() / LEAF_SIZE + 1));
+    build(0, static_cast<int>(triangles.size()));
+}
+
+int TriangleBvh::build(int first, int count) {
+    int index = static_cast<int>(nodes.size());
+    nodes.emplace_back();
+
+    Aabb bounds = Aabb::empty();
+    Aabb centroidBounds = Aabb::empty();
+    for (int i = first; i < first + count; ++i) {
+        bounds.expand(triangleBounds[order[i]]);
+        centroidBounds.expand(centroids[order[i]]);
+    }
+    nodes[index].bounds = bounds;
+
+    if (count <= LEAF_SIZE) {
+        nodes[index].first = first;
+        nodes[index].count = count;
+        return index;
+    }
+
+    Vector3 extent = sub(centroidBounds.max, centroidBounds.min);
+    int splitAxis = 0;
+    if (extent.y > extent.x) splitAxis = 1;
+    if (extent.z > axis(extent, splitAxis)) splitAxis = 2;
+
+    int half = count / 2;
+    std::nth_element(order.begin() + first, order.begin() + first + half, order.begin() + first + count,
+        [this, splitAxis](int a, int b) {
+            return axis(centroids[a], splitAxis) < axis(centroids[b], splitAxis);
+        });
+
+    int left = build(first, half);
+    int right = build(first + half, count - half);
+    nodes[index].left = left;
+    nodes[index].right = right;
+    return index;
+}
+
+const Aabb& TriangleBvh::getBounds() const {
+    return nodes[0].bounds;
+}
+
+std::vector<std::pair<int, int>> TriangleBvh::findOverlappingPairs(const TriangleBvh& other) const {
+    std::vector<std::pair<int, int>> pairs;
+    if (triangles.empty() || other.triangles.empty()) {
+        return pairs;
+    }
+
+    std::vector<std::pair<int, int>> stack;
+    stack.emplace_back(0, 0);
+    while (!stack.empty()) {
+        auto [a, b] = stack.back();
+        stack.pop_back();
+
+        const Node& nodeA = nodes[a];
+        const Node& nodeB = other.nodes[b];
+        if (!nodeA.bounds.overlaps(nodeB.bounds)) continue;
+
+        if (nodeA.isLeaf() && nodeB.isLeaf()) {
+            for (int i = nodeA.first; i < nodeA.first + nodeA.count; ++i) {
+                int triangleA = order[i];
+                for (int j = nodeB.first; j < nodeB.first + nodeB.count; ++j) {
+                    int triangleB = other.order[j];
+                    if (triangleBounds[triangleA].overlaps(other.triangleBounds[triangleB])) {
+                        pairs.emplace_back(triangleA, triangleB);
+                    }
+                }
+            }
+        } else if (nodeB.isLeaf() || (!nodeA.isLeaf() && boxSize(nodeA.bounds) >= boxSize(nodeB.bounds))) {
+            stack.emplace_back(nodeA.left, b);
+            stack.emplace_back(nodeA.right, b);
+        } else {
+            stack.emplace_back(a, nodeB.left);
+            stack.emplace_back(a, nodeB.right);
+        }
+    }
+    return pairs;
+}
+
+RayHits TriangleBvh::castRay(const Vector3& origin, const Vector3& direction) const {
+    RayHits hits;
+    if (triangles.empty()) {
+        return hits;
+    }
+
+    Vector3 inverseDirection(
+        direction.x != 0.0f ? 1.0f / direction.x : std::numeric_limits<float>::max(),
+        direction.y != 0.0f ? 1.0f / direction.y : std::numeric_limits<float>::max(),
+        direction.z != 0.0f ? 1.0f / direction.z : std::numeric_limits<float>::max()
+    );
+
+    std::vector<int> stack;
+    stack.push_back(0);
+    while (!stack.empty()) {
+        const Node& node = nodes[stack.back()];
+        stack.pop_back();
+        if (!rayHitsBox(node.bounds, origin, inverseDirection)) continue;
+
+        if (!node.isLeaf()) {
+            stack.push_back(node.left);
+            stack.push_back(node.right);
+            continue;
+        }
+
+        for (int i = node.first; i < node.first + node.count; ++i) {
+            const MeshTriangle& triangle = triangles[order[i]];
+            Vector3 edge1 = sub(triangle.v2, triangle.v1);
+            Vector3 edge2 = sub(triangle.v3, triangle.v1);
+            Vector3 p = cross(direction, edge2);
+            float determinant = dot(edge1, p);
+            if (std::abs(determinant) < 1e-12f) continue;
+
+            float inverseDeterminant = 1.0f / determinant;
+            Vector3 s = sub(origin, triangle.v1);
+            float u = dot(s, p) * inverseDeterminant;
+            if (u < -RAY_EDGE_EPSILON || u > 1.0f + RAY_EDGE_EPSILON) continue;
+
+            Vector3 q = cross(s, edge1);
+            float v = dot(direction, q) * inverseDeterminant;
+            if (v < -RAY_EDGE_EPSILON || u + v > 1.0f + RAY_EDGE_EPSILON) continue;
+
+            float t = dot(edge2, q) * inverseDeterminant;
+            if (t <= RAY_T_EPSILON) continue;
+
+            if (u < RAY_EDGE_EPSILON || v < RAY_EDGE_EPSILON || u + v > 1.0f - RAY_EDGE_EPSILON) {
+                hits.ambiguous = true;
+            }
+            hits.count++;
+        }
+    }
+    return hits;
+}
+
+bool TriangleBvh::containsPoint(const Vector3& point) const {
+    if (triangles.empty()) {
+        return false;
+    }
+    const Aabb& bounds = getBounds();
+    if (point.x < bounds.min.x || point.y < bounds.min.y || point.z < bounds.min.z ||
+        point.x > bounds.max.x || point.y > bounds.max.y || point.z > bounds.max.z) {
+        return false;
+    }
+
+    int insideVotes = 0;
+    int votes = 0;
+    for (const auto& direction : RAY_DIRECTIONS) {
+        RayHits hits = castRay(point, direction);
+        bool inside = hits.count % 2 == 1;
+        if (!hits.ambiguous) {
+            return inside;
+        }
+        insideVotes += inside ? 1 : 0;
+        votes++;
+    }
+    return insideVotes * 2 > votes;
+}
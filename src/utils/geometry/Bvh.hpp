@@ -0,0 +1,64 @@
+#ifndef BVH_HPP
+#define BVH_HPP
+
+#include "MeshTriangle.hpp"
+#include <vector>
+#include <utility>
+
+struct Aabb {
+    Vector3 min;
+    Vector3 max;
+
+    static Aabb empty();
+    static Aabb ofTriangle(const MeshTriangle& triangle);
+
+    void expand(const Vector3& point);
+    void expand(const Aabb& other);
+    bool overlaps(const Aabb& other) const;
+    Vector3 center() const;
+};
+
+struct RayHits {
+    int count = 0;
+    // A hit landed on an edge or vertex, so the parity of `count` cannot be trusted
+    bool ambiguous = false;
+};
+
+// Bounding volume hierarchy over a triangle list. The triangles are referenced, not copied,
+// and must outlive the tree.
+class TriangleBvh {
+public:
+    explicit TriangleBvh(const std::vector<MeshTriangle>& triangles);
+
+    const Aabb& getBounds() const;
+
+    // Pairs (this triangle, other triangle) whose bounding boxes overlap, found by
+    // descending both trees together.
+    std::vector<std::pair<int, int>> findOverlappingPairs(const TriangleBvh& other) const;
+
+    RayHits castRay(const Vector3& origin, const Vector3& direction) const;
+    bool containsPoint(const Vector3& point) const;
+
+private:
+    struct Node {
+        Aabb bounds;
+        int left = -1;
+        int right = -1;
+        int first = 0;
+        int count = 0;
+
+        bool isLeaf() const { return left < 0; }
+    };
+
+    static constexpr int LEAF_SIZE = 4;
+
+    const std::vector<MeshTriangle>& triangles;
+    std::vector<Aabb> triangleBounds;
+    std::vector<Vector3> centroids;
+    std::vector<int> order;
+    std::vector<Node> nodes;
+
+    int build(int first, int count);
+};
+
+#endif
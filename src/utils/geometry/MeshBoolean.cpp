@@ -0,0 +1,202 @@
+#include "MeshBoolean.hpp"
+#include "Bvh.hpp"
+#include <cmath>
+#include <utility>
+
+namespace {
+    constexpr float PLANE_EPSILON = 1e-6f;
+    constexpr float AREA_EPSILON = 1e-12f;
+
+    struct Plane {
+        Vector3 normal;
+        float offset;
+
+        float distance(const Vector3& point) const {
+            float d = normal.x * point.x + normal.y * point.y + normal.z * point.z + offset;
+            return std::abs(d) < PLANE_EPSILON ? 0.0f : d;
+        }
+    };
+
+    inline Vector3 sub(const Vector3& a, const Vector3& b) {
+        return Vector3(a.x - b.x, a.y - b.y, a.z - b.z);
+    }
+
+    inline Vector3 cross(const Vector3& a, const Vector3& b) {
+        return Vector3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+    }
+
+    inline float dot(const Vector3& a, const Vector3& b) {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    inline Vector3 lerp(const Vector3& a, const Vector3& b, float t) {
+        return Vector3(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t);
+    }
+
+    bool planeOf(const MeshTriangle& triangle, Plane& plane) {
+        Vector3 normal = cross(sub(triangle.v2, triangle.v1), sub(triangle.v3, triangle.v1));
+        float length = std::sqrt(dot(normal, normal));
+        if (length < AREA_EPSILON) return false;
+        plane.normal = Vector3(normal.x / length, normal.y / length, normal.z / length);
+        plane.offset = -dot(plane.normal, triangle.v1);
+        return true;
+    }
+
+    // Interval of the triangle's crossing with the other plane, projected on the
+    // intersection line (Moller's interval method).
+    bool crossingInterval(const float p[3], const float d[3], float& t0, float& t1) {
+        int lone;
+        if (d[0] * d[1] > 0.0f) lone = 2;
+        else if (d[0] * d[2] > 0.0f) lone = 1;
+        else if (d[1] * d[2] > 0.0f || d[0] != 0.0f) lone = 0;
+        else if (d[1] != 0.0f) lone = 1;
+        else if (d[2] != 0.0f) lone = 2;
+        else return false;
+
+        int a = (lone + 1) % 3;
+        int b = (lone + 2) % 3;
+        t0 = p[lone] + (p[a] - p[lone]) * d[lone] / (d[lone] - d[a]);
+        t1 = p[lone] + (p[b] - p[lone]) * d[lone] / (d[lone] - d[b]);
+        if (t0 > t1) std::swap(t0, t1);
+        return true;
+    }
+
+    bool sameSide(const float d[3]) {
+        return (d[0] > 0.0f && d[1] > 0.0f && d[2] > 0.0f) ||
+               (d[0] < 0.0f && d[1] < 0.0f && d[2] < 0.0f);
+    }
+
+    bool trianglesIntersect(const MeshTriangle& a, const MeshTriangle& b) {
+        Plane planeA, planeB;
+        if (!planeOf(a, planeA) || !planeOf(b, planeB)) return false;
+
+        float distancesA[3] = {planeB.distance(a.v1), planeB.distance(a.v2), planeB.distance(a.v3)};
+        if (sameSide(distancesA)) return false;
+        float distancesB[3] = {planeA.distance(b.v1), planeA.distance(b.v2), planeA.distance(b.v3)};
+        if (sameSide(distancesB)) return false;
+
+        Vector3 direction = cross(planeA.normal, planeB.normal);
+        float ax = std::abs(direction.x), ay = std::abs(direction.y), az = std::abs(direction.z);
+        auto project = [&](const Vector3& v) {
+            if (ax >= ay && ax >= az) return v.x;
+            return ay >= az ? v.y : v.z;
+        };
+
+        float projectedA[3] = {project(a.v1), project(a.v2), project(a.v3)};
+        float projectedB[3] = {project(b.v1), project(b.v2), project(b.v3)};
+
+        float a0, a1, b0, b1;
+        if (!crossingInterval(projectedA, distancesA, a0, a1)) return false;
+        if (!crossingInterval(projectedB, distancesB, b0, b1)) return false;
+        return a0 <= b1 && b0 <= a1;
+    }
+
+    void appendFan(const std::vector<Vector3>& polygon, const std::array<int, 4>& color,
+                   std::vector<MeshTriangle>& out) {
+        for (size_t i = 1; i + 1 < polygon.size(); ++i) {
+            MeshTriangle triangle{polygon[0], polygon[i], polygon[i + 1], color};
+            Vector3 normal = cross(sub(triangle.v2, triangle.v1), sub(triangle.v3, triangle.v1));
+            if (dot(normal, normal) > AREA_EPSILON * AREA_EPSILON) {
+                out.push_back(triangle);
+            }
+        }
+    }
+
+    // Splits `triangle` along `plane`. Returns false when the plane does not really cut it.
+    bool splitByPlane(const MeshTriangle& triangle, const Plane& plane, std::vector<MeshTriangle>& out) {
+        const Vector3 corners[3] = {triangle.v1, triangle.v2, triangle.v3};
+        float distances[3];
+        bool hasFront = false, hasBack = false;
+        for (int i = 0; i < 3; ++i) {
+            distances[i] = plane.distance(corners[i]);
+            hasFront |= distances[i] > 0.0f;
+            hasBack |= distances[i] < 0.0f;
+        }
+        if (!hasFront || !hasBack) return false;
+
+        std::vector<Vector3> front, back;
+        for (int i = 0; i < 3; ++i) {
+            int next = (i + 1) % 3;
+            float da = distances[i];
+            float db = distances[next];
+            if (da >= 0.0f) front.push_back(corners[i]);
+            if (da <= 0.0f) back.push_back(corners[i]);
+            if ((da > 0.0f && db < 0.0f) || (da < 0.0f && db > 0.0f)) {
+                Vector3 point = lerp(corners[i], corners[next], da / (da - db));
+                front.push_back(point);
+                back.push_back(point);
+            }
+        }
+        appendFan(front, triangle.color, out);
+        appendFan(back, triangle.color, out);
+        return true;
+    }
+
+    std::vector<MeshTriangle> splitByCutters(const MeshTriangle& triangle, const std::vector<int>& cutters,
+                                             const std::vector<MeshTriangle>& other) {
+        std::vector<MeshTriangle> fragments = {triangle};
+        std::vector<MeshTriangle> next;
+        for (int cutterIndex : cutters) {
+            const MeshTriangle& cutter = other[cutterIndex];
+            Plane plane;
+            if (!planeOf(cutter, plane)) continue;
+
+            next.clear();
+            for (const auto& fragment : fragments) {
+                if (!trianglesIntersect(fragment, cutter) || !splitByPlane(fragment, plane, next)) {
+                    next.push_back(fragment);
+                }
+            }
+            fragments.swap(next);
+        }
+        return fragments;
+    }
+
+    void collectFragments(const std::vector<MeshTriangle>& source, const std::vector<std::vector<int>>& cutters,
+                          const std::vector<MeshTriangle>& other, const TriangleBvh& otherBvh,
+                          bool keepInside, bool flip, std::vector<MeshTriangle>& out) {
+        for (size_t i = 0; i < source.size(); ++i) {
+            std::vector<MeshTriangle> fragments;
+            if (cutters[i].empty()) {
+                fragments.push_back(source[i]);
+            } else {
+                fragments = splitByCutters(source[i], cutters[i], other);
+            }
+
+            for (auto& fragment : fragments) {
+                Vector3 centroid((fragment.v1.x + fragment.v2.x + fragment.v3.x) / 3.0f,
+                                 (fragment.v1.y + fragment.v2.y + fragment.v3.y) / 3.0f,
+                                 (fragment.v1.z + fragment.v2.z + fragment.v3.z) / 3.0f);
+                if (otherBvh.containsPoint(centroid) != keepInside) continue;
+                if (flip) std::swap(fragment.v2, fragment.v3);
+                out.push_back(fragment);
+            }
+        }
+    }
+}
+
+std::vector<MeshTriangle> MeshBoolean::compute(const std::vector<MeshTriangle>& a,
+                                               const std::vector<MeshTriangle>& b,
+                                               BooleanOperation operation) {
+    TriangleBvh bvhA(a);
+    TriangleBvh bvhB(b);
+
+    std::vector<std::vector<int>> cuttersA(a.size());
+    std::vector<std::vector<int>> cuttersB(b.size());
+    for (const auto& [i, j] : bvhA.findOverlappingPairs(bvhB)) {
+        if (trianglesIntersect(a[i], b[j])) {
+            cuttersA[i].push_back(j);
+            cuttersB[j].push_back(i);
+        }
+    }
+
+    bool keepInsideA = operation == BooleanOperation::Intersection;
+    bool keepInsideB = operation != BooleanOperation::Union;
+    bool flipB = operation == BooleanOperation::Difference;
+
+    std::vector<MeshTriangle> result;
+    result.reserve(a.size() + b.size());
+    collectFragments(a, cuttersA, b, bvhB, keepInsideA, false, result);
+    collectFragments(b, cuttersB, a, bvhA, keepInsideB, flipB, result);
+    return result;
+}
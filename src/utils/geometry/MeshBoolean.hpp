@@ -0,0 +1,23 @@
+#ifndef MESH_BOOLEAN_HPP
+#define MESH_BOOLEAN_HPP
+
+#include "MeshTriangle.hpp"
+#include <vector>
+
+enum class BooleanOperation {
+    Union,
+    Difference,
+    Intersection
+};
+
+// CSG on closed triangle meshes. Triangles that cross the other mesh are split along the
+// crossing triangles' planes and every fragment is kept or dropped by a ray-parity
+// inside test. Coplanar overlaps are not resolved.
+class MeshBoolean {
+public:
+    static std::vector<MeshTriangle> compute(const std::vector<MeshTriangle>& a,
+                                             const std::vector<MeshTriangle>& b,
+                                             BooleanOperation operation);
+};
+
+#endif
@@ -0,0 +1,314 @@
+#include "MeshDecimator.hpp"
+#include "MeshEdges.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <queue>
+
+namespace {
+    constexpr double BOUNDARY_WEIGHT = 100.0;
+    constexpr double FLIP_THRESHOLD = 0.2;
+
+    struct Vec {
+        double x, y, z;
+    };
+
+    inline Vec toVec(const Vector3& v) { return {v.x, v.y, v.z}; }
+    inline Vec sub(const Vec& a, const Vec& b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+    inline Vec cross(const Vec& a, const Vec& b) {
+        return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+    }
+    inline double dot(const Vec& a, const Vec& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    inline double length(const Vec& v) { return std::sqrt(dot(v, v)); }
+
+    // Symmetric 4x4 error quadric, upper triangle only
+    struct Quadric {
+        double q[10] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+        static Quadric fromPlane(double a, double b, double c, double d, double weight) {
+            Quadric quadric;
+            quadric.q[0] = a * a * weight; quadric.q[1] = a * b * weight; quadric.q[2] = a * c * weight; quadric.q[3] = a * d * weight;
+            quadric.q[4] = b * b * weight; quadric.q[5] = b * c * weight; quadric.q[6] = b * d * weight;
+            quadric.q[7] = c * c * weight; quadric.q[8] = c * d * weight;
+            quadric.q[9] = d * d * weight;
+            return quadric;
+        }
+
+        void add(const Quadric& other) {
+            for (int i = 0; i < 10; ++i) q[i] += other.q[i];
+        }
+
+        double evaluate(const Vec& v) const {
+            return q[0] * v.x * v.x + 2 * q[1] * v.x * v.y + 2 * q[2] * v.x * v.z + 2 * q[3] * v.x
+                 + q[4] * v.y * v.y + 2 * q[5] * v.y * v.z + 2 * q[6] * v.y
+                 + q[7] * v.z * v.z + 2 * q[8] * v.z
+                 + q[9];
+        }
+
+        // Position minimizing the error, if the 3x3 system is well conditioned
+        bool optimum(Vec& result) const {
+            double a = q[0], b = q[1], c = q[2], e = q[4], f = q[5], h = q[7];
+            double det = a * (e * h - f * f) - b * (b * h - f * c) + c * (b * f - e * c);
+            if (std::abs(det) < 1e-12) return false;
+
+            double rx = -q[3], ry = -q[6], rz = -q[8];
+            result.x = (rx * (e * h - f * f) - b * (ry * h - f * rz) + c * (ry * f - e * rz)) / det;
+            result.y = (a * (ry * h - f * rz) - rx * (b * h - f * c) + c * (b * rz - ry * c)) / det;
+            result.z = (a * (e * rz - ry * f) - b * (b * rz - ry * c) + rx * (b * f - e * c)) / det;
+            return true;
+        }
+    };
+
+    struct Collapse {
+        double cost;
+        int keep;
+        int remove;
+        uint32_t keepStamp;
+        uint32_t removeStamp;
+        Vec position;
+
+        bool operator>(const Collapse& other) const { return cost > other.cost; }
+    };
+
+    class Simplifier {
+    public:
+        Simplifier(const std::vector<Vector3>& vertices, const std::vector<std::array<int, 7>>& faces)
+            : faces(faces) {
+            positions.reserve(vertices.size());
+            for (const auto& vertex : vertices) positions.push_back(toVec(vertex));
+            quadrics.resize(vertices.size());
+            vertexFaces.resize(vertices.size());
+            stamps.assign(vertices.size(), 0);
+            vertexAlive.assign(vertices.size(), true);
+            faceAlive.assign(faces.size(), true);
+            liveFaces = faces.size();
+
+            for (size_t f = 0; f < faces.size(); ++f) {
+                for (int k = 0; k < 3; ++k) vertexFaces[faces[f][k]].push_back(static_cast<int>(f));
+                addFaceQuadric(static_cast<int>(f));
+            }
+            addBoundaryQuadrics();
+
+            std::vector<std::pair<int, int>> edges;
+            edges.reserve(faces.size() * 3);
+            for (const auto& face : faces) {
+                for (int k = 0; k < 3; ++k) {
+                    int a = face[k], b = face[(k + 1) % 3];
+                    edges.emplace_back(std::min(a, b), std::max(a, b));
+                }
+            }
+            std::sort(edges.begin(), edges.end());
+            edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+            for (const auto& [a, b] : edges) {
+                if (a != b) pushCollapse(a, b);
+            }
+        }
+
+        void run(size_t targetFaceCount) {
+            while (liveFaces > targetFaceCount && !heap.empty()) {
+                Collapse collapse = heap.top();
+                heap.pop();
+                if (!vertexAlive[collapse.keep] || !vertexAlive[collapse.remove]) continue;
+                if (stamps[collapse.keep] != collapse.keepStamp || stamps[collapse.remove] != collapse.removeStamp) continue;
+                if (flipsFaces(collapse.keep, collapse.remove, collapse.position) ||
+                    flipsFaces(collapse.remove, collapse.keep, collapse.position)) continue;
+
+                apply(collapse);
+            }
+        }
+
+        LodLevel result() const {
+            LodLevel level;
+            std::vector<int> remap(positions.size(), -1);
+            for (size_t f = 0; f < faces.size(); ++f) {
+                if (!faceAlive[f]) continue;
+                std::array<int, 7> face = faces[f];
+                for (int k = 0; k < 3; ++k) {
+                    int& index = remap[face[k]];
+                    if (index < 0) {
+                        index = static_cast<int>(level.vertices.size());
+                        const Vec& p = positions[face[k]];
+                        level.vertices.emplace_back(static_cast<float>(p.x), static_cast<float>(p.y), static_cast<float>(p.z));
+                    }
+                    face[k] = index;
+                }
+                level.faces.push_back(face);
+            }
+            level.edges = computeVisibleEdges(level.vertices, level.faces);
+            return level;
+        }
+
+    private:
+        std::vector<std::array<int, 7>> faces;
+        std::vector<Vec> positions;
+        std::vector<Quadric> quadrics;
+        std::vector<std::vector<int>> vertexFaces;
+        std::vector<uint32_t> stamps;
+        std::vector<bool> vertexAlive;
+        std::vector<bool> faceAlive;
+        size_t liveFaces;
+        std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> heap;
+
+        Vec faceNormal(int f, int movedVertex, const Vec& movedPosition) const {
+            Vec corners[3];
+            for (int k = 0; k < 3; ++k) {
+                int v = faces[f][k];
+                corners[k] = v == movedVertex ? movedPosition : positions[v];
+            }
+            return cross(sub(corners[1], corners[0]), sub(corners[2], corners[0]));
+        }
+
+        void addFaceQuadric(int f) {
+            Vec normal = faceNormal(f, -1, Vec{});
+            double area = length(normal);
+            if (area < 1e-12) return;
+            Vec n = {normal.x / area, normal.y / area, normal.z / area};
+            double d = -dot(n, positions[faces[f][0]]);
+            Quadric quadric = Quadric::fromPlane(n.x, n.y, n.z, d, area * 0.5);
+            for (int k = 0; k < 3; ++k) quadrics[faces[f][k]].add(quadric);
+        }
+
+        // Open edges get a perpendicular plane so the silhouette of open meshes does not shrink
+        void addBoundaryQuadrics() {
+            std::vector<std::pair<std::pair<int, int>, int>> directedEdges;
+            directedEdges.reserve(faces.size() * 3);
+            for (size_t f = 0; f < faces.size(); ++f) {
+                for (int k = 0; k < 3; ++k) {
+                    int a = faces[f][k], b = faces[f][(k + 1) % 3];
+                    directedEdges.push_back({{std::min(a, b), std::max(a, b)}, static_cast<int>(f)});
+                }
+            }
+            std::sort(directedEdges.begin(), directedEdges.end());
+
+            for (size_t i = 0; i < directedEdges.size(); ++i) {
+                bool shared = (i > 0 && directedEdges[i - 1].first == directedEdges[i].first) ||
+                              (i + 1 < directedEdges.size() && directedEdges[i + 1].first == directedEdges[i].first);
+                if (shared) continue;
+
+                auto [a, b] = directedEdges[i].first;
+                Vec edge = sub(positions[b], positions[a]);
+                Vec normal = cross(edge, faceNormal(directedEdges[i].second, -1, Vec{}));
+                double len = length(normal);
+                if (len < 1e-12) continue;
+                Vec n = {normal.x / len, normal.y / len, normal.z / len};
+                double d = -dot(n, positions[a]);
+                Quadric quadric = Quadric::fromPlane(n.x, n.y, n.z, d, BOUNDARY_WEIGHT * dot(edge, edge));
+                quadrics[a].add(quadric);
+                quadrics[b].add(quadric);
+            }
+        }
+
+        void pushCollapse(int a, int b) {
+            Quadric combined = quadrics[a];
+            combined.add(quadrics[b]);
+
+            Vec candidates[4];
+            int candidateCount = 0;
+            Vec optimum;
+            if (combined.optimum(optimum)) candidates[candidateCount++] = optimum;
+            candidates[candidateCount++] = positions[a];
+            candidates[candidateCount++] = positions[b];
+            candidates[candidateCount++] = {(positions[a].x + positions[b].x) * 0.5,
+                                            (positions[a].y + positions[b].y) * 0.5,
+                                            (positions[a].z + positions[b].z) * 0.5};
+
+            Collapse best{combined.evaluate(candidates[0]), a, b, stamps[a], stamps[b], candidates[0]};
+            for (int i = 1; i < candidateCount; ++i) {
+                double cost = combined.evaluate(candidates[i]);
+                if (cost < best.cost) {
+                    best.cost = cost;
+                    best.position = candidates[i];
+                }
+            }
+            heap.push(best);
+        }
+
+        bool flipsFaces(int moved, int other, const Vec& position) const {
+            for (int f : vertexFaces[moved]) {
+                if (!faceAlive[f]) continue;
+                const auto& face = faces[f];
+                if (face[0] == other || face[1] == other || face[2] == other) continue;
+
+                Vec before = faceNormal(f, -1, Vec{});
+                Vec after = faceNormal(f, moved, position);
+                double lengths = length(before) * length(after);
+                if (lengths < 1e-20) continue;
+                if (dot(before, after) < FLIP_THRESHOLD * lengths) return true;
+            }
+            return false;
+        }
+
+        void apply(const Collapse& collapse) {
+            int keep = collapse.keep;
+            int remove = collapse.remove;
+
+            positions[keep] = collapse.position;
+            quadrics[keep].add(quadrics[remove]);
+            vertexAlive[remove] = false;
+
+            for (int f : vertexFaces[remove]) {
+                if (!faceAlive[f]) continue;
+                auto& face = faces[f];
+                if (face[0] == keep || face[1] == keep || face[2] == keep) {
+                    faceAlive[f] = false;
+                    liveFaces--;
+                    continue;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    if (face[k] == remove) face[k] = keep;
+                }
+                vertexFaces[keep].push_back(f);
+            }
+            vertexFaces[remove].clear();
+
+            auto& keepFaces = vertexFaces[keep];
+            keepFaces.erase(std::remove_if(keepFaces.begin(), keepFaces.end(),
+                [this](int f) { return !faceAlive[f]; }), keepFaces.end());
+
+            stamps[keep]++;
+
+            std::vector<int> neighbours;
+            for (int f : keepFaces) {
+                for (int k = 0; k < 3; ++k) {
+                    if (faces[f][k] != keep) neighbours.push_back(faces[f][k]);
+                }
+            }
+            std::sort(neighbours.begin(), neighbours.end());
+            neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+            for (int neighbour : neighbours) {
+                pushCollapse(keep, neighbour);
+            }
+        }
+    };
+}
+
+LodLevel MeshDecimator::decimate(const std::vector<Vector3>& vertices,
+                                 const std::vector<std::array<int, 7>>& faces,
+                                 size_t targetFaceCount) {
+    Simplifier simplifier(vertices, faces);
+    simplifier.run(targetFaceCount);
+    return simplifier.result();
+}
+
+std::vector<LodLevel> MeshDecimator::buildLodChain(const std::vector<Vector3>& vertices,
+                                                   const std::vector<std::array<int, 7>>& faces,
+                                                   int maxLevels, size_t minFaceCount) {
+    std::vector<LodLevel> levels;
+    levels.reserve(maxLevels);
+    const std::vector<Vector3>* sourceVertices = &vertices;
+    const std::vector<std::array<int, 7>>* sourceFaces = &faces;
+
+    for (int level = 0; level < maxLevels; ++level) {
+        size_t target = sourceFaces->size() / 2;
+        if (target < minFaceCount) break;
+
+        LodLevel next = decimate(*sourceVertices, *sourceFaces, target);
+        // Stop once the simplifier can no longer make real progress
+        if (next.faces.size() > sourceFaces->size() * 3 / 4) break;
+
+        levels.push_back(std::move(next));
+        sourceVertices = &levels.back().vertices;
+        sourceFaces = &levels.back().faces;
+    }
+    return levels;
+}
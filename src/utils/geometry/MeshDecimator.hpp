@@ -0,0 +1,28 @@
+#ifndef MESH_DECIMATOR_HPP
+#define MESH_DECIMATOR_HPP
+
+#include "../math/Vector3.hpp"
+#include <array>
+#include <utility>
+#include <vector>
+
+struct LodLevel {
+    std::vector<Vector3> vertices;
+    std::vector<std::array<int, 7>> faces;
+    std::vector<std::pair<int, int>> edges;
+};
+
+// Quadric error metric edge-collapse simplification (Garland & Heckbert).
+class MeshDecimator {
+public:
+    static LodLevel decimate(const std::vector<Vector3>& vertices,
+                             const std::vector<std::array<int, 7>>& faces,
+                             size_t targetFaceCount);
+
+    // Successively halved levels; level 0 (the original mesh) is not included.
+    static std::vector<LodLevel> buildLodChain(const std::vector<Vector3>& vertices,
+                                               const std::vector<std::array<int, 7>>& faces,
+                                               int maxLevels, size_t minFaceCount);
+};
+
+#endif
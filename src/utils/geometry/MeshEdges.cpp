@@ -0,0 +1,77 @@
+#include "MeshEdges.hpp"
+#include <unordered_map>
+#include <cstdint>
+#include <cmath>
+
+static Vector3 calculateNormal(const std::vector<Vector3>& vertices, const std::array<int, 7>& face) {
+    if (face.size() < 3) {
+        return Vector3(0, 0, 0);
+    }
+
+    Vector3 v0 = vertices[face[0]];
+    Vector3 v1 = vertices[face[1]];
+    Vector3 v2 = vertices[face[2]];
+
+    Vector3 edge1 = v1 - v0;
+    Vector3 edge2 = v2 - v0;
+
+    Vector3 normal = edge1.cross(edge2);
+
+    // Same threshold as Vector3::normalized, so degenerate faces do not spam warnings
+    if (normal.length() < 1e-6f) {
+        return Vector3(0, 0, 0);
+    }
+
+    return normal.normalized();
+}
+
+static bool areNormalsParallel(const Vector3& n1, const Vector3& n2) {
+    return std::abs(n1.dot(n2)) > 0.999f; // Threshold for floating-point precision
+}
+
+std::vector<std::pair<int, int>> computeVisibleEdges(const std::vector<Vector3>& vertices,
+                                                     const std::vector<std::array<int, 7>>& faces) {
+    std::vector<std::pair<int, int>> edges;
+
+    // An edge shared by exactly two coplanar faces is a diagonal inside a flat polygon and stays hidden
+    struct EdgeUse {
+        int count = 0;
+        size_t firstFace = 0;
+        bool hidden = false;
+    };
+    std::unordered_map<uint64_t, EdgeUse> edgeUses;
+    edgeUses.reserve(faces.size() * 2);
+    std::vector<std::pair<int, int>> orderedEdges;
+    orderedEdges.reserve(faces.size() * 3 / 2);
+
+    std::vector<Vector3> normals(faces.size());
+    for (size_t i = 0; i < faces.size(); ++i) {
+        normals[i] = calculateNormal(vertices, faces[i]);
+        if (normals[i].length() == 0) {
+            continue;
+        }
+
+        for (size_t k = 0; k < 3; ++k) {
+            int v1 = faces[i][k];
+            int v2 = faces[i][(k + 1) % 3];
+            if (v1 > v2) std::swap(v1, v2);
+            uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(v1)) << 32) | static_cast<uint32_t>(v2);
+
+            EdgeUse& use = edgeUses[key];
+            if (use.count == 0) {
+                use.firstFace = i;
+                orderedEdges.emplace_back(v1, v2);
+            }
+            use.count++;
+            use.hidden = use.count == 2 && areNormalsParallel(normals[use.firstFace], normals[i]);
+        }
+    }
+
+    for (const auto& edge : orderedEdges) {
+        uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(edge.first)) << 32) | static_cast<uint32_t>(edge.second);
+        if (!edgeUses[key].hidden) {
+            edges.push_back(edge);
+        }
+    }
+    return edges;
+}
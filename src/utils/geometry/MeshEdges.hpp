@@ -0,0 +1,13 @@
+#ifndef MESH_EDGES_HPP
+#define MESH_EDGES_HPP
+
+#include "../math/Vector3.hpp"
+#include <array>
+#include <utility>
+#include <vector>
+
+// Edges drawn in the wireframe: every face edge except diagonals shared by two coplanar faces.
+std::vector<std::pair<int, int>> computeVisibleEdges(const std::vector<Vector3>& vertices,
+                                                     const std::vector<std::array<int, 7>>& faces);
+
+#endif
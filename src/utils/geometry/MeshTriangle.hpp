@@ -0,0 +1,13 @@
+#ifndef MESH_TRIANGLE_HPP
+#define MESH_TRIANGLE_HPP
+
+#include "../math/Vector3.hpp"
+#include <array>
+
+// World-space triangle with its RGBA face colour, as used by the mesh operations.
+struct MeshTriangle {
+    Vector3 v1, v2, v3;
+    std::array<int, 4> color;
+};
+
+#endif
@@ -0,0 +1,120 @@
+#include "VertexWelder.hpp"
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+namespace {
+    constexpr int EMPTY = -1;
+
+    size_t hashCell(int64_t x, int64_t y, int64_t z) {
+        uint64_t h = static_cast<uint64_t>(x) * 0x9E3779B97F4A7C15ull;
+        h ^= static_cast<uint64_t>(y) * 0xC2B2AE3D27D4EB4Full + (h << 6) + (h >> 2);
+        h ^= static_cast<uint64_t>(z) * 0x165667B19E3779F9ull + (h << 6) + (h >> 2);
+        h ^= h >> 31;
+        return static_cast<size_t>(h);
+    }
+
+    size_t tableSizeFor(size_t vertexCount) {
+        size_t size = 64;
+        while (size < vertexCount * 2) size <<= 1;
+        return size;
+    }
+}
+
+VertexWelder::VertexWelder(float tolerance, size_t expectedVertices)
+    : tolerance(std::max(tolerance, MIN_TOLERANCE)) {
+    toleranceSquared = this->tolerance * this->tolerance;
+    inverseCellSize = 1.0f / (2.0f * this->tolerance);
+    vertices.reserve(expectedVertices);
+    nextInCell.reserve(expectedVertices);
+    table.assign(tableSizeFor(expectedVertices), Cell{0, 0, 0, EMPTY});
+}
+
+int64_t VertexWelder::cellCoordinate(float value, int64_t& nearerNeighbour) const {
+    const double limit = static_cast<double>(std::numeric_limits<int64_t>::max() / 4);
+    double scaled = std::clamp(static_cast<double>(value) * inverseCellSize, -limit, limit);
+    double cell = std::floor(scaled);
+    nearerNeighbour = scaled - cell < 0.5 ? -1 : 1;
+    return static_cast<int64_t>(cell);
+}
+
+size_t VertexWelder::findSlot(int64_t x, int64_t y, int64_t z) const {
+    size_t mask = table.size() - 1;
+    size_t slot = hashCell(x, y, z) & mask;
+    while (table[slot].head != EMPTY &&
+           (table[slot].x != x || table[slot].y != y || table[slot].z != z)) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+void VertexWelder::growTable() {
+    std::vector<Cell> oldTable;
+    oldTable.swap(table);
+    table.assign(oldTable.size() * 2, Cell{0, 0, 0, EMPTY});
+    for (const auto& cell : oldTable) {
+        if (cell.head != EMPTY) {
+            table[findSlot(cell.x, cell.y, cell.z)] = cell;
+        }
+    }
+}
+
+int VertexWelder::addVertex(const Vector3& position) {
+    int64_t nx, ny, nz;
+    int64_t cx = cellCoordinate(position.x, nx);
+    int64_t cy = cellCoordinate(position.y, ny);
+    int64_t cz = cellCoordinate(position.z, nz);
+
+    for (int n = 0; n < 8; ++n) {
+        const Cell& cell = table[findSlot(cx + ((n & 1) ? nx : 0),
+                                          cy + ((n & 2) ? ny : 0),
+                                          cz + ((n & 4) ? nz : 0))];
+        for (int i = cell.head; i != EMPTY; i = nextInCell[i]) {
+            float dx = vertices[i].x - position.x;
+            float dy = vertices[i].y - position.y;
+            float dz = vertices[i].z - position.z;
+            if (dx * dx + dy * dy + dz * dz <= toleranceSquared) {
+                return i;
+            }
+        }
+    }
+
+    if ((usedCells + 1) * 2 > table.size()) {
+        growTable();
+    }
+
+    int index = static_cast<int>(vertices.size());
+    vertices.push_back(position);
+
+    Cell& cell = table[findSlot(cx, cy, cz)];
+    if (cell.head == EMPTY) {
+        cell = Cell{cx, cy, cz, EMPTY};
+        usedCells++;
+    }
+    nextInCell.push_back(cell.head);
+    cell.head = index;
+    return index;
+}
+
+const std::vector<Vector3>& VertexWelder::getVertices() const {
+    return vertices;
+}
+
+std::vector<Vector3> VertexWelder::releaseVertices() {
+    nextInCell.clear();
+    table.assign(tableSizeFor(0), Cell{0, 0, 0, EMPTY});
+    usedCells = 0;
+    std::vector<Vector3> result;
+    result.swap(vertices);
+    return result;
+}
+
+std::vector<int> VertexWelder::weld(std::vector<Vector3>& vertices, float tolerance) {
+    VertexWelder welder(tolerance, vertices.size());
+    std::vector<int> remap(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        remap[i] = welder.addVertex(vertices[i]);
+    }
+    vertices = welder.releaseVertices();
+    return remap;
+}
@@ -0,0 +1,46 @@
+#ifndef VERTEX_WELDER_HPP
+#define VERTEX_WELDER_HPP
+
+#include "../math/Vector3.hpp"
+#include <vector>
+#include <cstdint>
+
+// Merges positions that lie within `tolerance` of an already inserted position.
+// Positions are bucketed in a uniform grid with cells twice the tolerance wide, so a lookup
+// only has to look at the query cell and its nearer neighbour on each axis (8 cells).
+class VertexWelder {
+public:
+    static constexpr float MIN_TOLERANCE = 1e-6f;
+
+    explicit VertexWelder(float tolerance = MIN_TOLERANCE, size_t expectedVertices = 0);
+
+    // Returns the index of the welded vertex that `position` was merged into.
+    int addVertex(const Vector3& position);
+
+    const std::vector<Vector3>& getVertices() const;
+    std::vector<Vector3> releaseVertices();
+
+    // Welds `vertices` in place and returns the old index -> new index remap.
+    static std::vector<int> weld(std::vector<Vector3>& vertices, float tolerance);
+
+private:
+    struct Cell {
+        int64_t x, y, z;
+        int head;
+    };
+
+    float tolerance;
+    float toleranceSquared;
+    float inverseCellSize;
+
+    std::vector<Vector3> vertices;
+    std::vector<int> nextInCell;
+    std::vector<Cell> table;
+    size_t usedCells = 0;
+
+    int64_t cellCoordinate(float value, int64_t& nearerNeighbour) const;
+    size_t findSlot(int64_t x, int64_t y, int64_t z) const;
+    void growTable();
+};
+
+#endif
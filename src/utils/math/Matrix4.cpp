@@ -110,6 +110,39 @@ Matrix4 Matrix4::lookAt(const Vector3& eye, const Vector3& center, const Vector3
     return viewMatrix;
 }
 
+static void rotationFromQuaternion(const Quaternion& q, float r[3][3]) {
+    float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+    r[0][0] = 1.0f - 2.0f * (yy + zz);
+    r[0][1] = 2.0f * (xy - wz);
+    r[0][2] = 2.0f * (xz + wy);
+    r[1][0] = 2.0f * (xy + wz);
+    r[1][1] = 1.0f - 2.0f * (xx + zz);
+    r[1][2] = 2.0f * (yz - wx);
+    r[2][0] = 2.0f * (xz - wy);
+    r[2][1] = 2.0f * (yz + wx);
+    r[2][2] = 1.0f - 2.0f * (xx + yy);
+}
+
+Matrix4 Matrix4::composeTRS(const Vector3& t, const Quaternion& r, const Vector3& s) {
+    float rot[3][3];
+    rotationFromQuaternion(r, rot);
+    const float sc[3] = {s.x, s.y, s.z};
+    const float tr[3] = {t.x, t.y, t.z};
+
+    Matrix4 mat;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            mat.data[i][j] = rot[i][j] * sc[j];
+        }
+        mat.data[i][3] = tr[i];
+    }
+    mat.data[3][3] = 1.0f;
+    return mat;
+}
+
 Matrix4 Matrix4::operator*(const Matrix4& other) const {
     Matrix4 result;
 
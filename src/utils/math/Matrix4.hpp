@@ -2,6 +2,7 @@
 #define MATRIX4_HPP
 
 #include "Vector3.hpp"
+#include "Quaternion.hpp"
 #include <array>
 
 class Matrix4 {
@@ -22,6 +23,8 @@ public:
     static Matrix4 perspective(float fov, float aspect, float near, float far);
     static Matrix4 orthographic(float left, float right, float bottom, float top, float near, float far);
     static Matrix4 lookAt(const Vector3& eye, const Vector3& center, const Vector3& up);
+    // T * R * S, built directly without general multiplies
+    static Matrix4 composeTRS(const Vector3& t, const Quaternion& r, const Vector3& s);
     // Operators
     Matrix4 operator*(const Matrix4& other) const;
     Vector3 operator*(const Vector3& vec) const;
@@ -0,0 +1,77 @@
+#include "Quaternion.hpp"
+#include <cmath>
+
+Quaternion::Quaternion(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+
+Quaternion Quaternion::identity() {
+    return Quaternion(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+Quaternion Quaternion::fromAxisAngle(char axis, float angle) {
+    float s = std::sin(angle * 0.5f);
+    float c = std::cos(angle * 0.5f);
+    switch (axis) {
+        case 'x': return Quaternion(s, 0.0f, 0.0f, c);
+        case 'y': return Quaternion(0.0f, s, 0.0f, c);
+        case 'z': return Quaternion(0.0f, 0.0f, s, c);
+        default: return identity();
+    }
+}
+
+Quaternion Quaternion::fromEuler(const Vector3& euler) {
+    float cx = std::cos(euler.x * 0.5f), sx = std::sin(euler.x * 0.5f);
+    float cy = std::cos(euler.y * 0.5f), sy = std::sin(euler.y * 0.5f);
+    float cz = std::cos(euler.z * 0.5f), sz = std::sin(euler.z * 0.5f);
+
+    // qz * qy * qx expanded
+    return Quaternion(
+        sx * cy * cz - cx * sy * sz,
+        cx * sy * cz + sx * cy * sz,
+        cx * cy * sz - sx * sy * cz,
+        cx * cy * cz + sx * sy * sz
+    );
+}
+
+Vector3 Quaternion::toEuler() const {
+    // Entries of the rotation matrix Rz * Ry * Rx
+    float r00 = 1.0f - 2.0f * (y * y + z * z);
+    float r01 = 2.0f * (x * y - w * z);
+    float r10 = 2.0f * (x * y + w * z);
+    float r11 = 1.0f - 2.0f * (x * x + z * z);
+    float r20 = 2.0f * (x * z - w * y);
+    float r21 = 2.0f * (y * z + w * x);
+    float r22 = 1.0f - 2.0f * (x * x + y * y);
+
+    float cosY = std::sqrt(r00 * r00 + r10 * r10);
+    float angleY = std::atan2(-r20, cosY);
+    if (cosY < 1e-5f) {
+        // Gimbal lock: x and z turn about the same axis, so all of it goes to z
+        return Vector3(0.0f, angleY, std::atan2(-r01, r11));
+    }
+    return Vector3(std::atan2(r21, r22), angleY, std::atan2(r10, r00));
+}
+
+Quaternion Quaternion::operator*(const Quaternion& other) const {
+    return Quaternion(
+        w * other.x + x * other.w + y * other.z - z * other.y,
+        w * other.y - x * other.z + y * other.w + z * other.x,
+        w * other.z + x * other.y - y * other.x + z * other.w,
+        w * other.w - x * other.x - y * other.y - z * other.z
+    );
+}
+
+Quaternion Quaternion::normalized() const {
+    float len = std::sqrt(x * x + y * y + z * z + w * w);
+    if (len < 1e-8f) return identity();
+    return Quaternion(x / len, y / len, z / len, w / len);
+}
+
+Quaternion Quaternion::conjugate() const {
+    return Quaternion(-x, -y, -z, w);
+}
+
+Vector3 Quaternion::rotate(const Vector3& v) const {
+    Vector3 u(x, y, z);
+    Vector3 t = u.cross(v) * 2.0f;
+    return v + t * w + u.cross(t);
+}
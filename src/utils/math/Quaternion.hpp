@@ -0,0 +1,27 @@
+#ifndef QUATERNION_HPP
+#define QUATERNION_HPP
+
+#include "Vector3.hpp"
+
+// Unit quaternion stored as (x, y, z, w). Vector4 keeps its own layout for the camera code.
+class Quaternion {
+public:
+    float x, y, z, w;
+
+    Quaternion(float x = 0.0f, float y = 0.0f, float z = 0.0f, float w = 1.0f);
+
+    static Quaternion identity();
+    static Quaternion fromAxisAngle(char axis, float angle);
+    // Same order as Matrix4::rotationZ * rotationY * rotationX
+    static Quaternion fromEuler(const Vector3& euler);
+
+    // Inverse of fromEuler, with angles wrapped to [-pi, pi] and y to [-pi/2, pi/2]
+    Vector3 toEuler() const;
+
+    Quaternion operator*(const Quaternion& other) const;
+    Quaternion normalized() const;
+    Quaternion conjugate() const;
+    Vector3 rotate(const Vector3& v) const;
+};
+
+#endif // QUATERNION_HPP
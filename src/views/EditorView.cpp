@@ -19,6 +19,8 @@ void EditorView::onActivate() {
 
 void EditorView::onDeactivate() {
     editorMenu->onDeactivate();
+    // Leaving the editor abandons a project that has not finished loading
+    ProjectsManager::getInstance().cancelLoad();
 }
 
 void EditorView::handleEvent(const sf::Event &event, sf::RenderWindow &window) {
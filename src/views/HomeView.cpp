@@ -1,19 +1,21 @@
 #include "HomeView.hpp"
 #include "ViewsManager.hpp"
 #include "../utils/LanguageManager.hpp"
+#include "../utils/TextureManager.hpp"
 #include "../utils/WindowManager.hpp"
 
 HomeView::HomeView() {
-    if (!bgTexture.loadFromFile("../src/assets/images/bg.jpg")) {
-        std::cerr << "Error loading image.png" << std::endl;
+    try {
+        bgSprite.setTexture(TextureManager::getInstance().getTexture("../src/assets/images/bg.jpg"));
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return;
     }
 
-    bgSprite.setTexture(bgTexture);
-
     bgSprite.setPosition(0.f, 0.f);
     sf::Vector2u windowSize = WindowManager::getInstance().getWindow().getSize();
 
-    sf::Vector2u textureSize = bgTexture.getSize();
+    sf::Vector2u textureSize = bgSprite.getTexture()->getSize();
 
     float scaleX = static_cast<float>(windowSize.x) / textureSize.x;
     float scaleY = static_cast<float>(windowSize.y) / textureSize.y;
@@ -27,11 +29,11 @@ void HomeView::onActivate() {
 
 void HomeView::createUI() {
     components.clear();
-    auto languagePack = LanguageManager::getInstance().getSelectedPack();
+    const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
     auto projectsButton = std::make_shared<Button>(
         sf::Vector2f(100, 700),
         sf::Vector2f(200, 50),
-        languagePack["projects"]
+        languagePack[TextKey::Projects]
     );
 
     projectsButton->setOnClick([this]() {
@@ -43,7 +45,7 @@ void HomeView::createUI() {
     auto settingsButton = std::make_shared<Button>(
         sf::Vector2f(100, 770),
         sf::Vector2f(200, 50),
-        languagePack["settings"]
+        languagePack[TextKey::Settings]
     );
 
 
@@ -56,7 +58,7 @@ void HomeView::createUI() {
     auto exitButton = std::make_shared<Button>(
         sf::Vector2f(100, 840),
         sf::Vector2f(200, 50),
-        languagePack["exit"]
+        languagePack[TextKey::Exit]
     );
 
     exitButton->setOnClick([this]() {
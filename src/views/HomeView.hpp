@@ -12,7 +12,6 @@ public:
 
 private:
     void createUI();
-    sf::Texture bgTexture;
     sf::Sprite bgSprite;
 };
 
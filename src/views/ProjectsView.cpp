@@ -2,23 +2,30 @@
 #include "ViewsManager.hpp"
 #include "../utils/LanguageManager.hpp"
 #include "../core/feature/ProjectsManager.hpp"
+#include "../core/feature/ProjectIndex.hpp"
+#include "../core/feature/ThumbnailCache.hpp"
 #include "../core/ui/ScrollView.hpp"
 #include "../core/ui/Container.hpp"
 #include "../core/ui/Surface.hpp"
 #include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
 #include <memory>
+#include <string>
 #include <vector>
 #include "../core/ui/Component.hpp"
 #include "../core/ui/Text.hpp"
 #include "../core/ui/Button.hpp"
 #include "../core/ui/Snackbar.hpp"
+#include "../core/ui/Thumbnail.hpp"
 
 ProjectsView::ProjectsView() {}
 
 void ProjectsView::createUI() {
     this->components.clear();
 
-    auto languagePack = LanguageManager::getInstance().getSelectedPack();
+    const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
 
     auto headerSurface = std::make_shared<Surface>(
         sf::Vector2f(0, 0),
@@ -29,7 +36,7 @@ void ProjectsView::createUI() {
     auto backButton = std::make_shared<Button>(
         sf::Vector2f(20, 20),
         sf::Vector2f(100, 40),
-        languagePack["back"]
+        languagePack[TextKey::Back]
     );
 
     backButton->setIcon("back");
@@ -41,14 +48,14 @@ void ProjectsView::createUI() {
     auto title = std::make_shared<Text>(
         sf::Vector2f(backButton->getWidth() + 40, 20),
         30.f,
-        languagePack["projects"],
+        languagePack[TextKey::Projects],
         sf::Color::White
     );
 
     auto addProjectButton = std::make_shared<Button>(
         sf::Vector2f(1720, 20),
         sf::Vector2f(180, 40),
-        languagePack["new_project"]
+        languagePack[TextKey::NewProject]
     );
 
     addProjectButton->setIcon("add");
@@ -58,70 +65,129 @@ void ProjectsView::createUI() {
         try {
             projectsManager.createProject();
             ViewsManager::getInstance().switchTo("editor");
-            auto languagePack = LanguageManager::getInstance().getSelectedPack();
-            Snackbar::getInstance().addMessage(languagePack["project_created"]);
+            const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+            Snackbar::getInstance().addMessage(languagePack[TextKey::ProjectCreated]);
 
         }
         catch (...) {
-            auto languagePack = LanguageManager::getInstance().getSelectedPack();
-            Snackbar::getInstance().addMessage(languagePack["no_file_selected"]);
+            const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+            Snackbar::getInstance().addMessage(languagePack[TextKey::NoFileSelected]);
         }
     });
 
-    auto scrollView = std::make_shared<ScrollView>(
+    float scrollOffset = scrollView ? scrollView->getScrollOffset() : 0.f;
+    scrollView = std::make_shared<ScrollView>(
         sf::Vector2f(20, 100),
         sf::Vector2f(1880, 930),
         930.f
     );
 
-    int i = 0;
-    ProjectsManager& projectsManager = ProjectsManager::getInstance();
-    for (auto project: projectsManager.getProjects()) {
+    ProjectIndex& index = ProjectIndex::getInstance();
+    shownRevision = index.getRevision();
+    const auto& projects = ProjectsManager::getInstance().getProjects();
+    size_t pageCount = std::max<size_t>(1, (projects.size() + PAGE_SIZE - 1) / PAGE_SIZE);
+    page = std::min(page, pageCount - 1);
+    size_t first = page * PAGE_SIZE;
+    size_t last = std::min(projects.size(), first + PAGE_SIZE);
+
+    auto previousButton = std::make_shared<Button>(
+        sf::Vector2f(760, 20),
+        sf::Vector2f(120, 40),
+        languagePack[TextKey::PreviousPage]
+    );
+    previousButton->setOnClick([this]() {
+        if (page > 0) {
+            page--;
+            pendingOperations.push([this]() { scrollView.reset(); createUI(); });
+        }
+    });
+
+    auto pageText = std::make_shared<Text>(
+        sf::Vector2f(900, 28),
+        20.f,
+        languagePack[TextKey::Page] + " " + std::to_string(page + 1) + " / " + std::to_string(pageCount),
+        sf::Color::White
+    );
+
+    auto nextButton = std::make_shared<Button>(
+        sf::Vector2f(1040, 20),
+        sf::Vector2f(120, 40),
+        languagePack[TextKey::NextPage]
+    );
+    nextButton->setOnClick([this, pageCount]() {
+        if (page + 1 < pageCount) {
+            page++;
+            pendingOperations.push([this]() { scrollView.reset(); createUI(); });
+        }
+    });
+
+    for (size_t i = 0; i < last - first; ++i) {
+        const ProjectIndexEntry& project = projects[first + i];
         auto container = std::make_shared<Container>(
             sf::Vector2f(20, 100 * i),
             sf::Vector2f(1880, 100)
         );
+        std::string filePath = project.filePath;
+        auto thumbnail = std::make_shared<Thumbnail>(
+            sf::Vector2f(40, 110 + 100 * i),
+            sf::Vector2f(144, 81),
+            [filePath, key = project.thumbnailKey]() { return ThumbnailCache::getInstance().get(filePath, key); }
+        );
         auto projectTitle = std::make_shared<Text>(
-            sf::Vector2f(40, 120 + 100 * i),
+            sf::Vector2f(200, 120 + 100 * i),
             20.f,
             project.fileName
         );
+        std::string details = languagePack[TextKey::Date] + project.lastUpdateDate;
+        if (project.countsKnown) {
+            details += "    " + languagePack[TextKey::Objects] + ": " + std::to_string(project.objectCount)
+                + "    " + languagePack[TextKey::Faces] + ": " + std::to_string(project.faceCount);
+        }
         auto projectDate = std::make_shared<Text>(
-            sf::Vector2f(40, 150 + 100 * i),
+            sf::Vector2f(200, 150 + 100 * i),
             15.f,
-            static_cast<std::string>(languagePack["date"]) + project.lastUpdateDate
+            details
         );
         auto deleteButton = std::make_shared<Button>(
             sf::Vector2f(500, 120 + 100 * i),
             sf::Vector2f(100, 50),
-            languagePack["delete"]
+            languagePack[TextKey::Delete]
         );
         deleteButton->setIcon("delete");
         deleteButton->setPosition({1880 - deleteButton->getWidth(), deleteButton->getPosition().y});
 
-        deleteButton->setOnClick([this, project]() {
+        deleteButton->setOnClick([filePath]() {
             ProjectsManager& projectsManager = ProjectsManager::getInstance();
-            projectsManager.deleteProject(project.filePath);
-            pendingOperations.push([this]() {
-                createUI();
-                auto languagePack = LanguageManager::getInstance().getSelectedPack();
-                Snackbar::getInstance().addMessage(languagePack["project_deleted"]);
-            });
+            try {
+                projectsManager.deleteProject(filePath);
+                const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+                Snackbar::getInstance().addMessage(languagePack[TextKey::ProjectDeleted]);
+            } catch (const std::filesystem::filesystem_error& e) {
+                std::cerr << "Error deleting project: " << e.what() << std::endl;
+                const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+                Snackbar::getInstance().addMessage(languagePack[TextKey::ErrorAccessingProjectsFolder]);
+            } catch (const std::exception& e) {
+                // deleteProject has already told the user
+                std::cerr << e.what() << std::endl;
+            }
+            // The index has dropped the project, so draw() rebuilds the rows without it
         });
 
         auto openButton = std::make_shared<Button>(
             sf::Vector2f(500, 120 + 100 * i),
             sf::Vector2f(100, 50),
-            languagePack["open"]
+            languagePack[TextKey::Open]
         );
         openButton->setIcon("open");
         openButton->setPosition({1860 - openButton->getWidth() - deleteButton->getWidth(), openButton->getPosition().y});
 
-        openButton->setOnClick([project]() {
+        auto openProject = [filePath]() {
             ProjectsManager& projectsManager = ProjectsManager::getInstance();
-            projectsManager.setProject(project.filePath);
+            projectsManager.setProject(filePath);
             ViewsManager::getInstance().switchTo("editor");
-        });
+        };
+        openButton->setOnClick(openProject);
+        thumbnail->setOnClick(openProject);
 
         auto divider = std::make_shared<Surface>(
             sf::Vector2f(20,  195 + 100 * i),
@@ -129,28 +195,40 @@ void ProjectsView::createUI() {
             sf::Color(100, 100, 100)
         );
 
+        container->addComponent(thumbnail);
         container->addComponent(openButton);
         container->addComponent(deleteButton);
         container->addComponent(projectTitle);
         container->addComponent(projectDate);
-        if (i + 1 < projectsManager.getProjects().size()) {
+        if (first + i + 1 < last) {
             container->addComponent(divider);
         }
         scrollView->addComponent(container);
-        i++;
     }
+    scrollView->setScrollOffset(scrollOffset);
     this->addComponent(headerSurface);
     this->addComponent(backButton);
     this->addComponent(title);
+    if (pageCount > 1) {
+        this->addComponent(previousButton);
+        this->addComponent(pageText);
+        this->addComponent(nextButton);
+    }
     this->addComponent(addProjectButton);
     this->addComponent(scrollView);
 }
 
 void ProjectsView::onActivate() {
+    scrollView.reset();
     createUI();
 }
 
 void ProjectsView::draw(sf::RenderWindow& window) {
+    // Rebuilds the rows once the index picks up changes in the projects folder
+    ProjectsManager::getInstance().getProjects();
+    if (ProjectIndex::getInstance().getRevision() != shownRevision) {
+        createUI();
+    }
     for (auto& component : components) {
         component->draw(window);
     }
@@ -1,10 +1,14 @@
 #ifndef PROJECTS_VIEW_HPP
 #define PROJECTS_VIEW_HPP
 
+#include <cstdint>
+#include <memory>
 #include <queue>
 
 #include "View.hpp"
 
+class ScrollView;
+
 class ProjectsView: public View {
 public:
     ProjectsView();
@@ -13,8 +17,15 @@ public:
     void handleEvent(const sf::Event& event, sf::RenderWindow& window);
     void draw(sf::RenderWindow& window);
 private:
+    // Rows are built for one page of projects at a time
+    static constexpr size_t PAGE_SIZE = 20;
+
     void createUI();
     std::queue<std::function<void()>> pendingOperations;
+    std::shared_ptr<ScrollView> scrollView;
+    size_t page = 0;
+    // Index revision the rows were built from
+    uint64_t shownRevision = 0;
 };
 
 #endif
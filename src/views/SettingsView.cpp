@@ -25,7 +25,7 @@ void SettingsView::onActivate() {
 void SettingsView::createUI() {
     components.clear();
     Config &config = Config::getInstance();
-    auto languagePack = LanguageManager::getInstance().getSelectedPack();
+    const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
 
     auto headerSurface = std::make_shared<Surface>(
         sf::Vector2f(0, 0),
@@ -36,7 +36,7 @@ void SettingsView::createUI() {
     auto backButton = std::make_shared<Button>(
         sf::Vector2f(20, 20),
         sf::Vector2f(100, 40),
-        languagePack["back"]
+        languagePack[TextKey::Back]
     );
 
     backButton->setIcon("back");
@@ -48,7 +48,7 @@ void SettingsView::createUI() {
     auto title = std::make_shared<Text>(
         sf::Vector2f(backButton->getWidth() + 40, 20),
         30.f,
-        languagePack["settings"],
+        languagePack[TextKey::Settings],
         sf::Color::White
     );
 
@@ -61,7 +61,7 @@ void SettingsView::createUI() {
     auto authorsTitle = std::make_shared<Text>(
         sf::Vector2f(50, 140),
         25,
-        languagePack["authors"]
+        languagePack[TextKey::Authors]
     );
     authorsTitle->setBold();
 
@@ -81,7 +81,7 @@ void SettingsView::createUI() {
     auto projectsPathTitle = std::make_shared<Text>(
         sf::Vector2f(50, 290),
         25,
-        static_cast<std::string>(languagePack["projectsPath"]) + ": "
+        languagePack[TextKey::ProjectsPath] + ": "
     );
     projectsPathTitle->setBold();
 
@@ -94,7 +94,7 @@ void SettingsView::createUI() {
     auto selectPathButton = std::make_shared<Button>(
         sf::Vector2f(projectsPathText->getWidth() + 70, 335),
         sf::Vector2f(100, 40),
-        languagePack["change"]
+        languagePack[TextKey::Change]
     );
     selectPathButton->setIcon("folder");
 
@@ -120,7 +120,7 @@ void SettingsView::createUI() {
     auto inertiaText = std::make_shared<Text>(
         sf::Vector2f(50, 440),
         25,
-        static_cast<std::string>(languagePack["inertia"]) + ": "
+        languagePack[TextKey::Inertia] + ": "
     );
 
     inertiaText->setBold();
@@ -144,7 +144,7 @@ void SettingsView::createUI() {
     auto sensitivityText = std::make_shared<Text>(
         sf::Vector2f(50, 590),
         25,
-        static_cast<std::string>(languagePack["sensitivity"]) + ": " + config.getFormattedSensitivity()
+        languagePack[TextKey::Sensitivity] + ": " + config.getFormattedSensitivity()
     );
     sensitivityText->setBold();
 
@@ -155,10 +155,10 @@ void SettingsView::createUI() {
     );
 
     sensitivitySlider->setOnClick(
-        static_cast<std::function<void(float)>>([this, sensitivityText, languagePack](float value) -> void {
+        static_cast<std::function<void(float)>>([this, sensitivityText, &languagePack](float value) -> void {
             Config &config = Config::getInstance();
             config.updateSensitivity(value);
-            sensitivityText->setText(static_cast<std::string>(languagePack["sensitivity"]) + ": " + config.getFormattedSensitivity());
+            sensitivityText->setText(languagePack[TextKey::Sensitivity] + ": " + config.getFormattedSensitivity());
         }));
 
     auto sensitivityDividerEnd = std::make_shared<Surface>(
@@ -170,7 +170,7 @@ void SettingsView::createUI() {
     auto languageText = std::make_shared<Text>(
         sf::Vector2f(50, 740),
         25,
-        languagePack["language"]
+        languagePack[TextKey::Language]
     );
     languageText->setBold();
 
@@ -10,20 +10,20 @@ AddObjectsMenu::AddObjectsMenu() {
 }
 
 void AddObjectsMenu::createUI() {
-    auto languagePack = LanguageManager::getInstance().getSelectedPack();
+    const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
 
     components.clear();
 
     auto title = std::make_shared<Text>(
         sf::Vector2f(parentPosition.x + 20, 20),
         30,
-        languagePack["Add objects"]
+        languagePack[TextKey::AddObjects]
     );
 
     auto addTriangleButton = std::make_shared<Button>(
            sf::Vector2f(parentPosition.x + 20, 80),
            sf::Vector2f(310, 50),
-           languagePack["triangle"]
+           languagePack[TextKey::Triangle]
        );
 
     addTriangleButton->setIcon("triangle");
@@ -32,14 +32,14 @@ void AddObjectsMenu::createUI() {
         sf::RenderWindow& window = WindowManager::getInstance().getWindow();
         Scene& scene = Scene::getInstance(window);
         scene.addObject("triangle");
-        auto languagePack = LanguageManager::getInstance().getSelectedPack();
-        Snackbar::getInstance().addMessage(languagePack["object_added"]);
+        const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+        Snackbar::getInstance().addMessage(languagePack[TextKey::ObjectAdded]);
     });
 
     auto addCubeButton = std::make_shared<Button>(
         sf::Vector2f(parentPosition.x + 20, 150),
         sf::Vector2f(310, 50),
-        languagePack["Cube"]
+        languagePack[TextKey::Cube]
     );
 
     addCubeButton->setIcon("cube");
@@ -48,14 +48,14 @@ void AddObjectsMenu::createUI() {
         sf::RenderWindow& window = WindowManager::getInstance().getWindow();
         Scene& scene = Scene::getInstance(window);
         scene.addObject("cube");
-        auto languagePack = LanguageManager::getInstance().getSelectedPack();
-        Snackbar::getInstance().addMessage(languagePack["object_added"]);
+        const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+        Snackbar::getInstance().addMessage(languagePack[TextKey::ObjectAdded]);
     });
 
     auto addSphereButton = std::make_shared<Button>(
          sf::Vector2f(parentPosition.x + 20, 220),
          sf::Vector2f(310, 50),
-         languagePack["Sphere"]
+         languagePack[TextKey::Sphere]
      );
 
     addSphereButton->setIcon("sphere");
@@ -64,22 +64,22 @@ void AddObjectsMenu::createUI() {
         sf::RenderWindow& window = WindowManager::getInstance().getWindow();
         Scene& scene = Scene::getInstance(window);
         scene.addObject("sphere");
-        auto languagePack = LanguageManager::getInstance().getSelectedPack();
-        Snackbar::getInstance().addMessage(languagePack["object_added"]);
+        const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+        Snackbar::getInstance().addMessage(languagePack[TextKey::ObjectAdded]);
     });
 
     auto addCylinderButton = std::make_shared<Button>(
          sf::Vector2f(parentPosition.x + 20, 290),
          sf::Vector2f(310, 50),
-         languagePack["Cylinder"]
+         languagePack[TextKey::Cylinder]
      );
 
     addCylinderButton->setOnClick([]() {
         sf::RenderWindow& window = WindowManager::getInstance().getWindow();
         Scene& scene = Scene::getInstance(window);
         scene.addObject("cylinder");
-        auto languagePack = LanguageManager::getInstance().getSelectedPack();
-        Snackbar::getInstance().addMessage(languagePack["object_added"]);
+        const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+        Snackbar::getInstance().addMessage(languagePack[TextKey::ObjectAdded]);
     });
 
     addCylinderButton->setIcon("cylinder");
@@ -87,15 +87,15 @@ void AddObjectsMenu::createUI() {
     auto addConeButton = std::make_shared<Button>(
          sf::Vector2f(parentPosition.x + 20, 360),
          sf::Vector2f(310, 50),
-          languagePack["Cone"]
+          languagePack[TextKey::Cone]
      );
 
     addConeButton->setOnClick([]() {
         sf::RenderWindow& window = WindowManager::getInstance().getWindow();
         Scene& scene = Scene::getInstance(window);
         scene.addObject("cone");
-        auto languagePack = LanguageManager::getInstance().getSelectedPack();
-        Snackbar::getInstance().addMessage(languagePack["object_added"]);
+        const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+        Snackbar::getInstance().addMessage(languagePack[TextKey::ObjectAdded]);
     });
 
     addConeButton->setIcon("cone");
@@ -103,15 +103,15 @@ void AddObjectsMenu::createUI() {
     auto addTorusButton = std::make_shared<Button>(
          sf::Vector2f(parentPosition.x + 20, 430),
          sf::Vector2f(310, 50),
-         languagePack["torus"]
+         languagePack[TextKey::Torus]
      );
 
     addTorusButton->setOnClick([]() {
         sf::RenderWindow& window = WindowManager::getInstance().getWindow();
         Scene& scene = Scene::getInstance(window);
         scene.addObject("torus");
-        auto languagePack = LanguageManager::getInstance().getSelectedPack();
-        Snackbar::getInstance().addMessage(languagePack["object_added"]);
+        const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+        Snackbar::getInstance().addMessage(languagePack[TextKey::ObjectAdded]);
     });
 
     addTorusButton->setIcon("torus");
@@ -119,7 +119,7 @@ void AddObjectsMenu::createUI() {
     auto importButton = std::make_shared<Button>(
          sf::Vector2f(parentPosition.x + 20, 500),
          sf::Vector2f(310, 50),
-         languagePack["import"]
+         languagePack[TextKey::Import]
      );
 
     importButton->setIcon("import");
@@ -128,8 +128,8 @@ void AddObjectsMenu::createUI() {
         sf::RenderWindow& window = WindowManager::getInstance().getWindow();
         Scene& scene = Scene::getInstance(window);
         scene.addObject("import");
-        auto languagePack = LanguageManager::getInstance().getSelectedPack();
-        Snackbar::getInstance().addMessage(languagePack["file_imported"]);
+        const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+        Snackbar::getInstance().addMessage(languagePack[TextKey::FileImported]);
     });
 
     this->addComponent(title);
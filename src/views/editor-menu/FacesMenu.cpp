@@ -1,123 +1,150 @@
 #include "FacesMenu.hpp"
 #include "../../core/feature/Scene.hpp"
-#include "../../core/ui/Container.hpp"
 #include "../../utils/WindowManager.hpp"
 #include "../../core/ui/NumberInput.hpp"
 #include "../../core/ui/Input.hpp"
 #include "../../core/ui/ScrollView.hpp"
 #include "../../core/ui/Expandable.hpp"
+#include "../../core/ui/ItemRow.hpp"
 #include "../../core/ui/Snackbar.hpp"
 #include "../../utils/LanguageManager.hpp"
 
 FacesMenu::FacesMenu() : currentSelectedObject(nullptr) {}
 
 void FacesMenu::createUI() {
-    auto languagePack = LanguageManager::getInstance().getSelectedPack();
+    const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
     objectList.clear();
     components.clear();
 
     auto title = std::make_shared<Text>(
         sf::Vector2f(parentPosition.x + 20, 20),
         20,
-        languagePack["Faces"]
+        languagePack[TextKey::Faces]
     );
     objectList.push_back(title);
 
     sf::RenderWindow& window = WindowManager::getInstance().getWindow();
     Scene& scene = Scene::getInstance(window);
-    std::vector<std::shared_ptr<Object3d>> objects = scene.getObjects();
+    sceneObjects = scene.getObjects();
+    syncSelectedObject();
+    updateExpandedObject();
 
     auto scrollView = std::make_shared<ScrollView>(
         sf::Vector2f(parentPosition.x + 20, 60),
         sf::Vector2f(310, 300),
         300.f
     );
+    scrollView->setVirtualRows(getRowCount(), 30.f, [this](size_t index, std::shared_ptr<Component> recycled) {
+        return createRow(index, std::move(recycled));
+    });
 
-    for (int i = 1; i < objects.size(); ++i) {
-        auto objButton = std::make_shared<Expandable>(
-            sf::Vector2f(parentPosition.x + 20, 60 + 30 * (i - 1)),
-            sf::Vector2f(290, 30),
-            languagePack["Object"].get<std::string>() + " " + std::to_string(i)
-        );
+    objectList.push_back(scrollView);
+    objectsScroll = scrollView;
+}
 
-        objButton->setOnClick([this, i, &scene]() {
-            scene.onChangeSelectedObjectIndex(i);
-            currentSelectedObject = scene.getObjects()[i];
-        });
+void FacesMenu::updateExpandedObject() {
+    expandedObject = 0;
+    expandedFaceCount = 0;
+    for (size_t i = 1; i < sceneObjects.size(); ++i) {
+        if (sceneObjects[i] == currentSelectedObject) {
+            expandedObject = i;
+            expandedFaceCount = sceneObjects[i]->getFaces().size();
+        }
+    }
+}
 
-        int j = 0;
-        for (auto face : objects[i]->getFaces()) {
-            auto faceContainer = std::make_shared<Container>(
-                sf::Vector2f(parentPosition.x + 40, 60 + 30 * (j + i)),
-                sf::Vector2f(250, 30)
-            );
-            auto faceButton = std::make_shared<Button>(
-                sf::Vector2f(parentPosition.x + 40, 60 + 30 * (j + i)),
-                sf::Vector2f(240, 30),
-                 languagePack["Face"].get<std::string>() + " " + std::to_string(j + 1)
-            );
-            if (objects[i]->isFaceHovered(j)) {
-                faceButton->setColor(sf::Color(255, 255, 150));
-            }
-            if (objects[i]->isFaceSelected(j)) {
-                faceButton->setColor(sf::Color(255, 255, 100));
-            }
+size_t FacesMenu::getRowCount() const {
+    return sceneObjects.empty() ? 0 : sceneObjects.size() - 1 + expandedFaceCount;
+}
 
-            faceButton->setOnClick([this, j, faceButton]() {
-                auto& selectedFaces = currentSelectedObject->selectedFaces;
-                auto it = std::find(selectedFaces.begin(), selectedFaces.end(), j);
-                if (it != selectedFaces.end()) {
-                    selectedFaces.erase(it);
-                } else {
-                    selectedFaces.push_back(j);
-                }
-                updateFacePropertiesMenu();
-            });
-            faceButton->setOnHover([this, j]() {
-                auto& hoveredFaces = currentSelectedObject->hoveredFaces;
-                auto it = std::find(hoveredFaces.begin(), hoveredFaces.end(), j);
-                if (it == hoveredFaces.end()) {
-                    hoveredFaces.push_back(j);
-                }
-            });
-            faceButton->setOnHoverOut([this, j]() {
-                auto& hoveredFaces = currentSelectedObject->hoveredFaces;
-                auto it = std::find(hoveredFaces.begin(), hoveredFaces.end(), j);
-                if (it != hoveredFaces.end()) {
-                    hoveredFaces.erase(it);
-                }
-            });
-            auto deleteFaceButton = std::make_shared<Button>(
-                sf::Vector2f(parentPosition.x + 280, 60 + 30 * (j + i)),
-                sf::Vector2f(30, 30),
+bool FacesMenu::isFaceRow(size_t index) const {
+    return expandedObject > 0 && index >= expandedObject && index < expandedObject + expandedFaceCount;
+}
+
+sf::Color FacesMenu::getFaceRowColor(int faceIndex) const {
+    const auto& object = sceneObjects[expandedObject];
+    if (object->isFaceSelected(faceIndex)) {
+        return sf::Color(255, 255, 100);
+    }
+    if (object->isFaceHovered(faceIndex)) {
+        return sf::Color(255, 255, 150);
+    }
+    return sf::Color::White;
+}
+
+std::shared_ptr<Component> FacesMenu::createRow(size_t index, std::shared_ptr<Component> recycled) {
+    const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+
+    if (!isFaceRow(index)) {
+        int i = static_cast<int>(expandedObject > 0 && index >= expandedObject ? index - expandedFaceCount + 1 : index + 1);
+        auto objButton = std::dynamic_pointer_cast<Expandable>(recycled);
+        if (!objButton) {
+            objButton = std::make_shared<Expandable>(
+                sf::Vector2f(parentPosition.x + 20, 60),
+                sf::Vector2f(290, 30),
                 ""
             );
-            deleteFaceButton->setIcon("delete");
-            deleteFaceButton->setOnClick([this, j]() {
-                pendingOperations.push([this, j]() {
-                    currentSelectedObject->deleteFaceByIndex(j);
-                    createUI();
-                    auto languagePack = LanguageManager::getInstance().getSelectedPack();
-                    Snackbar::getInstance().addMessage(languagePack["face_deleted"]);
-                });
-            });
-            faceContainer->addComponent(faceButton);
-            faceContainer->addComponent(deleteFaceButton);
-            objButton->addContent(faceContainer);
-            j++;
         }
-
-        scrollView->addComponent(objButton);
+        objButton->setHeaderText(languagePack[TextKey::Object] + " " + std::to_string(i));
+        if (currentSelectedObject) {
+            objButton->setTextColor(sceneObjects[i] == currentSelectedObject ? sf::Color::Yellow : sf::Color::Black);
+        } else {
+            objButton->setTextColor(sf::Color::White);
+        }
+        objButton->setOnClick([this, i]() {
+            Scene& scene = Scene::getInstance(WindowManager::getInstance().getWindow());
+            scene.onChangeSelectedObjectIndex(i);
+            currentSelectedObject = scene.getObjects()[i];
+        });
+        return objButton;
     }
 
-    objectList.push_back(scrollView);
-    objectsScroll = scrollView;
+    int j = static_cast<int>(index - expandedObject);
+    auto faceRow = std::dynamic_pointer_cast<ItemRow>(recycled);
+    if (!faceRow) {
+        faceRow = std::make_shared<ItemRow>(
+            sf::Vector2f(parentPosition.x + 40, 60),
+            sf::Vector2f(270, 30)
+        );
+    }
 
+    Button& faceButton = faceRow->getItemButton();
+    faceButton.setText(languagePack[TextKey::Face] + " " + std::to_string(j + 1));
+    faceButton.setColor(getFaceRowColor(j));
 
-    int selectedIndex = scene.getSelectedObjectIndex();
-    if (selectedIndex > 1 && selectedIndex < objects.size()) {
-        currentSelectedObject = objects[selectedIndex];
-    }
+    faceButton.setOnClick([this, j]() {
+        auto& selectedFaces = currentSelectedObject->selectedFaces;
+        auto it = std::find(selectedFaces.begin(), selectedFaces.end(), j);
+        if (it != selectedFaces.end()) {
+            selectedFaces.erase(it);
+        } else {
+            selectedFaces.push_back(j);
+        }
+        updateFacePropertiesMenu();
+    });
+    faceButton.setOnHover([this, j]() {
+        auto& hoveredFaces = currentSelectedObject->hoveredFaces;
+        auto it = std::find(hoveredFaces.begin(), hoveredFaces.end(), j);
+        if (it == hoveredFaces.end()) {
+            hoveredFaces.push_back(j);
+        }
+    });
+    faceButton.setOnHoverOut([this, j]() {
+        auto& hoveredFaces = currentSelectedObject->hoveredFaces;
+        auto it = std::find(hoveredFaces.begin(), hoveredFaces.end(), j);
+        if (it != hoveredFaces.end()) {
+            hoveredFaces.erase(it);
+        }
+    });
+    faceRow->getActionButton(0).setOnClick([this, j]() {
+        pendingOperations.push([this, j]() {
+            currentSelectedObject->deleteFaceByIndex(j);
+            Scene::getInstance(WindowManager::getInstance().getWindow()).notifyTopologyChanged(static_cast<int>(expandedObject));
+            const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+            Snackbar::getInstance().addMessage(languagePack[TextKey::FaceDeleted]);
+        });
+    });
+    return faceRow;
 }
 
 void FacesMenu::draw(sf::RenderWindow &window) {
@@ -141,7 +168,8 @@ void FacesMenu::handleEvent(const sf::Event& event, const sf::RenderWindow& wind
     if (objectList.empty()) {
         createUI();
     }
-    updateFacesButtons();
+    updateRowColors();
+    updateFacePropertiesMenu();
     for (const auto& component : objectList) {
         component->handleEvent(event, window);
     }
@@ -154,84 +182,82 @@ void FacesMenu::handleEvent(const sf::Event& event, const sf::RenderWindow& wind
     }
 }
 
-void FacesMenu::updateFacesButtons() {
-    sf::RenderWindow& window = WindowManager::getInstance().getWindow();
-    Scene& scene = Scene::getInstance(window);
-    std::vector<std::shared_ptr<Object3d>> objects = scene.getObjects();
-    int selectedIndex = scene.getSelectedObjectIndex();
-    if (selectedIndex > 0 && selectedIndex < objects.size()) {
-        if (currentSelectedObject && objects[selectedIndex] != currentSelectedObject) {
-            currentSelectedObject->selectedFaces.clear();
-        }
-        currentSelectedObject = objects[selectedIndex];
+void FacesMenu::onSceneChanged(const SceneChange& change) {
+    if (!objectsScroll) {
+        return;
     }
-    auto objectsList = objectsScroll->getComponents();
-    for (int i = 0; i < objectsList.size(); ++i) {
-        auto objButton = std::dynamic_pointer_cast<Expandable>(objectsList[i]);
-        if (currentSelectedObject) {
-            if (objects[i + 1] == currentSelectedObject) {
-                objButton->setTextColor(sf::Color::Yellow);
-            }
-            else {
-                objButton->setTextColor(sf::Color::Black);
-            }
-            objButton->setExpanded(objects[i + 1] == currentSelectedObject);
-        }
-        if (objButton) {
-            auto content= objButton->getContent();
-            int j = 0;
-            for (const auto& faceComponent: content) {
-                auto faceContainer = std::dynamic_pointer_cast<Container>(faceComponent);
-                auto faceButton = std::dynamic_pointer_cast<Button>(faceContainer->getComponents()[0]);
-                if (faceButton) {
-                    if (objects[i + 1]->isFaceHovered(j)) {
-                        faceButton->setColor(sf::Color(255, 255, 150));
-                    }
-                    if (objects[i + 1]->isFaceSelected(j)) {
-                        faceButton->setColor(sf::Color(255, 255, 100));
-                    }
-                    if (!objects[i + 1]->isFaceHovered(j) && !objects[i + 1]->isFaceSelected(j)) {
-                        faceButton->setColor(sf::Color::White);
-                    }
-                }
-                j++;
+    switch (change.type) {
+        case SceneChange::Type::TopologyChanged:
+            if (change.objectIndex != static_cast<int>(expandedObject)) {
+                return;
             }
+            break;
+        case SceneChange::Type::SelectionChanged:
+            syncSelectedObject();
+            break;
+        default:
+            sceneObjects = Scene::getInstance(WindowManager::getInstance().getWindow()).getObjects();
+            break;
+    }
+    // Only marks the rows for rebinding; the visible ones are rebound when next drawn
+    updateExpandedObject();
+    objectsScroll->setRowCount(getRowCount());
+}
+
+void FacesMenu::syncSelectedObject() {
+    int selectedIndex = Scene::getInstance(WindowManager::getInstance().getWindow()).getSelectedObjectIndex();
+    if (selectedIndex > 0 && selectedIndex < sceneObjects.size()) {
+        if (currentSelectedObject && sceneObjects[selectedIndex] != currentSelectedObject) {
+            currentSelectedObject->selectedFaces.clear();
         }
+        currentSelectedObject = sceneObjects[selectedIndex];
     }
-    updateFacePropertiesMenu();
+}
+
+void FacesMenu::updateRowColors() {
+    // Hover and selection of faces change on every mouse move, so only the rows on screen are restyled
+    objectsScroll->forEachVisibleRow([this](size_t index, Component& row) {
+        if (isFaceRow(index)) {
+            int j = static_cast<int>(index - expandedObject);
+            static_cast<ItemRow&>(row).getItemButton().setColor(getFaceRowColor(j));
+        }
+    });
 }
 
 
 void FacesMenu::onActivate() {
     createUI();
-    objectList.clear();
     sf::RenderWindow& window = WindowManager::getInstance().getWindow();
     Scene& scene = Scene::getInstance(window);
     scene.setFacesEditMode(true);
     createFacePropertiesMenu();
+    if (!sceneListener) {
+        sceneListener = scene.addListener([this](const SceneChange& change) { onSceneChanged(change); });
+    }
 }
 
 void FacesMenu::onDeactivate() {
     objectList.clear();
     facePropertiesMenu.clear();
-    objectList.clear();
     sf::RenderWindow& window = WindowManager::getInstance().getWindow();
     Scene& scene = Scene::getInstance(window);
     scene.setFacesEditMode(false);
+    scene.removeListener(sceneListener);
+    sceneListener = 0;
 }
 
 void FacesMenu::createFacePropertiesMenu() {
-    auto languagePack = LanguageManager::getInstance().getSelectedPack();
+    const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
     title = std::make_shared<Text>(
         sf::Vector2f(parentPosition.x + 20, 410),
         20,
-        languagePack["Face properties"]
+        languagePack[TextKey::FaceProperties]
     );
     title->setBold();
     scaleX = std::make_shared<NumberInput>(
        sf::Vector2f(parentPosition.x + 20, 450),
        sf::Vector2f(90, 50),
-       languagePack["Scale"]
+       languagePack[TextKey::Scale]
    );
     scaleX->setValue(0);
     scaleX->setOnClick(static_cast<std::function<void(float)>>([this](float value) {
@@ -241,7 +267,7 @@ void FacesMenu::createFacePropertiesMenu() {
     position = std::make_shared<Text>(
         sf::Vector2f(parentPosition.x + 20, 520),
         20,
-        languagePack["Position"]
+        languagePack[TextKey::Position]
     );
     positionX = std::make_shared<NumberInput>(
         sf::Vector2f(parentPosition.x + 20, 550),
@@ -273,7 +299,7 @@ void FacesMenu::createFacePropertiesMenu() {
     rotation = std::make_shared<Text>(
         sf::Vector2f(parentPosition.x + 20, 620),
         20,
-        languagePack["Rotation"]
+        languagePack[TextKey::Rotation]
     );
     rotationX = std::make_shared<NumberInput>(
         sf::Vector2f(parentPosition.x + 20, 650),
@@ -308,8 +334,8 @@ void FacesMenu::createFacePropertiesMenu() {
     color = std::make_shared<Input>(
        sf::Vector2f(parentPosition.x + 20, 750),
        sf::Vector2f(200, 50),
-       languagePack["Color"],
-       languagePack["Color"]
+       languagePack[TextKey::Color],
+       languagePack[TextKey::Color]
     );
     color->setOnClick(std::function([this](std::string value) {
         if (currentSelectedObject->selectedFaces.size() == 1) {
@@ -324,7 +350,7 @@ void FacesMenu::createFacePropertiesMenu() {
     changeNormal = std::make_shared<Button>(
       sf::Vector2f(parentPosition.x + 20, 820),
       sf::Vector2f(200, 50),
-      languagePack["inverse_normal"]
+      languagePack[TextKey::InverseNormal]
     );
     changeNormal->setIcon("change_face_normal");
     changeNormal->setOnClick(([this]() {
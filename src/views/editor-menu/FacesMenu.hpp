@@ -13,6 +13,7 @@
 #include "../../core/ui/Input.hpp"
 #include "../../core/ui/NumberInput.hpp"
 #include "../../core/ui/ScrollView.hpp"
+#include "../../core/feature/Scene.hpp"
 
 class FacesMenu: public Menu {
 public:
@@ -34,10 +35,25 @@ private:
     std::queue<std::function<void()>> pendingOperations;
 
 
+    // The list shows a header per object, with the faces of the selected object under its header
+    std::vector<std::shared_ptr<Object3d>> sceneObjects;
+    size_t expandedObject = 0;
+    size_t expandedFaceCount = 0;
+
+    int sceneListener = 0;
+
+    void onSceneChanged(const SceneChange& change);
+    void syncSelectedObject();
+    void updateExpandedObject();
+    size_t getRowCount() const;
+    bool isFaceRow(size_t index) const;
+    sf::Color getFaceRowColor(int faceIndex) const;
+    std::shared_ptr<Component> createRow(size_t index, std::shared_ptr<Component> recycled);
+    void updateRowColors();
+
     void addObjectPropertiesMenu(std::shared_ptr<Object3d> object);
     void createFacePropertiesMenu();
     void updateFacePropertiesMenu();
-    void updateFacesButtons();
 
     std::shared_ptr<Text> title;
     std::shared_ptr<NumberInput> scaleX;
@@ -30,7 +30,7 @@ void MenuManager::onDeactivate() {
 
 void MenuManager::createUI() {
     components.clear();
-    auto languagePack = LanguageManager::getInstance().getSelectedPack();
+    const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
     auto background = std::make_shared<Surface>(
         parentPosition, parentSize, sf::Color(100, 100, 100)
     );
@@ -99,7 +99,7 @@ sf::Vector2f(parentPosition.x - 60, 130),
     auto homeButton = std::make_shared<Button>(
         sf::Vector2f(10, 10),
         sf::Vector2f(120, 50),
-        languagePack["Home"]
+        languagePack[TextKey::Home]
     );
 
     homeButton->setIcon("home");
@@ -1,7 +1,7 @@
 #include "ObjectsMenu.hpp"
 #include "../../core/feature/Scene.hpp"
 #include "../../core/objects/ObjectsFactory.hpp"
-#include "../../core/ui/Container.hpp"
+#include "../../core/ui/ItemRow.hpp"
 #include "../../utils/WindowManager.hpp"
 #include "../../core/ui/NumberInput.hpp"
 #include "../../core/ui/Snackbar.hpp"
@@ -11,14 +11,14 @@ ObjectsMenu::ObjectsMenu() : currentSelectedObject(nullptr) {
 }
 
 void ObjectsMenu::createUI() {
-    auto languagePack = LanguageManager::getInstance().getSelectedPack();
+    const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
     objectList.clear();
     components.clear();
 
     auto title = std::make_shared<Text>(
         sf::Vector2f(parentPosition.x + 20, 20),
         20,
-        languagePack["Objects"]
+        languagePack[TextKey::Objects]
     );
     objectList.push_back(title);
 
@@ -31,67 +31,10 @@ void ObjectsMenu::createUI() {
         sf::Vector2f(310, 300),
         300.f
     );
-    for (int i = 1; i < objects.size(); ++i) {
-        auto objContainer = std::make_shared<Container>(
-            sf::Vector2f(parentPosition.x + 20, 60 + 40 * (i - 1)),
-            sf::Vector2f(310, 40)
-        );
-        auto objButton = std::make_shared<Button>(
-            sf::Vector2f(parentPosition.x + 20, 60 + 40 * (i - 1)),
-            sf::Vector2f(220, 40),
-            languagePack["Object"].get<std::string>() + " " + std::to_string(i)
-        );
-        auto copyObjButton = std::make_shared<Button>(
-            sf::Vector2f(parentPosition.x + 240, 60 + 40 * (i - 1)),
-            sf::Vector2f(40, 40),
-            ""
-        );
-        copyObjButton->setIcon("copy");
-        copyObjButton->setOnClick([this, i]() {
-            pendingOperations.push([this, i]() {
-                sf::RenderWindow &window = WindowManager::getInstance().getWindow();
-                Scene &scene = Scene::getInstance(window);
-                scene.copyObjectByIndex(i);
-                createUI();
-                auto languagePack = LanguageManager::getInstance().getSelectedPack();
-                Snackbar::getInstance().addMessage(languagePack["object_copied"]);
-            });
-
-        });
-        auto deleteObjButton = std::make_shared<Button>(
-            sf::Vector2f(parentPosition.x + 280, 60 + 40 * (i - 1)),
-            sf::Vector2f(40, 40),
-            ""
-        );
-        deleteObjButton->setIcon("delete");
-        deleteObjButton->setOnClick([this, i]() {
-            pendingOperations.push([this, i]() {
-                sf::RenderWindow &window = WindowManager::getInstance().getWindow();
-                Scene &scene = Scene::getInstance(window);
-                scene.deleteObjectByIndex(i);
-                createUI();
-                auto languagePack = LanguageManager::getInstance().getSelectedPack();
-                Snackbar::getInstance().addMessage(languagePack["object_deleted"]);
-            });
-        });
-
-        objButton->setOnClick([this, i, &scene]() {
-            scene.toggleObjectSelected(i);
-            updateObjectsPropertiesMenu();
-        });
-
-        objButton->setOnHover([objects, i]() {
-            objects[i]->isHovered = true;
-        });
-        objButton->setOnHoverOut([objects, i]() {
-            objects[i]->isHovered = false;
-        });
-
-        objContainer->addComponent(objButton);
-        objContainer->addComponent(copyObjButton);
-        objContainer->addComponent(deleteObjButton);
-        scrollView->addComponent(objContainer);
-    }
+    // The grid is object 0 and is not listed, so row r shows object r + 1
+    scrollView->setVirtualRows(objects.empty() ? 0 : objects.size() - 1, 40.f, [this](size_t index, std::shared_ptr<Component> recycled) {
+        return createRow(index, std::move(recycled));
+    });
 
     objectList.push_back(scrollView);
     objectsScroll = scrollView;
@@ -102,8 +45,60 @@ void ObjectsMenu::createUI() {
     }
 }
 
+std::shared_ptr<Component> ObjectsMenu::createRow(size_t index, std::shared_ptr<Component> recycled) {
+    const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+    int i = static_cast<int>(index + 1);
+    auto objRow = std::dynamic_pointer_cast<ItemRow>(recycled);
+    if (!objRow) {
+        objRow = std::make_shared<ItemRow>(
+            sf::Vector2f(parentPosition.x + 20, 60),
+            sf::Vector2f(300, 40),
+            std::vector<std::string>{"copy", "delete"}
+        );
+    }
+
+    Button& objButton = objRow->getItemButton();
+    objButton.setText(languagePack[TextKey::Object] + " " + std::to_string(i));
+    objButton.setOnClick([this, i]() {
+        Scene &scene = Scene::getInstance(WindowManager::getInstance().getWindow());
+        scene.toggleObjectSelected(i);
+        updateObjectsPropertiesMenu();
+    });
+    objButton.setOnHover([i]() {
+        const auto& objects = Scene::getInstance(WindowManager::getInstance().getWindow()).getObjects();
+        if (i < objects.size()) {
+            objects[i]->isHovered = true;
+        }
+    });
+    objButton.setOnHoverOut([i]() {
+        const auto& objects = Scene::getInstance(WindowManager::getInstance().getWindow()).getObjects();
+        if (i < objects.size()) {
+            objects[i]->isHovered = false;
+        }
+    });
+
+    objRow->getActionButton(0).setOnClick([this, i]() {
+        pendingOperations.push([i]() {
+            Scene &scene = Scene::getInstance(WindowManager::getInstance().getWindow());
+            scene.copyObjectByIndex(i);
+            const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+            Snackbar::getInstance().addMessage(languagePack[TextKey::ObjectCopied]);
+        });
+    });
+    objRow->getActionButton(1).setOnClick([this, i]() {
+        pendingOperations.push([i]() {
+            Scene &scene = Scene::getInstance(WindowManager::getInstance().getWindow());
+            scene.deleteObjectByIndex(i);
+            const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+            Snackbar::getInstance().addMessage(languagePack[TextKey::ObjectDeleted]);
+        });
+    });
+    return objRow;
+}
+
 void ObjectsMenu::draw(sf::RenderWindow &window) {
-    updateObjectsButtons();
+    updateRowColors();
+    updateObjectsPropertiesMenu();
 
     for (const auto &component: objectList) {
         component->draw(window);
@@ -115,7 +110,6 @@ void ObjectsMenu::draw(sf::RenderWindow &window) {
     while (!pendingOperations.empty()) {
         pendingOperations.front()();
         pendingOperations.pop();
-        createUI();
     }
 }
 
@@ -142,6 +136,9 @@ void ObjectsMenu::onActivate() {
     scene.setObjectsEditMode(true);
     createUI();
     createObjectsPropertiesMenu();
+    if (!sceneListener) {
+        sceneListener = scene.addListener([this](const SceneChange& change) { onSceneChanged(change); });
+    }
 }
 
 void ObjectsMenu::onDeactivate() {
@@ -150,12 +147,26 @@ void ObjectsMenu::onDeactivate() {
     sf::RenderWindow &window = WindowManager::getInstance().getWindow();
     Scene &scene = Scene::getInstance(window);
     scene.setObjectsEditMode(false);
+    scene.removeListener(sceneListener);
+    sceneListener = 0;
 }
 
-void ObjectsMenu::updateObjectsButtons() {
-    sf::RenderWindow &window = WindowManager::getInstance().getWindow();
-    Scene &scene = Scene::getInstance(window);
-    std::vector<std::shared_ptr<Object3d> > objects = scene.getObjects();
+void ObjectsMenu::onSceneChanged(const SceneChange& change) {
+    if (!objectsScroll) {
+        return;
+    }
+    syncSelectedObject();
+    if (change.type == SceneChange::Type::ObjectAdded || change.type == SceneChange::Type::ObjectRemoved
+        || change.type == SceneChange::Type::ObjectsReset) {
+        // Only marks the rows for rebinding, so the list keeps its scroll position
+        const auto& objects = Scene::getInstance(WindowManager::getInstance().getWindow()).getObjects();
+        objectsScroll->setRowCount(objects.empty() ? 0 : objects.size() - 1);
+    }
+}
+
+void ObjectsMenu::syncSelectedObject() {
+    Scene &scene = Scene::getInstance(WindowManager::getInstance().getWindow());
+    const auto& objects = scene.getObjects();
     int selectedIndex = scene.getSelectedObjectIndex();
     if (selectedIndex > 0 && selectedIndex < objects.size()) {
         if (currentSelectedObject && objects[selectedIndex] != currentSelectedObject) {
@@ -163,25 +174,26 @@ void ObjectsMenu::updateObjectsButtons() {
         }
         currentSelectedObject = objects[selectedIndex];
     }
-    auto objectsList = objectsScroll->getComponents();
-    for (int i = 0; i < objectsList.size(); ++i) {
-        auto objContainer = std::dynamic_pointer_cast<Container>(objectsList[i]);
-        auto objButton = std::dynamic_pointer_cast<Button>(objContainer->getComponents()[0]);
-        if (currentSelectedObject) {
-            if (objects[i + 1] && objects.size() > 1) {
-                if (objects[i + 1]->isHovered) {
-                    objButton->setColor(sf::Color(255, 255, 150));
-                }
-                if (objects[i + 1]->isSelected) {
-                    objButton->setColor(sf::Color(255, 255, 100));
-                }
-                if (!objects[i + 1]->isHovered && !objects[i + 1]->isSelected) {
-                    objButton->setColor(sf::Color::White);
-                }
-            }
-        }
+}
+
+void ObjectsMenu::updateRowColors() {
+    if (!currentSelectedObject || !objectsScroll) {
+        return;
     }
-    updateObjectsPropertiesMenu();
+    const auto& objects = Scene::getInstance(WindowManager::getInstance().getWindow()).getObjects();
+    objectsScroll->forEachVisibleRow([&objects](size_t index, Component& row) {
+        if (index + 1 >= objects.size()) {
+            return;
+        }
+        const auto& object = objects[index + 1];
+        sf::Color color = sf::Color::White;
+        if (object->isSelected) {
+            color = sf::Color(255, 255, 100);
+        } else if (object->isHovered) {
+            color = sf::Color(255, 255, 150);
+        }
+        static_cast<ItemRow&>(row).getItemButton().setColor(color);
+    });
 }
 
 void ObjectsMenu::addObjectPropertiesMenu(std::shared_ptr<Object3d> object) {
@@ -190,17 +202,17 @@ void ObjectsMenu::addObjectPropertiesMenu(std::shared_ptr<Object3d> object) {
 
 void ObjectsMenu::createObjectsPropertiesMenu() {
     int marginTop = 400;
-    auto languagePack = LanguageManager::getInstance().getSelectedPack();
+    const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
     title = std::make_shared<Text>(
         sf::Vector2f(parentPosition.x + 20, marginTop + 10),
         20,
-        languagePack["Properties"]
+        languagePack[TextKey::Properties]
     );
     title->setBold();
     scale = std::make_shared<Text>(
         sf::Vector2f(parentPosition.x + 20, marginTop + 50),
         20,
-        languagePack["Scale"]
+        languagePack[TextKey::Scale]
     );
     scaleX = std::make_shared<NumberInput>(
         sf::Vector2f(parentPosition.x + 20, marginTop + 80),
@@ -213,10 +225,8 @@ void ObjectsMenu::createObjectsPropertiesMenu() {
         if (scene.selectedObjects.size() == 1) {
             currentSelectedObject->setScale(Vector3(value - scene.getObjects()[scene.getSelectedObjectIndex()]->getScale().x, 0.0f, 0.0f));
         } else {
-            for (int i = 0; i < scene.selectedObjects.size(); ++i) {
-                scene.getObjects()[scene.selectedObjects[i]]->setScale(Vector3(value, 0.0f, 0.0f));
-                scaleX->setValue(0);
-            }
+            scene.scaleSelected(Vector3(value, 0.0f, 0.0f));
+            scaleX->setValue(0);
         }
     }));
     scaleY = std::make_shared<NumberInput>(
@@ -230,10 +240,8 @@ void ObjectsMenu::createObjectsPropertiesMenu() {
         if (scene.selectedObjects.size() == 1) {
             currentSelectedObject->setScale(Vector3(0.0f, value - scene.getObjects()[scene.getSelectedObjectIndex()]->getScale().y, 0.0f));
         } else {
-            for (int i = 0; i < scene.selectedObjects.size(); ++i) {
-                scene.getObjects()[scene.selectedObjects[i]]->setScale(Vector3(0.0f, value, 0.0f));
-                scaleY->setValue(0);
-            }
+            scene.scaleSelected(Vector3(0.0f, value, 0.0f));
+            scaleY->setValue(0);
         }
     }));
     scaleZ = std::make_shared<NumberInput>(
@@ -247,16 +255,14 @@ void ObjectsMenu::createObjectsPropertiesMenu() {
         if (scene.selectedObjects.size() == 1) {
             currentSelectedObject->setScale(Vector3(0.0f, 0.0f, value - scene.getObjects()[scene.getSelectedObjectIndex()]->getScale().z));
         } else {
-            for (int i = 0; i < scene.selectedObjects.size(); ++i) {
-                scene.getObjects()[scene.selectedObjects[i]]->setScale(Vector3(0.0f, 0.0f, value));
-                scaleZ->setValue(0);
-            }
+            scene.scaleSelected(Vector3(0.0f, 0.0f, value));
+            scaleZ->setValue(0);
         }
     }));
     position = std::make_shared<Text>(
         sf::Vector2f(parentPosition.x + 20, marginTop + 150),
         20,
-        languagePack["Position"]
+        languagePack[TextKey::Position]
     );
     positionX = std::make_shared<NumberInput>(
         sf::Vector2f(parentPosition.x + 20, marginTop + 180),
@@ -269,10 +275,8 @@ void ObjectsMenu::createObjectsPropertiesMenu() {
         if (scene.selectedObjects.size() == 1) {
             currentSelectedObject->translate(Vector3(value - scene.getObjects()[scene.getSelectedObjectIndex()]->getPosition().x, 0.0f, 0.0f));
         } else {
-            for (int i = 0; i < scene.selectedObjects.size(); ++i) {
-                scene.getObjects()[scene.selectedObjects[i]]->translate(Vector3(value, 0.0f, 0.0f));
-                positionX->setValue(0);
-            }
+            scene.translateSelected(Vector3(value, 0.0f, 0.0f));
+            positionX->setValue(0);
         }
     }));
     positionY = std::make_shared<NumberInput>(
@@ -286,10 +290,8 @@ void ObjectsMenu::createObjectsPropertiesMenu() {
         if (scene.selectedObjects.size() == 1) {
             currentSelectedObject->translate(Vector3(0.0f, value - scene.getObjects()[scene.getSelectedObjectIndex()]->getPosition().y, 0.0f));
         } else {
-            for (int i = 0; i < scene.selectedObjects.size(); ++i) {
-                scene.getObjects()[scene.selectedObjects[i]]->translate(Vector3(0.0f, value, 0.0f));
-                positionY->setValue(0);
-            }
+            scene.translateSelected(Vector3(0.0f, value, 0.0f));
+            positionY->setValue(0);
         }
     }));
     positionZ = std::make_shared<NumberInput>(
@@ -303,16 +305,14 @@ void ObjectsMenu::createObjectsPropertiesMenu() {
         if (scene.selectedObjects.size() == 1) {
             currentSelectedObject->translate(Vector3(0.0f, 0.0f, value - scene.getObjects()[scene.getSelectedObjectIndex()]->getPosition().z));
         } else {
-            for (int i = 0; i < scene.selectedObjects.size(); ++i) {
-                scene.getObjects()[scene.selectedObjects[i]]->translate(Vector3(0.0f, 0.0f, value));
-                positionZ->setValue(0);
-            }
+            scene.translateSelected(Vector3(0.0f, 0.0f, value));
+            positionZ->setValue(0);
         }
     }));
     rotation = std::make_shared<Text>(
         sf::Vector2f(parentPosition.x + 20, marginTop + 250),
         20,
-        languagePack["Rotation"]
+        languagePack[TextKey::Rotation]
     );
     rotationX = std::make_shared<NumberInput>(
         sf::Vector2f(parentPosition.x + 20, marginTop + 280),
@@ -327,10 +327,8 @@ void ObjectsMenu::createObjectsPropertiesMenu() {
             Vector3 currentRotation = scene.getObjects()[scene.getSelectedObjectIndex()]->getRotation();
             currentSelectedObject->setRotation(Vector3(value, currentRotation.y, currentRotation.z));
         } else {
-            for (int i = 0; i < scene.selectedObjects.size(); ++i) {
-                scene.getObjects()[scene.selectedObjects[i]]->rotate(value, 'x');
-                rotationX->setValue(0);
-            }
+            scene.rotateSelected(value, 'x');
+            rotationX->setValue(0);
         }
     }));
     rotationY = std::make_shared<NumberInput>(
@@ -346,10 +344,8 @@ void ObjectsMenu::createObjectsPropertiesMenu() {
             Vector3 currentRotation = scene.getObjects()[scene.getSelectedObjectIndex()]->getRotation();
             currentSelectedObject->setRotation(Vector3(currentRotation.x, value, currentRotation.z));
         } else {
-            for (int i = 0; i < scene.selectedObjects.size(); ++i) {
-                scene.getObjects()[scene.selectedObjects[i]]->rotate(value, 'y');
-                rotationY->setValue(0);
-            }
+            scene.rotateSelected(value, 'y');
+            rotationY->setValue(0);
         }
     }));
     rotationZ = std::make_shared<NumberInput>(
@@ -365,18 +361,15 @@ void ObjectsMenu::createObjectsPropertiesMenu() {
             Vector3 currentRotation = scene.getObjects()[scene.getSelectedObjectIndex()]->getRotation();
             currentSelectedObject->setRotation(Vector3(currentRotation.x, currentRotation.y, value));
         } else {
-
-            for (int i = 0; i < scene.selectedObjects.size(); ++i) {
-                scene.getObjects()[scene.selectedObjects[i]]->rotate(value, 'z');
-                rotationZ->setValue(0);
-            }
+            scene.rotateSelected(value, 'z');
+            rotationZ->setValue(0);
         }
     }));
     color = std::make_shared<Input>(
        sf::Vector2f(parentPosition.x + 20, marginTop + 360),
        sf::Vector2f(200, 50),
-       languagePack["Color"],
-       languagePack["Color"]
+       languagePack[TextKey::Color],
+       languagePack[TextKey::Color]
     );
     color->setOnClick([](std::string value) {
         sf::RenderWindow &window = WindowManager::getInstance().getWindow();
@@ -392,18 +385,40 @@ void ObjectsMenu::createObjectsPropertiesMenu() {
     });
     combineButton = std::make_shared<Button>(
         sf::Vector2f(parentPosition.x + 20, marginTop + 430),
-        sf::Vector2f(200, 50),
-        "Combine"
+        sf::Vector2f(100, 50),
+        languagePack[TextKey::Union]
     );
     combineButton->setOnClick([this]() {
         pendingOperations.push([this]() {
             sf::RenderWindow &window = WindowManager::getInstance().getWindow();
             Scene &scene = Scene::getInstance(window);
-            scene.createCombination();
-            createUI();
+            scene.createCombination(BooleanOperation::Union);
+        });
+    });
+    differenceButton = std::make_shared<Button>(
+        sf::Vector2f(parentPosition.x + 125, marginTop + 430),
+        sf::Vector2f(100, 50),
+        languagePack[TextKey::Difference]
+    );
+    differenceButton->setOnClick([this]() {
+        pendingOperations.push([this]() {
+            sf::RenderWindow &window = WindowManager::getInstance().getWindow();
+            Scene &scene = Scene::getInstance(window);
+            scene.createCombination(BooleanOperation::Difference);
+        });
+    });
+    intersectionButton = std::make_shared<Button>(
+        sf::Vector2f(parentPosition.x + 230, marginTop + 430),
+        sf::Vector2f(100, 50),
+        languagePack[TextKey::Intersection]
+    );
+    intersectionButton->setOnClick([this]() {
+        pendingOperations.push([this]() {
+            sf::RenderWindow &window = WindowManager::getInstance().getWindow();
+            Scene &scene = Scene::getInstance(window);
+            scene.createCombination(BooleanOperation::Intersection);
         });
     });
-    combineButton->setIcon("combine");
 }
 
 
@@ -501,5 +516,7 @@ void ObjectsMenu::updateObjectsPropertiesMenu() {
     objectPropertiesMenu.push_back(color);
     if (scene.selectedObjects.size() > 1) {
         objectPropertiesMenu.push_back(combineButton);
+        objectPropertiesMenu.push_back(differenceButton);
+        objectPropertiesMenu.push_back(intersectionButton);
     }
 }
@@ -13,6 +13,7 @@
 #include "../../core/ui/Input.hpp"
 #include "../../core/ui/NumberInput.hpp"
 #include "../../core/ui/ScrollView.hpp"
+#include "../../core/feature/Scene.hpp"
 
 class ObjectsMenu: public Menu {
 public:
@@ -34,11 +35,15 @@ private:
     unsigned int selectedObjectIndex;
     std::shared_ptr<Object3d> currentSelectedObject;
     std::queue<std::function<void()>> pendingOperations;
+    int sceneListener = 0;
 
     void addObjectPropertiesMenu(std::shared_ptr<Object3d> object);
     void updateObjectsPropertiesMenu();
     void createObjectsPropertiesMenu();
-    void updateObjectsButtons();
+    void onSceneChanged(const SceneChange& change);
+    void syncSelectedObject();
+    std::shared_ptr<Component> createRow(size_t index, std::shared_ptr<Component> recycled);
+    void updateRowColors();
 
     std::shared_ptr<Text> title;
     std::shared_ptr<Text> scale;
@@ -55,6 +60,8 @@ private:
     std::shared_ptr<NumberInput> rotationZ;
     std::shared_ptr<Input> color;
     std::shared_ptr<Button> combineButton;
+    std::shared_ptr<Button> differenceButton;
+    std::shared_ptr<Button> intersectionButton;
 };
 
 #endif
\ No newline at end of file
@@ -11,20 +11,20 @@ ProjectSettings::ProjectSettings() {
 }
 
 void ProjectSettings::createUI() {
-    auto languagePack = LanguageManager::getInstance().getSelectedPack();
+    const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
 
     components.clear();
 
     auto title = std::make_shared<Text>(
         sf::Vector2f(parentPosition.x + 20, 20),
         30,
-        languagePack["project_settings"]
+        languagePack[TextKey::ProjectSettings]
     );
 
     auto saveButton = std::make_shared<Button>(
         sf::Vector2f(parentPosition.x + 20, 90),
         sf::Vector2f(310, 50),
-        languagePack["save"]
+        languagePack[TextKey::Save]
     );
 
     saveButton->setIcon("save");
@@ -39,7 +39,7 @@ void ProjectSettings::createUI() {
     auto exportButton = std::make_shared<Button>(
          sf::Vector2f(parentPosition.x + 20, 160),
          sf::Vector2f(310, 50),
-         languagePack["export"]
+         languagePack[TextKey::Export]
     );
 
     exportButton->setIcon("export");
@@ -47,16 +47,64 @@ void ProjectSettings::createUI() {
     exportButton->setOnClick([]() {;
         ProjectsManager& projectsManager = ProjectsManager::getInstance();
         if (projectsManager.exportAsObj()) {
-            auto languagePack = LanguageManager::getInstance().getSelectedPack();
-            Snackbar::getInstance().addMessage(languagePack["project_exported"]);
+            const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+            Snackbar::getInstance().addMessage(languagePack[TextKey::ProjectExported]);
         }
 
     });
 
+    auto exportJsonButton = std::make_shared<Button>(
+         sf::Vector2f(parentPosition.x + 20, 230),
+         sf::Vector2f(310, 50),
+         languagePack[TextKey::ExportAsJson]
+    );
+
+    exportJsonButton->setIcon("export");
+
+    exportJsonButton->setOnClick([]() {
+        ProjectsManager& projectsManager = ProjectsManager::getInstance();
+        if (projectsManager.exportAsJson()) {
+            const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+            Snackbar::getInstance().addMessage(languagePack[TextKey::ProjectExported]);
+        }
+    });
+
+    auto exportStlButton = std::make_shared<Button>(
+         sf::Vector2f(parentPosition.x + 20, 300),
+         sf::Vector2f(310, 50),
+         languagePack[TextKey::ExportAsStl]
+    );
+
+    exportStlButton->setIcon("export");
+
+    exportStlButton->setOnClick([]() {
+        ProjectsManager& projectsManager = ProjectsManager::getInstance();
+        if (projectsManager.exportAsStl()) {
+            const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+            Snackbar::getInstance().addMessage(languagePack[TextKey::ProjectExported]);
+        }
+    });
+
+    auto exportGlbButton = std::make_shared<Button>(
+         sf::Vector2f(parentPosition.x + 20, 370),
+         sf::Vector2f(310, 50),
+         languagePack[TextKey::ExportAsGlb]
+    );
+
+    exportGlbButton->setIcon("export");
+
+    exportGlbButton->setOnClick([]() {
+        ProjectsManager& projectsManager = ProjectsManager::getInstance();
+        if (projectsManager.exportAsGlb()) {
+            const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+            Snackbar::getInstance().addMessage(languagePack[TextKey::ProjectExported]);
+        }
+    });
+
     auto deleteButton = std::make_shared<Button>(
-         sf::Vector2f(parentPosition.x + 20, 270),
+         sf::Vector2f(parentPosition.x + 20, 480),
          sf::Vector2f(310, 50),
-         languagePack["delete"]
+         languagePack[TextKey::Delete]
     );
 
     deleteButton->setIcon("delete");
@@ -73,6 +121,9 @@ void ProjectSettings::createUI() {
     this->addComponent(title);
     this->addComponent(saveButton);
     this->addComponent(exportButton);
+    this->addComponent(exportJsonButton);
+    this->addComponent(exportStlButton);
+    this->addComponent(exportGlbButton);
     this->addComponent(deleteButton);
 }
 
@@ -1,121 +1,151 @@
 #include "VerticesMenu.hpp"
 #include "../../core/feature/Scene.hpp"
-#include "../../core/ui/Container.hpp"
 #include "../../utils/WindowManager.hpp"
 #include "../../core/ui/NumberInput.hpp"
 #include "../../core/ui/Input.hpp"
 #include "../../core/ui/ScrollView.hpp"
 #include "../../core/ui/Expandable.hpp"
+#include "../../core/ui/ItemRow.hpp"
 #include "../../core/ui/Snackbar.hpp"
 #include "../../utils/LanguageManager.hpp"
 
 VerticesMenu::VerticesMenu() : currentSelectedObject(nullptr) {}
 
 void VerticesMenu::createUI() {
-    auto languagePack = LanguageManager::getInstance().getSelectedPack();
+    const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
     objectList.clear();
     components.clear();
     auto title = std::make_shared<Text>(
         sf::Vector2f(parentPosition.x + 20, 20),
         20,
-        languagePack["vertices"]
+        languagePack[TextKey::Vertices]
     );
     objectList.push_back(title);
 
     sf::RenderWindow& window = WindowManager::getInstance().getWindow();
     Scene& scene = Scene::getInstance(window);
-    std::vector<std::shared_ptr<Object3d>> objects = scene.getObjects();
+    sceneObjects = scene.getObjects();
+    syncSelectedObject();
+    updateExpandedObject();
 
     auto scrollView = std::make_shared<ScrollView>(
         sf::Vector2f(parentPosition.x + 20, 60),
         sf::Vector2f(310, 300),
         300.f
     );
+    scrollView->setVirtualRows(getRowCount(), 30.f, [this](size_t index, std::shared_ptr<Component> recycled) {
+        return createRow(index, std::move(recycled));
+    });
 
-    for (int i = 1; i < objects.size(); ++i) {
-        auto objButton = std::make_shared<Expandable>(
-            sf::Vector2f(parentPosition.x + 20, 60 + 30 * (i - 1)),
-            sf::Vector2f(290, 30),
-            languagePack["Object"].get<std::string>() + " " + std::to_string(i)
-        );
-        objButton->setOnClick([this, i, &scene]() {
-            scene.onChangeSelectedObjectIndex(i);
-            currentSelectedObject = scene.getObjects()[i];
-        });
-        objButton->setExpanded(objects[i] == currentSelectedObject);
+    objectsScroll = scrollView;
+    objectList.push_back(scrollView);
+}
 
-        int j = 0;
-        for (auto vertex : objects[i]->getVertices()) {
-            auto vertexContainer = std::make_shared<Container>(
-                sf::Vector2f(parentPosition.x + 40, 60 + 30 * (j + i)),
-                sf::Vector2f(250, 30)
-            );
-            auto vertexButton = std::make_shared<Button>(
-                sf::Vector2f(parentPosition.x + 40, 60 + 30 * (j + i)),
-                sf::Vector2f(240, 30),
-                 languagePack["Vertex"].get<std::string>() + " " + std::to_string(j + 1)
-            );
-            if (objects[i]->isVertexSelected(i)) {
-                vertexButton->setColor(sf::Color(255, 255, 100));
-            }
+void VerticesMenu::updateExpandedObject() {
+    expandedObject = 0;
+    expandedVertexCount = 0;
+    for (size_t i = 1; i < sceneObjects.size(); ++i) {
+        if (sceneObjects[i] == currentSelectedObject) {
+            expandedObject = i;
+            expandedVertexCount = sceneObjects[i]->getVertices().size();
+        }
+    }
+}
+
+size_t VerticesMenu::getRowCount() const {
+    return sceneObjects.empty() ? 0 : sceneObjects.size() - 1 + expandedVertexCount;
+}
+
+bool VerticesMenu::isVertexRow(size_t index) const {
+    return expandedObject > 0 && index >= expandedObject && index < expandedObject + expandedVertexCount;
+}
+
+sf::Color VerticesMenu::getVertexRowColor(int vertexIndex) const {
+    const auto& object = sceneObjects[expandedObject];
+    if (object->isVertexSelected(vertexIndex)) {
+        return sf::Color(255, 255, 100);
+    }
+    if (object->isVertexHovered(vertexIndex)) {
+        return sf::Color(255, 255, 150);
+    }
+    return sf::Color::White;
+}
 
-            vertexButton->setOnClick([this, j]() {
-                auto& selectedVertices = currentSelectedObject->selectedVertices;
-                auto it = std::find(selectedVertices.begin(), selectedVertices.end(), j);
-                if (it != selectedVertices.end()) {
-                    selectedVertices.erase(it);
-                } else {
-                    selectedVertices.push_back(j);
-                }
-                updateVertexPropertiesMenu();
-            });
-            vertexButton->setOnHover([this, j]() {
-                auto& hoveredVertices = currentSelectedObject->hoveredVertices;
-                auto it = std::find(hoveredVertices.begin(), hoveredVertices.end(), j);
-                if (it == hoveredVertices.end()) {
-                    hoveredVertices.push_back(j);
-                }
-            });
-            vertexButton->setOnHoverOut([this, j]() {
-                auto& hoveredVertices = currentSelectedObject->hoveredVertices;
-                auto it = std::find(hoveredVertices.begin(), hoveredVertices.end(), j);
-                if (it != hoveredVertices.end()) {
-                    hoveredVertices.erase(it);
-                }
-            });
-            auto deleteVertexButton = std::make_shared<Button>(
-                sf::Vector2f(parentPosition.x + 280, 60 + 30 * (j + i)),
-                sf::Vector2f(30, 30),
+std::shared_ptr<Component> VerticesMenu::createRow(size_t index, std::shared_ptr<Component> recycled) {
+    const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+
+    if (!isVertexRow(index)) {
+        int i = static_cast<int>(expandedObject > 0 && index >= expandedObject ? index - expandedVertexCount + 1 : index + 1);
+        auto objButton = std::dynamic_pointer_cast<Expandable>(recycled);
+        if (!objButton) {
+            objButton = std::make_shared<Expandable>(
+                sf::Vector2f(parentPosition.x + 20, 60),
+                sf::Vector2f(290, 30),
                 ""
             );
-            deleteVertexButton->setIcon("delete");
-            deleteVertexButton->setOnClick([this, j]() {
-                pendingOperations.push([this, j]() {
-                    currentSelectedObject->deleteVertex(j);
-                    createUI();
-                    auto languagePack = LanguageManager::getInstance().getSelectedPack();
-                    Snackbar::getInstance().addMessage(languagePack["vertex_deleted"]);
-                });
-            });
-            vertexContainer->addComponent(vertexButton);
-            vertexContainer->addComponent(deleteVertexButton);
-            objButton->addContent(vertexContainer);
-            j++;
         }
+        objButton->setHeaderText(languagePack[TextKey::Object] + " " + std::to_string(i));
+        if (currentSelectedObject) {
+            objButton->setTextColor(sceneObjects[i] == currentSelectedObject ? sf::Color::Yellow : sf::Color::Black);
+        } else {
+            objButton->setTextColor(sf::Color::White);
+        }
+        objButton->setOnClick([this, i]() {
+            Scene& scene = Scene::getInstance(WindowManager::getInstance().getWindow());
+            scene.onChangeSelectedObjectIndex(i);
+            currentSelectedObject = scene.getObjects()[i];
+        });
+        return objButton;
+    }
 
-        scrollView->addComponent(objButton);
+    int j = static_cast<int>(index - expandedObject);
+    auto vertexRow = std::dynamic_pointer_cast<ItemRow>(recycled);
+    if (!vertexRow) {
+        vertexRow = std::make_shared<ItemRow>(
+            sf::Vector2f(parentPosition.x + 40, 60),
+            sf::Vector2f(270, 30)
+        );
     }
-    objectsScroll = scrollView;
-    objectList.push_back(scrollView);
 
-    int selectedIndex = scene.getSelectedObjectIndex();
-    if (selectedIndex > 1 && selectedIndex < objects.size()) {
-        currentSelectedObject = objects[selectedIndex];
+    Button& vertexButton = vertexRow->getItemButton();
+    vertexButton.setText(languagePack[TextKey::Vertex] + " " + std::to_string(j + 1));
+    vertexButton.setColor(getVertexRowColor(j));
 
-    }
+    vertexButton.setOnClick([this, j]() {
+        auto& selectedVertices = currentSelectedObject->selectedVertices;
+        auto it = std::find(selectedVertices.begin(), selectedVertices.end(), j);
+        if (it != selectedVertices.end()) {
+            selectedVertices.erase(it);
+        } else {
+            selectedVertices.push_back(j);
+        }
+        updateVertexPropertiesMenu();
+    });
+    vertexButton.setOnHover([this, j]() {
+        auto& hoveredVertices = currentSelectedObject->hoveredVertices;
+        auto it = std::find(hoveredVertices.begin(), hoveredVertices.end(), j);
+        if (it == hoveredVertices.end()) {
+            hoveredVertices.push_back(j);
+        }
+    });
+    vertexButton.setOnHoverOut([this, j]() {
+        auto& hoveredVertices = currentSelectedObject->hoveredVertices;
+        auto it = std::find(hoveredVertices.begin(), hoveredVertices.end(), j);
+        if (it != hoveredVertices.end()) {
+            hoveredVertices.erase(it);
+        }
+    });
+    vertexRow->getActionButton(0).setOnClick([this, j]() {
+        pendingOperations.push([this, j]() {
+            currentSelectedObject->deleteVertex(j);
+            Scene::getInstance(WindowManager::getInstance().getWindow()).notifyTopologyChanged(static_cast<int>(expandedObject));
+            const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+            Snackbar::getInstance().addMessage(languagePack[TextKey::VertexDeleted]);
+        });
+    });
+    return vertexRow;
 }
 
-
 void VerticesMenu::draw(sf::RenderWindow &window) {
     if (objectList.empty()) {
         createUI();
@@ -138,7 +168,8 @@ void VerticesMenu::handleEvent(const sf::Event& event, const sf::RenderWindow& w
     if (objectList.empty()) {
         createUI();
     }
-    updateVerticesButtons();
+    updateRowColors();
+    updateVertexPropertiesMenu();
     for (const auto& component : objectList) {
         component->handleEvent(event, window);
     }
@@ -157,6 +188,9 @@ void VerticesMenu::onActivate() {
     sf::RenderWindow& window = WindowManager::getInstance().getWindow();
     Scene& scene = Scene::getInstance(window);
     scene.setVerticesEditMode(true);
+    if (!sceneListener) {
+        sceneListener = scene.addListener([this](const SceneChange& change) { onSceneChanged(change); });
+    }
 }
 
 void VerticesMenu::onDeactivate() {
@@ -164,80 +198,77 @@ void VerticesMenu::onDeactivate() {
     sf::RenderWindow& window = WindowManager::getInstance().getWindow();
     Scene& scene = Scene::getInstance(window);
     scene.setVerticesEditMode(false);
+    scene.removeListener(sceneListener);
+    sceneListener = 0;
 }
 
-void VerticesMenu::updateVerticesButtons() {
-    sf::RenderWindow& window = WindowManager::getInstance().getWindow();
-    Scene& scene = Scene::getInstance(window);
-    std::vector<std::shared_ptr<Object3d>> objects = scene.getObjects();
-    int selectedIndex = scene.getSelectedObjectIndex();
-    if (selectedIndex > 0 && selectedIndex < objects.size()) {
-        if (currentSelectedObject && objects[selectedIndex] != currentSelectedObject) {
-            currentSelectedObject->selectedVertices.clear();
-        }
-        currentSelectedObject = objects[selectedIndex];
+void VerticesMenu::onSceneChanged(const SceneChange& change) {
+    if (!objectsScroll) {
+        return;
     }
-    auto objectsList = objectsScroll->getComponents();
-    for (int i = 0; i < objectsList.size(); ++i) {
-        auto objButton = std::dynamic_pointer_cast<Expandable>(objectsList[i]);
-        if (currentSelectedObject) {
-            if (objects[i + 1] == currentSelectedObject) {
-                objButton->setTextColor(sf::Color::Yellow);
-            }
-            else {
-                objButton->setTextColor(sf::Color::Black);
-            }
-            objButton->setExpanded(objects[i + 1] == currentSelectedObject);
-        }
-        if (objButton) {
-            auto content= objButton->getContent();
-            int j = 0;
-            for (const auto& vertexComponent: content) {
-                auto vertexContainer = std::dynamic_pointer_cast<Container>(vertexComponent);
-                auto vertexButton = std::dynamic_pointer_cast<Button>(vertexContainer->getComponents()[0]);
-                if (vertexButton) {
-                    if (objects[i + 1]->isVertexHovered(j)) {
-                        vertexButton->setColor(sf::Color(255, 255, 150));
-                    }
-                    if (objects[i + 1]->isVertexSelected(j)) {
-                        vertexButton->setColor(sf::Color(255, 255, 100));
-                    }
-                    if (!objects[i + 1]->isVertexHovered(j) && !objects[i + 1]->isVertexSelected(j)) {
-                        vertexButton->setColor(sf::Color::White);
-                    }
-                }
-                j++;
+    switch (change.type) {
+        case SceneChange::Type::TopologyChanged:
+            if (change.objectIndex != static_cast<int>(expandedObject)) {
+                return;
             }
+            break;
+        case SceneChange::Type::SelectionChanged:
+            syncSelectedObject();
+            break;
+        default:
+            sceneObjects = Scene::getInstance(WindowManager::getInstance().getWindow()).getObjects();
+            break;
+    }
+    // Only marks the rows for rebinding; the visible ones are rebound when next drawn
+    updateExpandedObject();
+    objectsScroll->setRowCount(getRowCount());
+}
+
+void VerticesMenu::syncSelectedObject() {
+    int selectedIndex = Scene::getInstance(WindowManager::getInstance().getWindow()).getSelectedObjectIndex();
+    if (selectedIndex > 0 && selectedIndex < sceneObjects.size()) {
+        if (currentSelectedObject && sceneObjects[selectedIndex] != currentSelectedObject) {
+            currentSelectedObject->selectedVertices.clear();
         }
+        currentSelectedObject = sceneObjects[selectedIndex];
     }
-    updateVertexPropertiesMenu();
+}
+
+void VerticesMenu::updateRowColors() {
+    // Hover and selection of vertices change on every mouse move, so only the rows on screen are restyled
+    objectsScroll->forEachVisibleRow([this](size_t index, Component& row) {
+        if (isVertexRow(index)) {
+            int j = static_cast<int>(index - expandedObject);
+            static_cast<ItemRow&>(row).getItemButton().setColor(getVertexRowColor(j));
+        }
+    });
 }
 
 void VerticesMenu::createVertexPropertiesMenu() {
-    auto languagePack = LanguageManager::getInstance().getSelectedPack();
+    const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
     addVertexButton = std::make_shared<Button>(
     sf::Vector2f(parentPosition.x + 190,  20),
            sf::Vector2f(120, 30),
-        languagePack["add_vertex"]
+        languagePack[TextKey::AddVertex]
        );
     addVertexButton->setIcon("vertex");
     addVertexButton->setPosition({parentPosition.x + 330 - addVertexButton->getWidth(), addVertexButton->getPosition().y});
     addVertexButton->setOnClick([this]() {
         currentSelectedObject->addVertex();
-        createUI();
-        auto languagePack = LanguageManager::getInstance().getSelectedPack();
-        Snackbar::getInstance().addMessage(languagePack["vertex_added"]);
+        Scene::getInstance(WindowManager::getInstance().getWindow()).notifyTopologyChanged(static_cast<int>(expandedObject));
+        const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+        Snackbar::getInstance().addMessage(languagePack[TextKey::VertexAdded]);
     });
     title = std::make_shared<Text>(
         sf::Vector2f(parentPosition.x + 20,  410),
         20,
-        languagePack["Vertex Properties"]
+        languagePack[TextKey::VertexProperties]
     );
     title->setBold();
     position = std::make_shared<Text>(
         sf::Vector2f(parentPosition.x + 20, 450),
         20,
-        languagePack["Position"]
+        languagePack[TextKey::Position]
     );
     positionX = std::make_shared<NumberInput>(
         sf::Vector2f(parentPosition.x + 20, 480),
@@ -320,7 +351,7 @@ void VerticesMenu::createVertexPropertiesMenu() {
     createEdgeButton = std::make_shared<Button>(
         sf::Vector2f(parentPosition.x + 20, 550),
                 sf::Vector2f(200, 50),
-                languagePack["Create Edge"]
+                languagePack[TextKey::CreateEdge]
             );
     createEdgeButton->setIcon("edge");
     createEdgeButton->setOnClick([this]() {
@@ -329,18 +360,44 @@ void VerticesMenu::createVertexPropertiesMenu() {
     createFaceButton = std::make_shared<Button>(
         sf::Vector2f(parentPosition.x + 20, 550),
                 sf::Vector2f(200, 50),
-                languagePack["Create Face"]
+                languagePack[TextKey::CreateFace]
             );
     createFaceButton->setIcon("face");
     createFaceButton->setOnClick([this]() {
         currentSelectedObject->createFace();
     });
+    mergeDistance = std::make_shared<NumberInput>(
+        sf::Vector2f(parentPosition.x + 20, 620),
+        sf::Vector2f(90, 50),
+        "",
+        0.001f,
+        sf::Color::White,
+        sf::Color::Black,
+        "0.001",
+        0.0f
+    );
+    mergeDistance->setValue(0.001f);
+    mergeByDistanceButton = std::make_shared<Button>(
+        sf::Vector2f(parentPosition.x + 130, 620),
+        sf::Vector2f(200, 50),
+        languagePack[TextKey::MergeByDistance]
+    );
+    mergeByDistanceButton->setOnClick([this]() {
+        pendingOperations.push([this]() {
+            int merged = currentSelectedObject->mergeVerticesByDistance(mergeDistance->getValue());
+            Scene::getInstance(WindowManager::getInstance().getWindow()).notifyTopologyChanged(static_cast<int>(expandedObject));
+            const LanguagePack& languagePack = LanguageManager::getInstance().getSelectedPack();
+            Snackbar::getInstance().addMessage(languagePack[TextKey::VerticesMerged] + ": " + std::to_string(merged));
+        });
+    });
 }
 
 void VerticesMenu::updateVertexPropertiesMenu() {
     vertexPropertiesMenu.clear();
     if (currentSelectedObject) {
         vertexPropertiesMenu.push_back(addVertexButton);
+        vertexPropertiesMenu.push_back(mergeDistance);
+        vertexPropertiesMenu.push_back(mergeByDistanceButton);
     }
     else return;
     if (currentSelectedObject->selectedVertices.empty()) return;
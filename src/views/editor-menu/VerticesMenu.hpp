@@ -12,6 +12,7 @@
 #include "../../core/objects/Object3d.hpp"
 #include "../../core/ui/NumberInput.hpp"
 #include "../../core/ui/ScrollView.hpp"
+#include "../../core/feature/Scene.hpp"
 
 class VerticesMenu: public Menu {
 public:
@@ -32,10 +33,25 @@ private:
     std::shared_ptr<Object3d> currentSelectedObject;
     std::queue<std::function<void()>> pendingOperations;
 
+    // The list shows a header per object, with the vertices of the selected object under its header
+    std::vector<std::shared_ptr<Object3d>> sceneObjects;
+    size_t expandedObject = 0;
+    size_t expandedVertexCount = 0;
+
+    int sceneListener = 0;
+
+    void onSceneChanged(const SceneChange& change);
+    void syncSelectedObject();
+    void updateExpandedObject();
+    size_t getRowCount() const;
+    bool isVertexRow(size_t index) const;
+    sf::Color getVertexRowColor(int vertexIndex) const;
+    std::shared_ptr<Component> createRow(size_t index, std::shared_ptr<Component> recycled);
+    void updateRowColors();
+
     void addObjectPropertiesMenu(std::shared_ptr<Object3d> object);
     void createVertexPropertiesMenu();
     void updateVertexPropertiesMenu();
-    void updateVerticesButtons();
 
     std::shared_ptr<Text> title;
     std::shared_ptr<Text> position;
@@ -45,6 +61,8 @@ private:
     std::shared_ptr<NumberInput> positionZ;
     std::shared_ptr<Button> createEdgeButton;
     std::shared_ptr<Button> createFaceButton;
+    std::shared_ptr<NumberInput> mergeDistance;
+    std::shared_ptr<Button> mergeByDistanceButton;
 };
 
 #endif
\ No newline at end of file